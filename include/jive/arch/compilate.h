@@ -134,7 +134,7 @@ public:
 
 
 	inline const uint8_t *
-	data()
+	data() const noexcept
 	{
 		return data_.data();
 	}
@@ -161,9 +161,7 @@ public:
 	clear()
 	{
 		data_.clear();
-		for (const auto & relocation : relocations)
-			delete relocation;
-		relocations.clear();
+		relocations_.clear();
 	}
 
 	void
@@ -174,11 +172,22 @@ public:
 		jive_symref target,
 		jive_offset value);
 
-	std::unordered_set<relocation_entry*> relocations;
+	/**
+		\brief Relocation records of the section
+
+		Records are appended at the current end of the section data,
+		hence the table is always sorted by offset.
+	*/
+	inline const std::vector<relocation_entry> &
+	relocations() const noexcept
+	{
+		return relocations_;
+	}
 
 private:
 	jive::buffer data_;
 	jive_stdsectionid id_;
+	std::vector<relocation_entry> relocations_;
 };
 
 /* compilate */
@@ -216,6 +225,12 @@ public:
 	jive::section *
 	section(jive_stdsectionid sectionid);
 
+	inline const std::vector<std::unique_ptr<jive::section>> &
+	sections() const noexcept
+	{
+		return sections_;
+	}
+
 	/**
 		\brief Load a compilate into process' address space
 
@@ -276,17 +291,21 @@ public:
 	operator=(compilate_map &&) = delete;
 
 	inline void *
-	section(jive_stdsectionid id)
+	section(jive_stdsectionid id) const noexcept
 	{
-		for (const auto & cs : sections) {
-			if (cs.section->id() == id)
-				return cs.base;
-		}
+		if (id < 0 || size_t(id) >= bases_.size())
+			return nullptr;
 
-		return nullptr;
+		return bases_[id];
 	}
 
 	std::vector<jive_compilate_section> sections;
+
+private:
+	friend compilate;
+
+	/** \brief Base addresses of the loaded sections, indexed by section id */
+	std::vector<void*> bases_;
 };
 
 }
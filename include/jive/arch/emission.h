@@ -0,0 +1,122 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JIVE_ARCH_EMISSION_H
+#define JIVE_ARCH_EMISSION_H
+
+#include <jive/arch/compilate.h>
+#include <jive/arch/instruction-class.h>
+
+#include <limits>
+#include <vector>
+
+namespace jive {
+
+/**
+	\brief Linear sequence of encodable instructions and labels
+*/
+class instruction_sequence final {
+public:
+	static constexpr size_t no_label = std::numeric_limits<size_t>::max();
+
+	class entry final {
+	public:
+		const jive::instruction * icls;
+		std::vector<const jive::registers*> inputs;
+		std::vector<const jive::registers*> outputs;
+		std::vector<jive_codegen_imm> immediates;
+		jive_instruction_encoding_flags flags;
+		/** \brief Label referenced by the first immediate, or \ref no_label */
+		size_t label;
+	};
+
+	/** \brief Create a label, to be placed later */
+	inline size_t
+	create_label()
+	{
+		labels_.push_back(no_label);
+		return labels_.size()-1;
+	}
+
+	/** \brief Place a label at the current end of the sequence */
+	inline void
+	place_label(size_t label)
+	{
+		JIVE_DEBUG_ASSERT(label < labels_.size() && labels_[label] == no_label);
+		labels_[label] = entries_.size();
+	}
+
+	/**
+		\brief Append an instruction
+		\param label Label whose distance to the start of the instruction is
+		       added to the value of the first immediate, e.g. a jump target
+
+		Immediates referencing a label are resolved by \ref emit_instructions,
+		their info field is ignored.
+	*/
+	inline void
+	add_instruction(
+		const jive::instruction * icls,
+		const std::vector<const jive::registers*> & inputs,
+		const std::vector<const jive::registers*> & outputs,
+		const std::vector<jive_codegen_imm> & immediates,
+		size_t label = no_label,
+		jive_instruction_encoding_flags flags = jive_instruction_encoding_flags_none)
+	{
+		JIVE_DEBUG_ASSERT(label == no_label || (label < labels_.size() && !immediates.empty()));
+		entries_.push_back({icls, inputs, outputs, immediates, flags, label});
+	}
+
+	inline size_t
+	ninstructions() const noexcept
+	{
+		return entries_.size();
+	}
+
+	inline const entry &
+	instruction(size_t n) const noexcept
+	{
+		JIVE_DEBUG_ASSERT(n < ninstructions());
+		return entries_[n];
+	}
+
+	inline size_t
+	nlabels() const noexcept
+	{
+		return labels_.size();
+	}
+
+	/** \brief Index of the instruction following the label, \ref no_label if not placed */
+	inline size_t
+	label_position(size_t label) const noexcept
+	{
+		JIVE_DEBUG_ASSERT(label < nlabels());
+		return labels_[label];
+	}
+
+private:
+	std::vector<entry> entries_;
+	std::vector<size_t> labels_;
+};
+
+/**
+	\brief Encode an instruction sequence into a section
+	\param sequence Instructions and labels to be encoded
+	\param target Section the encoded instructions are appended to
+	\return Offsets of the labels relative to the start of the sequence
+
+	Label references start out with the shortest encoding. Instructions
+	whose label distance no longer fits widen their encoding through the
+	option flags of \ref jive_instruction_encoding_flags, which never
+	shrink again. Only instructions whose label distance changed are
+	re-encoded, and label offsets are maintained incrementally, until the
+	encoding reaches a fixed point.
+*/
+std::vector<size_t>
+emit_instructions(const instruction_sequence & sequence, jive::section * target);
+
+}
+
+#endif
@@ -58,6 +58,25 @@ private:
 	jive::output * output_;
 };
 
+/**
+	\brief Timing of an instruction, in cycles
+
+	The latency is the number of cycles until the results of an instruction
+	are available to dependent instructions, the throughput the number of
+	cycles until the next instruction of the same kind can be issued.
+*/
+class instruction_timing {
+public:
+	inline constexpr
+	instruction_timing(size_t l, size_t t)
+	: latency(l)
+	, throughput(t)
+	{}
+
+	size_t latency;
+	size_t throughput;
+};
+
 class instructionset {
 public:
 	virtual
@@ -78,7 +97,11 @@ public:
 		jive::region * region,
 		jive::output * origin,
 		const jive::resource_class * in_class,
-		const jive::resource_class * out_class) = 0;
+		const jive::resource_class * out_class) const = 0;
+
+	/** \brief Timing of an instruction, defaults to single-cycle instructions */
+	virtual instruction_timing
+	timing(const jive::instruction * icls) const noexcept;
 };
 
 }
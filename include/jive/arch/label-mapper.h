@@ -46,10 +46,13 @@ public:
 		const jive_symbol_name_pair * pairs,
 		size_t npairs)
 	: label_name_mapper()
-	, npairs_(npairs)
 	, int_label_seqno_(0)
-	, pairs_(pairs)
-	{}
+	{
+		/* the first pair registered for a symbol takes precedence */
+		named_labels_.reserve(npairs);
+		for (size_t n = 0; n < npairs; n++)
+			named_labels_.insert({pairs[n].symbol, pairs[n].name});
+	}
 
 	virtual const char *
 	map_named_symbol(const jive_linker_symbol * symbol) override;
@@ -58,9 +61,8 @@ public:
 	map_anon_symbol(const void * symbol) override;
 
 private:
-	size_t npairs_;
 	size_t int_label_seqno_;
-	const jive_symbol_name_pair * pairs_;
+	std::unordered_map<const jive_linker_symbol*, const char*> named_labels_;
 	std::unordered_map<const void*, struct jive_anon_label> anon_labels_;
 };
 
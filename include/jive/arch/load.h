@@ -38,13 +38,21 @@ public:
 		const jive::simple_op & op,
 		const std::vector<jive::output*> & arguments) const override;
 
+	/* forward stored values to loads from the same address */
 	virtual void
 	set_reducible(bool enable);
 	inline bool
 	get_reducible() const noexcept { return enable_reducible_; }
 
+	/* replace loads by earlier loads that read the same memory contents */
+	virtual void
+	set_load_reduction(bool enable);
+	inline bool
+	get_load_reduction() const noexcept { return enable_load_reduction_; }
+
 private:
 	bool enable_reducible_;
+	bool enable_load_reduction_;
 };
 
 /* load operator */
@@ -9,12 +9,30 @@
 
 #include <jive/arch/memlayout.h>
 
+#include <map>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 
 namespace jive {
 
 /* simplistic implementation, for simple use cases & testing */
 
+/*
+	Layouts are cached by structure, i.e., records and unions with identical
+	element layouts as well as bitstrings of the same rounded width share a
+	single layout. Layouts do not refer to declarations, such that they stay
+	valid when the graphs owning the declarations are destroyed.
+
+	In front of the structural lookup, layouts are cached by the identifier
+	of a declaration's contents, which is never reused. Records and unions
+	that contain a declaration by value must be mapped after that
+	declaration is complete.
+
+	The mapper can be queried concurrently, lookups of already mapped types
+	only contend on a shared lock.
+*/
+
 /* FIXME: endianness */
 class memlayout_mapper_simple final : public memlayout_mapper {
 public:
@@ -40,10 +58,18 @@ public:
 	map_address()	override;
 
 private:
+	typedef std::vector<const dataitem_memlayout*> structure;
+
 	dataitem_memlayout address_layout_;
-	std::unordered_map<size_t, dataitem_memlayout> bitstring_map_;
-	std::unordered_map<const jive::unndeclaration*, union_memlayout> union_map_;
-	std::unordered_map<const jive::rcddeclaration*, record_memlayout> record_map_;
+
+	std::shared_timed_mutex mutex_;
+	std::unordered_map<size_t, const dataitem_memlayout*> bitstring_map_;
+	std::unordered_map<uint64_t, const record_memlayout*> record_map_;
+	std::unordered_map<uint64_t, const union_memlayout*> union_map_;
+
+	std::unordered_map<size_t, dataitem_memlayout> bitstring_layouts_;
+	std::map<structure, union_memlayout> union_layouts_;
+	std::map<structure, record_memlayout> record_layouts_;
 };
 
 }
@@ -14,6 +14,7 @@
 
 namespace jive {
 
+class graph;
 class rcddeclaration;
 class unndeclaration;
 class valuetype;
@@ -53,19 +54,9 @@ public:
 	~union_memlayout();
 
 	inline
-	union_memlayout(const unndeclaration * decl, size_t size, size_t alignment) noexcept
+	union_memlayout(size_t size, size_t alignment) noexcept
 		: dataitem_memlayout(size, alignment)
-		, decl_(decl)
 	{}
-
-	inline const unndeclaration *
-	declaration() const noexcept
-	{
-		return decl_;
-	}
-
-private:
-	const unndeclaration * decl_;
 };
 
 class record_memlayout_element {
@@ -99,17 +90,10 @@ public:
 	~record_memlayout();
 
 	record_memlayout(
-	const rcddeclaration * dcl,
 	const std::vector<record_memlayout_element> & elements,
 	size_t size,
 	size_t alignment) noexcept;
 
-	inline const rcddeclaration *
-	declaration() const noexcept
-	{
-		return dcl_;
-	}
-
 	inline size_t
 	nelements() const noexcept
 	{
@@ -130,7 +114,6 @@ public:
 	}
 
 private:
-	const rcddeclaration * dcl_;
 	std::vector<record_memlayout_element> elements_;
 };
 
@@ -171,6 +154,16 @@ public:
 	const dataitem_memlayout &
 	map_value_type(const valuetype & type);
 
+	/**
+		\brief Map the layouts of all types used within a graph
+
+		Maps the types of all ports as well as the records and element types
+		referenced by address operations. Subsequent queries for these types
+		are served from the caches of the mapper.
+	*/
+	void
+	map_types(const jive::graph * graph);
+
 private:
 	size_t bytes_per_word_;
 };
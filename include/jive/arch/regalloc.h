@@ -0,0 +1,106 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JIVE_ARCH_REGALLOC_H
+#define JIVE_ARCH_REGALLOC_H
+
+#include <jive/arch/registers.h>
+
+#include <unistd.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace jive {
+
+class instructionset;
+class node;
+class output;
+class region;
+
+class register_assignment;
+
+/**
+	\brief Linear-scan register allocation
+	\param region Region the scheduled nodes belong to
+	\param schedule Nodes of the region in emission order
+	\param isa Instruction set used to create copies, spills and reloads
+	\param frame_offset Frame pointer offset below which spill slots are placed
+	\return Registers assigned to the register values of the region
+
+	Assigns a register to every value of the region whose port constraints
+	intersect to a register class. Values are processed in the order of
+	their definition within the schedule. If no register is available, the
+	active value with the most distant use is spilled: it is stored to a
+	stack slot right after its definition and reloaded in front of all its
+	subsequent uses.
+
+	Spill slots are fixed stack slots whose offsets are relative to the
+	frame pointer of the enclosing subroutine. They occupy the area of
+	register_assignment::spill_area_size() bytes directly below
+	frame_offset, which the caller must reserve in the stack frame.
+
+	Copies are inserted in front of instructions that overwrite their first
+	input or that restrict a shared operand to a narrower register class.
+	All inserted nodes are added to the schedule.
+*/
+register_assignment
+allocate_registers(
+	jive::region * region,
+	std::vector<jive::node*> & schedule,
+	const jive::instructionset * isa,
+	ssize_t frame_offset);
+
+class register_assignment final {
+public:
+	inline
+	register_assignment()
+	: nspills_(0)
+	, spill_area_size_(0)
+	{}
+
+	inline const jive::registers *
+	lookup(const jive::output * output) const noexcept
+	{
+		auto it = registers_.find(output);
+		return it != registers_.end() ? it->second : nullptr;
+	}
+
+	inline size_t
+	size() const noexcept
+	{
+		return registers_.size();
+	}
+
+	/** \brief Number of values that were spilled to stack slots */
+	inline size_t
+	nspills() const noexcept
+	{
+		return nspills_;
+	}
+
+	/** \brief Size of the stack area below the frame offset used by spill slots */
+	inline size_t
+	spill_area_size() const noexcept
+	{
+		return spill_area_size_;
+	}
+
+private:
+	friend register_assignment
+	allocate_registers(
+		jive::region * region,
+		std::vector<jive::node*> & schedule,
+		const jive::instructionset * isa,
+		ssize_t frame_offset);
+
+	size_t nspills_;
+	size_t spill_area_size_;
+	std::unordered_map<const jive::output*, const jive::registers*> registers_;
+};
+
+}
+
+#endif
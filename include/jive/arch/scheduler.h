@@ -0,0 +1,37 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JIVE_ARCH_SCHEDULER_H
+#define JIVE_ARCH_SCHEDULER_H
+
+#include <vector>
+
+namespace jive {
+
+class instructionset;
+class node;
+class region;
+
+/**
+	\brief Order the nodes of a region for emission
+	\param region Region with matched instructions
+	\param isa Instruction set providing the instruction timings
+	\return All nodes of the region in emission order
+
+	Top-down list scheduling on a single-issue machine model. A node is
+	ready once all its operands are scheduled and available after the
+	latency of their producers, and an instruction cannot issue before
+	the previous instruction of the same kind has passed its throughput.
+	Among the ready nodes, the one on the longest latency path to the end
+	of the region is preferred. Once the live register values of a class
+	reach the number of its registers, nodes that free registers are
+	preferred over nodes that allocate further ones.
+*/
+std::vector<jive::node*>
+schedule_instructions(jive::region * region, const jive::instructionset * isa);
+
+}
+
+#endif
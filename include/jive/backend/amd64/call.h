@@ -0,0 +1,43 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JIVE_BACKEND_AMD64_CALL_H
+#define JIVE_BACKEND_AMD64_CALL_H
+
+#include <stddef.h>
+
+namespace jive {
+
+class node;
+
+namespace amd64 {
+
+/**
+	\brief Lower a call node according to the System V AMD64 calling convention
+
+	The first six integer arguments are passed in rdi, rsi, rdx, rcx, r8 and
+	r9, the first eight floating-point arguments in xmm0 to xmm7, and the
+	remaining ones in consecutive eight byte stack slots starting at the 16
+	byte aligned stack pointer. Integer results are returned in rax and rdx,
+	floating-point results in xmm0 and xmm1. All caller-saved registers are
+	clobbered by the call.
+*/
+jive::node *
+substitute_call(jive::node * node);
+
+/**
+	\brief Size of the outgoing stack argument area of a lowered call
+
+	The first stack argument is placed at the stack pointer, which the System
+	V ABI requires to be aligned to 16 bytes at the call site. The size is
+	rounded up to a multiple of 16 bytes, such that a frame reserving it
+	below a 16 byte aligned frame keeps the stack pointer aligned.
+*/
+size_t
+call_area_size(const jive::node * call);
+
+}}
+
+#endif
@@ -0,0 +1,29 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JIVE_BACKEND_AMD64_INSTRUCTIONMATCH_H
+#define JIVE_BACKEND_AMD64_INSTRUCTIONMATCH_H
+
+#include <jive/arch/regselector.h>
+
+namespace jive {
+namespace amd64 {
+
+/**
+	\brief Replace bitstring operations by amd64 instructions
+
+	Requires register classes to be assigned to all operands. Arithmetic,
+	logical and shift operations, compares feeding a match, register values,
+	and 64 bit loads and stores through general purpose registers are
+	supported. Constants are encoded as immediates if they fit the sign
+	extended 32 bit immediate fields, and are otherwise loaded into a
+	register first.
+*/
+void
+match_instructions(jive::graph * graph);
+
+}}
+
+#endif
@@ -0,0 +1,144 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JIVE_BACKEND_AMD64_INSTRUCTIONSET_H
+#define JIVE_BACKEND_AMD64_INSTRUCTIONSET_H
+
+#include <jive/arch/instruction.h>
+#include <jive/arch/instructionset.h>
+
+namespace jive {
+namespace amd64 {
+
+#define DECLARE_AMD64_INSTRUCTION(NAME) \
+class instr_##NAME : public jive::instruction { \
+public: \
+	instr_##NAME(); \
+\
+	virtual void \
+	encode(	\
+		jive::section * target, \
+		const jive::registers * inputs[], \
+		const jive::registers * outputs[], \
+		const jive_codegen_imm immediates[], \
+		jive_instruction_encoding_flags * flags) const override; \
+\
+	virtual void \
+	write_asm( \
+		jive::buffer * target, \
+		const jive::registers * inputs[], \
+		const jive::registers * outputs[], \
+		const jive_asmgen_imm immediates[], \
+		jive_instruction_encoding_flags * flags) const override; \
+\
+	virtual std::unique_ptr<jive::instruction> \
+	copy() const override; \
+\
+	static const instr_##NAME & \
+	instance() \
+	{ \
+		return instance_; \
+	} \
+\
+private: \
+	static const instr_##NAME instance_; \
+} \
+
+DECLARE_AMD64_INSTRUCTION(ret);
+
+DECLARE_AMD64_INSTRUCTION(int_load_imm);
+DECLARE_AMD64_INSTRUCTION(int_load64_disp);
+DECLARE_AMD64_INSTRUCTION(int_store64_disp);
+
+DECLARE_AMD64_INSTRUCTION(int_add);
+DECLARE_AMD64_INSTRUCTION(int_sub);
+DECLARE_AMD64_INSTRUCTION(int_and);
+DECLARE_AMD64_INSTRUCTION(int_or);
+DECLARE_AMD64_INSTRUCTION(int_xor);
+DECLARE_AMD64_INSTRUCTION(int_mul);
+DECLARE_AMD64_INSTRUCTION(int_mul_expand_signed);
+DECLARE_AMD64_INSTRUCTION(int_mul_expand_unsigned);
+DECLARE_AMD64_INSTRUCTION(int_sdiv);
+DECLARE_AMD64_INSTRUCTION(int_udiv);
+DECLARE_AMD64_INSTRUCTION(int_shl);
+DECLARE_AMD64_INSTRUCTION(int_shr);
+DECLARE_AMD64_INSTRUCTION(int_ashr);
+
+DECLARE_AMD64_INSTRUCTION(int_add_immediate);
+DECLARE_AMD64_INSTRUCTION(int_sub_immediate);
+DECLARE_AMD64_INSTRUCTION(int_and_immediate);
+DECLARE_AMD64_INSTRUCTION(int_or_immediate);
+DECLARE_AMD64_INSTRUCTION(int_xor_immediate);
+DECLARE_AMD64_INSTRUCTION(int_mul_immediate);
+DECLARE_AMD64_INSTRUCTION(int_shl_immediate);
+DECLARE_AMD64_INSTRUCTION(int_shr_immediate);
+DECLARE_AMD64_INSTRUCTION(int_ashr_immediate);
+
+DECLARE_AMD64_INSTRUCTION(int_neg);
+DECLARE_AMD64_INSTRUCTION(int_not);
+
+DECLARE_AMD64_INSTRUCTION(int_transfer);
+
+DECLARE_AMD64_INSTRUCTION(call);
+DECLARE_AMD64_INSTRUCTION(call_reg);
+
+DECLARE_AMD64_INSTRUCTION(int_cmp);
+DECLARE_AMD64_INSTRUCTION(int_cmp_immediate);
+
+DECLARE_AMD64_INSTRUCTION(int_jump_sless);
+DECLARE_AMD64_INSTRUCTION(int_jump_uless);
+DECLARE_AMD64_INSTRUCTION(int_jump_slesseq);
+DECLARE_AMD64_INSTRUCTION(int_jump_ulesseq);
+DECLARE_AMD64_INSTRUCTION(int_jump_equal);
+DECLARE_AMD64_INSTRUCTION(int_jump_notequal);
+DECLARE_AMD64_INSTRUCTION(int_jump_sgreater);
+DECLARE_AMD64_INSTRUCTION(int_jump_ugreater);
+DECLARE_AMD64_INSTRUCTION(int_jump_sgreatereq);
+DECLARE_AMD64_INSTRUCTION(int_jump_ugreatereq);
+DECLARE_AMD64_INSTRUCTION(jump);
+
+DECLARE_AMD64_INSTRUCTION(sse_load32_disp);
+DECLARE_AMD64_INSTRUCTION(sse_store32_disp);
+DECLARE_AMD64_INSTRUCTION(sse_xor);
+DECLARE_AMD64_INSTRUCTION(float_add);
+DECLARE_AMD64_INSTRUCTION(float_sub);
+DECLARE_AMD64_INSTRUCTION(float_mul);
+DECLARE_AMD64_INSTRUCTION(float_div);
+DECLARE_AMD64_INSTRUCTION(float_cmp);
+DECLARE_AMD64_INSTRUCTION(float_transfer);
+
+class instructionset final : public jive::instructionset {
+public:
+	virtual
+	~instructionset();
+
+	inline constexpr
+	instructionset()
+	{}
+
+	virtual const jive::instruction *
+	jump_instruction() const noexcept override;
+
+	virtual const jive::register_classifier *
+	classifier() const noexcept override;
+
+	virtual jive::xfer_description
+	create_xfer(
+		jive::region * region,
+		jive::output * origin,
+		const jive::resource_class * in_class,
+		const jive::resource_class * out_class) const override;
+
+	static inline instructionset *
+	get()
+	{
+		static instructionset iset;
+		return &iset;
+	}
+};
+
+}}
+
+#endif
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JIVE_BACKEND_AMD64_REGISTERSET_H
+#define JIVE_BACKEND_AMD64_REGISTERSET_H
+
+#include <jive/arch/registers.h>
+
+namespace jive {
+namespace amd64 {
+
+/* registers */
+
+extern const jive::registers cc;
+extern const jive::registers rax, rcx, rdx, rbx, rsp, rbp, rsi, rdi;
+extern const jive::registers r8, r9, r10, r11, r12, r13, r14, r15;
+extern const jive::registers xmm0, xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7;
+extern const jive::registers xmm8, xmm9, xmm10, xmm11, xmm12, xmm13, xmm14, xmm15;
+
+/* register classes */
+
+extern const jive::register_class gpr_regcls;
+extern const jive::register_class xmm_regcls;
+extern const jive::register_class cc_regcls;
+
+/* gpr sub classes */
+
+extern const jive::register_class rax_regcls;
+extern const jive::register_class rcx_regcls;
+extern const jive::register_class rdx_regcls;
+extern const jive::register_class rbx_regcls;
+extern const jive::register_class rsp_regcls;
+extern const jive::register_class rbp_regcls;
+extern const jive::register_class rsi_regcls;
+extern const jive::register_class rdi_regcls;
+extern const jive::register_class r8_regcls;
+extern const jive::register_class r9_regcls;
+extern const jive::register_class r10_regcls;
+extern const jive::register_class r11_regcls;
+extern const jive::register_class r12_regcls;
+extern const jive::register_class r13_regcls;
+extern const jive::register_class r14_regcls;
+extern const jive::register_class r15_regcls;
+
+/* sse sub classes */
+
+extern const jive::register_class xmm0_regcls;
+extern const jive::register_class xmm1_regcls;
+extern const jive::register_class xmm2_regcls;
+extern const jive::register_class xmm3_regcls;
+extern const jive::register_class xmm4_regcls;
+extern const jive::register_class xmm5_regcls;
+extern const jive::register_class xmm6_regcls;
+extern const jive::register_class xmm7_regcls;
+extern const jive::register_class xmm8_regcls;
+extern const jive::register_class xmm9_regcls;
+extern const jive::register_class xmm10_regcls;
+extern const jive::register_class xmm11_regcls;
+extern const jive::register_class xmm12_regcls;
+extern const jive::register_class xmm13_regcls;
+extern const jive::register_class xmm14_regcls;
+extern const jive::register_class xmm15_regcls;
+
+}}
+
+#endif
@@ -0,0 +1,31 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JIVE_BACKEND_AMD64_RELOCATION_H
+#define JIVE_BACKEND_AMD64_RELOCATION_H
+
+/*
+	Relocation type defines for amd64. Note that both naming and numbering
+	corresponds to ELF conventions, but the ELF values are not used here
+	directly because the compiler should at this stage not have a
+	dependence on the ELF format.
+*/
+
+#include <jive/arch/compilate.h>
+
+static const jive_relocation_type JIVE_R_X86_64_64 = {1};
+static const jive_relocation_type JIVE_R_X86_64_PC32 = {2};
+static const jive_relocation_type JIVE_R_X86_64_32 = {10};
+static const jive_relocation_type JIVE_R_X86_64_32S = {11};
+static const jive_relocation_type JIVE_R_X86_64_8 = {14};
+static const jive_relocation_type JIVE_R_X86_64_PC8 = {15};
+static const jive_relocation_type JIVE_R_X86_64_PC64 = {24};
+
+bool
+jive_amd64_process_relocation(
+	void * where, size_t max_size, jive_offset offset,
+	jive_relocation_type type, jive_offset target, jive_offset value);
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JIVE_BACKEND_I386_ELF_H
+#define JIVE_BACKEND_I386_ELF_H
+
+#include <jive/arch/compilate.h>
+#include <jive/arch/label-mapper.h>
+
+#include <string>
+#include <vector>
+
+namespace jive {
+namespace i386 {
+
+/**
+	\brief Global symbol defined by an object file
+*/
+class elf_symbol {
+public:
+	inline
+	elf_symbol(
+		const std::string & name,
+		jive_stdsectionid section,
+		jive_offset offset,
+		size_t size)
+	: name_(name)
+	, section_(section)
+	, offset_(offset)
+	, size_(size)
+	{}
+
+	inline const std::string &
+	name() const noexcept
+	{
+		return name_;
+	}
+
+	inline jive_stdsectionid
+	section() const noexcept
+	{
+		return section_;
+	}
+
+	inline jive_offset
+	offset() const noexcept
+	{
+		return offset_;
+	}
+
+	inline size_t
+	size() const noexcept
+	{
+		return size_;
+	}
+
+private:
+	std::string name_;
+	jive_stdsectionid section_;
+	jive_offset offset_;
+	size_t size_;
+};
+
+/**
+	\brief Write a compilate as ELF32 i386 relocatable object
+	\param compilate Compilate to be written
+	\param mapper Provides the names of referenced linker symbols
+	\param symbols Global symbols defined by the object
+	\param target Buffer the object file is appended to
+
+	Every section of the compilate becomes one ELF section, accompanied
+	by a REL section holding its relocations. References to sections
+	are expressed through section symbols, references to linker symbols
+	through undefined global symbols. As i386 uses implicit addends, the
+	values of the relocation records are folded into the section contents.
+
+	Throws a \ref jive::compiler_error if a relocation cannot be expressed.
+*/
+void
+write_elf(
+	const jive::compilate & compilate,
+	jive::label_name_mapper & mapper,
+	const std::vector<elf_symbol> & symbols,
+	jive::buffer & target);
+
+}
+}
+
+#endif
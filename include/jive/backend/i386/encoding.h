@@ -0,0 +1,97 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JIVE_BACKEND_I386_ENCODING_H
+#define JIVE_BACKEND_I386_ENCODING_H
+
+#include <jive/arch/instruction.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace jive {
+namespace i386 {
+
+/* machine code layout of an instruction, each form has its own encoding routine */
+enum class encoding_form : uint8_t {
+	simple
+, int_load_imm
+, loadstore32_disp
+, regreg
+, cmp_regreg
+, cmp_regreg_sse
+, imull
+, mul_regreg
+, mull
+, div_reg
+, shift_regimm
+, shift_regreg
+, regimm_readonly
+, regimm
+, mul_regimm
+, unaryreg
+, regmove
+, regmove_sse
+, call
+, call_reg
+, jump
+, jump_conditional
+, loadstoresse_disp
+, sseload_abs
+, regreg_sse
+, regreg_sse_prefixed
+, fp
+};
+
+/*
+	operand masks, one bit per register an operand may be assigned to:
+	bits 0-7 are the general purpose registers by their code, bits 8-15 the
+	sse registers, followed by the condition codes and the fp stack top
+*/
+static constexpr uint32_t operand_none = 0;
+static constexpr uint32_t operand_eax = 1 << 0;
+static constexpr uint32_t operand_ecx = 1 << 1;
+static constexpr uint32_t operand_edx = 1 << 2;
+static constexpr uint32_t operand_gpr = 0xff;
+static constexpr uint32_t operand_xmm = 0xff00;
+static constexpr uint32_t operand_cc = 1 << 16;
+static constexpr uint32_t operand_fp = 1 << 17;
+
+uint32_t
+operand_mask(const jive::registers * reg) noexcept;
+
+/*
+	Static encoding information of an instruction. The meaning of the code
+	depends on the form, it holds the opcode bytes and the ModRM extension
+	of the instruction.
+*/
+struct instruction_descriptor {
+	uint32_t code;
+	encoding_form form;
+	/* width of the immediate field in bits in its longest form, 0 without immediate */
+	uint8_t immediate_width;
+	uint32_t inputs[3];
+	uint32_t outputs[3];
+};
+
+/* instruction to be encoded with encode_batch */
+struct encoding_entry {
+	const instruction_descriptor * descriptor;
+	const jive::registers * inputs[3];
+	const jive::registers * outputs[3];
+	jive_codegen_imm immediate;
+	jive_instruction_encoding_flags flags;
+};
+
+/*
+	Encodes the given instructions in sequence into target. The encoding
+	flags of the entries are updated just as by instruction::encode.
+*/
+void
+encode_batch(encoding_entry * entries, size_t nentries, jive::section * target);
+
+}}
+
+#endif
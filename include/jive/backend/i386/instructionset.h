@@ -9,22 +9,54 @@
 
 #include <jive/arch/instruction.h>
 #include <jive/arch/instructionset.h>
+#include <jive/backend/i386/encoding.h>
 
 namespace jive {
 namespace i386 {
 
+/* common base of the i386 instructions, encoding is driven by their descriptors */
+class instruction : public jive::instruction {
+public:
+	virtual
+	~instruction();
+
+	inline
+	instruction(
+		const std::string & name,
+		const instruction_descriptor & descriptor,
+		const std::string & mnemonic,
+		const std::vector<const jive::register_class*> & inputs,
+		const std::vector<const jive::register_class*> & outputs,
+		size_t nimmediates,
+		enum jive::instruction::flags flags,
+		const jive::instruction * inverse_jump)
+	: jive::instruction(name, descriptor.code, mnemonic, inputs, outputs, nimmediates, flags,
+		inverse_jump)
+	, descriptor_(descriptor)
+	{}
+
+	inline const instruction_descriptor &
+	descriptor() const noexcept
+	{
+		return descriptor_;
+	}
+
+	virtual void
+	encode(
+		jive::section * target,
+		const jive::registers * inputs[],
+		const jive::registers * outputs[],
+		const jive_codegen_imm immediates[],
+		jive_instruction_encoding_flags * flags) const override;
+
+private:
+	const instruction_descriptor & descriptor_;
+};
+
 #define DECLARE_I386_INSTRUCTION(NAME) \
-class instr_##NAME : public jive::instruction { \
+class instr_##NAME : public jive::i386::instruction { \
 public: \
 	instr_##NAME(); \
-\
-	virtual void \
-	encode(	\
-		jive::section * target, \
-		const jive::registers * inputs[], \
-		const jive::registers * outputs[], \
-		const jive_codegen_imm immediates[], \
-		jive_instruction_encoding_flags * flags) const override; \
 \
 	virtual void \
 	write_asm( \
@@ -52,6 +84,7 @@ DECLARE_I386_INSTRUCTION(ret);
 DECLARE_I386_INSTRUCTION(int_load_imm);
 DECLARE_I386_INSTRUCTION(int_load32_disp);
 DECLARE_I386_INSTRUCTION(int_store32_disp);
+DECLARE_I386_INSTRUCTION(int_lea_disp);
 
 DECLARE_I386_INSTRUCTION(int_add);
 DECLARE_I386_INSTRUCTION(int_sub);
@@ -132,7 +165,10 @@ public:
 		jive::region * region,
 		jive::output * origin,
 		const jive::resource_class * in_class,
-		const jive::resource_class * out_class) override;
+		const jive::resource_class * out_class) const override;
+
+	virtual jive::instruction_timing
+	timing(const jive::instruction * icls) const noexcept override;
 
 	static inline instructionset *
 	get()
@@ -0,0 +1,33 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JIVE_BACKEND_I386_PEEPHOLE_H
+#define JIVE_BACKEND_I386_PEEPHOLE_H
+
+namespace jive {
+
+class graph;
+
+namespace i386 {
+
+/**
+	\brief Combine neighbouring instructions of a matched graph
+	\param graph Graph containing only instruction and immediate nodes
+
+	Sweeps every region bottom-up once and rewrites instruction patterns
+	into cheaper equivalents: register operands materialized from
+	immediates are folded into immediate forms, operations with neutral
+	immediates are removed, chained immediate additions and subtractions
+	are combined, additions to registers that remain live become lea,
+	multiplications by powers of two become shifts, and identical
+	immediate loads are shared. Patterns that change the condition codes
+	only apply when those are unused.
+*/
+void
+optimize_peephole(jive::graph * graph);
+
+}}
+
+#endif
@@ -7,9 +7,13 @@
 #define JIVE_EVALUATOR_EVAL_H
 
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace jive {
+
+class graph;
+
 namespace eval {
 
 class literal;
@@ -0,0 +1,28 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JIVE_OPT_DNE_H
+#define JIVE_OPT_DNE_H
+
+namespace jive {
+
+class graph;
+
+/**
+	\brief Dead node elimination
+
+	Computes the outputs and arguments of the graph that contribute to its
+	exports. Dead nodes are removed along with dead exit variables of gamma
+	nodes, dead loop variables of theta nodes, unused dependencies of lambda
+	and phi nodes, and dead recursion variables of phi nodes. Unlike
+	region::prune, this also removes the computations within subregions that
+	only feed dead structural outputs.
+*/
+void
+dne(jive::graph * graph);
+
+}
+
+#endif
@@ -0,0 +1,28 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JIVE_OPT_GVN_H
+#define JIVE_OPT_GVN_H
+
+namespace jive {
+
+class graph;
+
+/**
+	\brief Global value numbering
+
+	Assigns congruence classes to all outputs of the graph. Region arguments
+	are congruent to the origins of their structural inputs, except for loop
+	variables that change within the loop. A simple node that computes the
+	same value as a node in its own region or in an enclosing region is
+	removed, and the value of the latter is routed to its users. Constants are
+	only reused within the same region.
+*/
+void
+gvn(jive::graph * graph);
+
+}
+
+#endif
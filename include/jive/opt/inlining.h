@@ -0,0 +1,52 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JIVE_OPT_INLINING_H
+#define JIVE_OPT_INLINING_H
+
+#include <stddef.h>
+
+namespace jive {
+
+class graph;
+class lambda_node;
+class node;
+class output;
+
+/**
+	\brief Find the lambda a function value originates from
+	\param function Function value
+	\param recursive Set to true if the value is a recursion variable of a phi
+	\return The lambda node, or nullptr if it cannot be determined statically
+
+	Follows the value through region arguments of enclosing nodes, invariant
+	loop variables, and phi recursion variables.
+*/
+jive::lambda_node *
+callee(const jive::output * function, bool * recursive = nullptr);
+
+/**
+	\brief Replace a call by a copy of the callee's body
+	\param apply Apply node
+	\return True if the call was inlined
+
+	The context variables of the callee are routed into the region of the
+	apply node. The apply node is removed if the call was inlined.
+*/
+bool
+inline_apply(jive::node * apply);
+
+/**
+	\brief Inline calls to small functions
+	\param graph Graph
+	\param max_size Maximum number of nodes in a callee's region
+	\param max_depth Maximum number of times recursive calls are unfolded
+*/
+void
+inlining(jive::graph * graph, size_t max_size, size_t max_depth);
+
+}
+
+#endif
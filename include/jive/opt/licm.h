@@ -0,0 +1,38 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JIVE_OPT_LICM_H
+#define JIVE_OPT_LICM_H
+
+namespace jive {
+
+class graph;
+class theta_node;
+
+/**
+	\brief Hoist loop-invariant nodes out of a theta
+	\param theta Theta node
+	\return True if at least one node was hoisted
+
+	Moves every simple node of the theta's subregion whose operands are
+	invariant loop variables or constants in front of the theta. The results
+	of hoisted nodes enter the loop as new invariant loop variables. Nodes
+	with state operands or results are never hoisted.
+*/
+bool
+hoist_invariants(jive::theta_node * theta);
+
+/**
+	\brief Loop-invariant code motion for all thetas of a graph
+
+	Inner thetas are processed before the thetas they are nested in, such
+	that invariant nodes are hoisted through multiple levels of loops.
+*/
+void
+licm(jive::graph * graph);
+
+}
+
+#endif
@@ -0,0 +1,27 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JIVE_OPT_NARROWING_H
+#define JIVE_OPT_NARROWING_H
+
+namespace jive {
+
+class graph;
+
+/**
+	\brief Bitstring width narrowing
+
+	Replaces bitstring operations whose result is completely known by
+	constants. Additions, subtractions, multiplications, negations and
+	logical operations whose upper result bits are known are performed on
+	the lower bits of their operands only, and the result is concatenated
+	with the known upper bits.
+*/
+void
+narrow(jive::graph * graph);
+
+}
+
+#endif
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JIVE_OPT_ROUTE_H
+#define JIVE_OPT_ROUTE_H
+
+namespace jive {
+
+class output;
+class region;
+
+/**
+	\brief Check whether a region is nested within another one
+	\return True if ancestor is region itself or one of its enclosing regions
+*/
+bool
+is_ancestor(const jive::region * ancestor, const jive::region * region) noexcept;
+
+/**
+	\brief Make a value available in a nested region
+	\param origin Value in region or in one of its enclosing regions
+	\param region Target region
+	\return The value within region
+
+	Adds an entry variable, invariant loop variable, or context variable to
+	every structural node between the value's region and region.
+*/
+jive::output *
+route(jive::output * origin, jive::region * region);
+
+}
+
+#endif
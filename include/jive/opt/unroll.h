@@ -0,0 +1,58 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JIVE_OPT_UNROLL_H
+#define JIVE_OPT_UNROLL_H
+
+#include <stddef.h>
+
+namespace jive {
+
+class graph;
+class theta_node;
+
+/**
+	\brief Determine the number of iterations of a counted loop
+	\param theta Theta node
+	\param max Maximum number of iterations to consider
+	\return The number of times the body is executed, or zero if it is unknown
+	or exceeds max
+
+	A counted loop has a predicate that is computed by a match of a bitstring
+	comparison between a constant and an induction variable. The induction
+	variable starts at a constant and is updated by a bitstring operation
+	with a constant in each iteration. The comparison can use the induction
+	variable either before or after its update.
+*/
+size_t
+trip_count(const jive::theta_node * theta, size_t max);
+
+/**
+	\brief Unroll a counted loop
+	\param theta Theta node
+	\param factor Unroll factor
+	\return True if the loop was unrolled
+
+	Loops with at most factor iterations are replaced by copies of their
+	body. Otherwise, the body is replicated factor times within the loop
+	and the remaining iterations are peeled in front of it.
+*/
+bool
+unroll(jive::theta_node * theta, size_t factor);
+
+/**
+	\brief Unroll all counted loops of a graph
+	\param graph Graph
+	\param max_size Maximum number of nodes of a fully unrolled loop
+	\param factor Unroll factor for loops that are not fully unrolled
+
+	Inner loops are unrolled before the loops they are nested in.
+*/
+void
+unroll(jive::graph * graph, size_t max_size, size_t factor);
+
+}
+
+#endif
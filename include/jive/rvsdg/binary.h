@@ -18,7 +18,7 @@ namespace jive {
 
 class binary_op;
 
-class binary_normal_form final : public simple_normal_form {
+class binary_normal_form : public simple_normal_form {
 public:
 	virtual
 	~binary_normal_form() noexcept;
@@ -14,4 +14,14 @@ jive_graphs_equivalent(
 	size_t ncheck, jive::node * const check1[], jive::node * const check2[],
 	size_t nassumed, jive::node * const ass1[], jive::node * const ass2[]);
 
+/**
+	\brief Check whether the exports of two graphs are equivalent
+
+	Graphs whose root regions differ in their structural hash are
+	rejected immediately. Otherwise, the detailed matcher verifies
+	the equivalence of the nodes producing the exported values.
+*/
+bool
+jive_graphs_equivalent(jive::graph * graph1, jive::graph * graph2);
+
 #endif
@@ -56,10 +56,32 @@ public:
 		return enable_control_constant_reduction_;
 	}
 
+	/* independent sibling gammas with the same predicate origin are merged into one */
+	virtual void
+	set_fusion(bool enable);
+
+	inline bool
+	get_fusion() const noexcept
+	{
+		return enable_fusion_;
+	}
+
+	/* simple nodes that are computed identically in all alternatives are moved in front */
+	virtual void
+	set_hoisting(bool enable);
+
+	inline bool
+	get_hoisting() const noexcept
+	{
+		return enable_hoisting_;
+	}
+
 private:
 	bool enable_predicate_reduction_;
 	bool enable_invariant_reduction_;
 	bool enable_control_constant_reduction_;
+	bool enable_fusion_;
+	bool enable_hoisting_;
 };
 
 /* gamma operation */
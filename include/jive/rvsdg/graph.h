@@ -20,6 +20,8 @@
 
 namespace jive {
 
+class declaration_store;
+
 /* impport class */
 
 class impport : public port {
@@ -115,6 +117,8 @@ private:
 /* graph */
 
 class graph {
+	friend jive::region;
+
 public:
 	~graph();
 
@@ -126,18 +130,28 @@ public:
 		return root_;
 	}
 
+	/**
+		\brief Request a normalization of the entire graph
+
+		Required whenever the flags of a normal form change. Local
+		changes to the graph only mark the affected nodes as dirty.
+	*/
 	inline void
 	mark_denormalized() noexcept
 	{
 		normalized_ = false;
 	}
 
-	inline void
-	normalize()
-	{
-		root()->normalize(true);
-		normalized_ = true;
-	}
+	/**
+		\brief Normalize the graph
+
+		Normalizes all nodes of the graph if a normal form changed since
+		the last invocation. Otherwise, only nodes that were created or
+		whose operands changed, as well as the nodes affected by their
+		normalization, are revisited.
+	*/
+	void
+	normalize();
 
 	std::unique_ptr<jive::graph>
 	copy() const;
@@ -163,10 +177,27 @@ public:
 		root()->prune(true);
 	}
 
+	/**
+		\brief Record and union declarations of the graph
+	*/
+	inline jive::declaration_store &
+	declarations() const noexcept
+	{
+		return *declarations_;
+	}
+
 private:
+	typedef jive::detail::intrusive_list<
+		jive::region,
+		jive::region::graph_dirty_region_list_accessor
+	> graph_dirty_region_list;
+
 	bool normalized_;
+	/* regions with dirty nodes in the order in which they became dirty */
+	graph_dirty_region_list dirty_regions_;
 	jive::region * root_;
 	jive::node_normal_form_hash node_normal_forms_;
+	std::unique_ptr<jive::declaration_store> declarations_;
 };
 
 }
@@ -217,6 +217,8 @@ private:
 };
 
 class node {
+	friend jive::region;
+
 public:
 	virtual
 	~node();
@@ -304,6 +306,7 @@ protected:
 	add_output(std::unique_ptr<jive::output> output)
 	{
 		outputs_.push_back(std::move(output));
+		invalidate_structural_hash();
 	}
 
 	void
@@ -322,6 +325,19 @@ public:
 		return region_;
 	}
 
+	/**
+		\brief Normal form of the node's operation
+
+		The normal form is resolved on first use and cached in the node.
+		Normal forms are owned by the graph and keep their identity when
+		their flags change, hence the cached pointer never goes stale.
+	*/
+	inline jive::node_normal_form *
+	normal_form() const
+	{
+		return normal_form_ ? normal_form_ : resolve_normal_form();
+	}
+
 	virtual jive::node *
 	copy(jive::region * region, const std::vector<jive::output*> & operands) const = 0;
 
@@ -351,7 +367,38 @@ public:
 		return depth_;
 	}
 
+	/**
+		\brief Structural hash of a node
+
+		Computes a bottom-up hash over the operation, the port types
+		and the operand topology of the node, including the subregions
+		of structural nodes. Structurally equivalent nodes have equal
+		hashes. The hash is cached in the node and invalidated whenever
+		an operand of the node or of one of its predecessors changes.
+	*/
+	size_t
+	structural_hash() const;
+
+	void
+	invalidate_structural_hash();
+
+	/**
+		\brief Whether the node is being destroyed by a region sweep
+
+		Nodes removed by \ref region::prune have their destruction
+		announced in one batch before they are freed. Destructors of
+		such nodes and of their ports do not notify again.
+	*/
+	inline bool
+	swept() const noexcept
+	{
+		return swept_;
+	}
+
 private:
+	jive::node_normal_form *
+	resolve_normal_form() const;
+
 	jive::detail::intrusive_list_anchor<
 		jive::node
 	> region_node_list_anchor_;
@@ -364,6 +411,10 @@ private:
 		jive::node
 	> region_bottom_node_list_anchor_;
 
+	jive::detail::intrusive_list_anchor<
+		jive::node
+	> region_dirty_node_list_anchor_;
+
 public:
 	typedef jive::detail::intrusive_list_accessor<
 		jive::node,
@@ -380,8 +431,18 @@ public:
 		&jive::node::region_bottom_node_list_anchor_
 	> region_bottom_node_list_accessor;
 
+	typedef jive::detail::intrusive_list_accessor<
+		jive::node,
+		&jive::node::region_dirty_node_list_anchor_
+	> region_dirty_node_list_accessor;
+
 private:
+	bool dirty_;
+	bool swept_;
 	size_t depth_;
+	mutable size_t hash_;
+	mutable bool hash_valid_;
+	mutable jive::node_normal_form * normal_form_;
 	jive::graph * graph_;
 	jive::region * region_;
 	std::unique_ptr<jive::operation> operation_;
@@ -430,6 +491,9 @@ is(const jive::node * node) noexcept
 jive::node *
 producer(const jive::output * output) noexcept;
 
+size_t
+structural_hash(const jive::output * output);
+
 bool
 normalize(jive::node * node);
 
@@ -11,6 +11,10 @@
 #include <jive/rvsdg/node-normal-form.h>
 #include <jive/rvsdg/node.h>
 #include <jive/rvsdg/simple-node.h>
+#include <jive/util/hash.h>
+
+#include <functional>
+#include <typeinfo>
 
 namespace jive {
 
@@ -66,6 +70,7 @@ public:
 	inline
 	domain_const_op(const value_repr & value)
 	: nullary_op(TypeOfValue()(value))
+	, hash_(0)
 	, value_(value)
 	{}
 
@@ -88,6 +93,17 @@ public:
 		return FormatValue()(value_);
 	}
 
+	/* computed from the formatted value on first use, values have no hash of their own */
+	virtual size_t
+	hash() const noexcept override
+	{
+		if (hash_ == 0)
+			hash_ = detail::combine_hash(typeid(domain_const_op).hash_code(),
+				std::hash<std::string>()(debug_string())) | 1;
+
+		return hash_;
+	}
+
 	inline const value_repr &
 	value() const noexcept
 	{
@@ -109,6 +125,7 @@ public:
 	}
 
 private:
+	mutable size_t hash_;
 	value_repr value_;
 };
 
@@ -120,6 +120,15 @@ public:
 	virtual std::unique_ptr<jive::operation>
 	copy() const = 0;
 
+	/**
+		\brief Hash consistent with operator==
+
+		The default only distinguishes the classes of operations, operations
+		with attributes refine it.
+	*/
+	virtual size_t
+	hash() const noexcept;
+
 	inline bool
 	operator!=(const operation & other) const noexcept
 	{
@@ -26,6 +26,23 @@ public:
 	copy() const override;
 };
 
+/* Returns the index of the recursion variable of a phi region argument. The
+ * recursion variable arguments correspond in order to the results of the
+ * region and the outputs of the phi node. */
+static inline size_t
+recvar_index(const jive::argument * argument) noexcept
+{
+	JIVE_DEBUG_ASSERT(argument->input() == nullptr);
+
+	size_t index = 0;
+	for (size_t n = 0; n < argument->index(); n++) {
+		if (argument->region()->argument(n)->input() == nullptr)
+			index++;
+	}
+
+	return index;
+}
+
 class phi_builder;
 
 class recvar final {
@@ -113,6 +113,9 @@ private:
 };
 
 class region {
+	friend jive::graph;
+	friend jive::node;
+
 	typedef jive::detail::intrusive_list<
 		jive::node,
 		jive::node::region_node_list_accessor
@@ -128,7 +131,21 @@ class region {
 		jive::node::region_bottom_node_list_accessor
 	> region_bottom_node_list;
 
+	typedef jive::detail::intrusive_list<
+		jive::node,
+		jive::node::region_dirty_node_list_accessor
+	> region_dirty_node_list;
+
+	jive::detail::intrusive_list_anchor<
+		jive::region
+	> graph_dirty_region_list_anchor_;
+
 public:
+	typedef jive::detail::intrusive_list_accessor<
+		jive::region,
+		&jive::region::graph_dirty_region_list_anchor_
+	> graph_dirty_region_list_accessor;
+
 	~region();
 
 	region(jive::region * parent, jive::graph * graph);
@@ -237,12 +254,41 @@ public:
 		bool copy_arguments,
 		bool copy_results) const;
 
+	/**
+		\brief Remove all nodes that do not contribute to a result
+		\param recursive Prune the subregions of remaining structural nodes
+
+		Live nodes are marked in a single backward pass from the
+		results of the region. All other nodes are then freed in bulk.
+		Their destruction is announced in one batch, users before
+		producers, before any of them is unlinked.
+	*/
 	void
 	prune(bool recursive);
 
 	void
 	normalize(bool recursive);
 
+	/**
+		\brief Schedule a node for renormalization
+
+		Dirty nodes are revisited by the next \ref graph::normalize
+		invocation. Nodes are marked dirty upon creation and whenever
+		one of their operands changes.
+	*/
+	void
+	mark_dirty(jive::node * node);
+
+	/**
+		\brief Normalize all dirty nodes of the region
+
+		Processes the region's dirty nodes until none are left. Nodes
+		affected by the normalization of a node are marked dirty in
+		turn and processed as well.
+	*/
+	void
+	normalize_dirty();
+
 	region_nodes_list nodes;
 
 	region_top_node_list top_nodes;
@@ -250,8 +296,16 @@ public:
 	region_bottom_node_list bottom_nodes;
 
 private:
+	void
+	clear_dirty() noexcept;
+
+	void
+	sweep(std::vector<jive::node*> & dead);
+
+	bool dirty_;
 	jive::graph * graph_;
 	jive::structural_node * node_;
+	region_dirty_node_list dirty_nodes_;
 	std::vector<jive::result*> results_;
 	std::vector<jive::argument*> arguments_;
 };
@@ -265,6 +319,9 @@ remove(jive::node * node)
 size_t
 nnodes(const jive::region * region) noexcept;
 
+size_t
+structural_hash(const jive::region * region);
+
 size_t
 nstructnodes(const jive::region * region) noexcept;
 
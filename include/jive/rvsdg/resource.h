@@ -122,7 +122,6 @@ public:
 		const jive::type * type)
 	: priority(pr)
 	, restype_(restype)
-	, depth_(parent ? parent->depth()+1 : 0)
 	, name_(name)
 	, type_(type)
 	, parent_(parent)
@@ -130,10 +129,19 @@ public:
 	, demotions_(demotions)
 	{}
 
+	/**
+		\brief Number of steps from root resource class
+
+		Computed on demand: classes are commonly statically initialized in
+		arbitrary order, so the parent may not be constructed yet.
+	*/
 	inline size_t
 	depth() const noexcept
 	{
-		return depth_;
+		size_t depth = 0;
+		for (auto parent = parent_; parent; parent = parent->parent_)
+			depth++;
+		return depth;
 	}
 
 	inline const std::string &
@@ -183,7 +191,7 @@ public:
 	is_resource(const jive::resource_type * restype) const noexcept
 	{
 		auto tmp = resource_type();
-		while (restype) {
+		while (tmp) {
 			if (tmp == restype)
 				return true;
 			tmp = tmp->parent();
@@ -197,9 +205,6 @@ public:
 	
 private:
 	const jive::resource_type * restype_;
-
-	/** \brief Number of steps from root resource class */
-	size_t depth_;
 	std::string name_;
 
 	/** \brief Port type corresponding to this resource */
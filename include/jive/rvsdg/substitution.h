@@ -58,6 +58,18 @@ public:
 		structinput_map_[original] = substitute;
 	}
 
+	/**
+		\brief Reserve space for output substitutions
+
+		Avoids repeated rehashing when the number of substituted
+		outputs is known in advance, e.g., when copying a graph.
+	*/
+	inline void
+	reserve(size_t noutputs)
+	{
+		output_map_.reserve(noutputs);
+	}
+
 private:
 	std::unordered_map<const jive::region*, jive::region*> region_map_;
 	std::unordered_map<const jive::output*, jive::output*> output_map_;
@@ -8,11 +8,64 @@
 #define JIVE_RVSDG_THETA_H
 
 #include <jive/rvsdg/control.h>
+#include <jive/rvsdg/graph.h>
 #include <jive/rvsdg/region.h>
 #include <jive/rvsdg/structural-node.h>
+#include <jive/rvsdg/structural-normal-form.h>
 
 namespace jive {
 
+/* theta normal form */
+
+class theta_normal_form final : public structural_normal_form {
+public:
+	virtual
+	~theta_normal_form() noexcept;
+
+	theta_normal_form(
+		const std::type_info & operator_class,
+		jive::node_normal_form * parent,
+		jive::graph * graph) noexcept;
+
+	virtual bool
+	normalize_node(jive::node * node) const override;
+
+	/* a theta with constant false predicate is replaced by its body */
+	virtual void
+	set_predicate_reduction(bool enable);
+
+	inline bool
+	get_predicate_reduction() const noexcept
+	{
+		return enable_predicate_reduction_;
+	}
+
+	/* users of invariant loop variables are diverted to the loop variable's origin */
+	virtual void
+	set_invariant_reduction(bool enable);
+
+	inline bool
+	get_invariant_reduction() const noexcept
+	{
+		return enable_invariant_reduction_;
+	}
+
+	/* loop variables that are used neither outside nor within the loop are removed */
+	virtual void
+	set_dead_loopvar_reduction(bool enable);
+
+	inline bool
+	get_dead_loopvar_reduction() const noexcept
+	{
+		return enable_dead_loopvar_reduction_;
+	}
+
+private:
+	bool enable_predicate_reduction_;
+	bool enable_invariant_reduction_;
+	bool enable_dead_loopvar_reduction_;
+};
+
 /* theta operation */
 
 class theta_op final : public structural_op {
@@ -24,6 +77,12 @@ public:
 
 	virtual std::unique_ptr<jive::operation>
 	copy() const override;
+
+	static jive::theta_normal_form *
+	normal_form(jive::graph * graph) noexcept
+	{
+		return static_cast<jive::theta_normal_form*>(graph->node_normal_form(typeid(theta_op)));
+	}
 };
 
 /* theta node */
@@ -158,6 +217,15 @@ public:
 	jive::theta_output *
 	add_loopvar(jive::output * origin);
 
+	/**
+		\brief Remove a loop variable
+
+		The output must have no users and the argument no users other than
+		the loop variable's own result.
+	*/
+	void
+	remove_loopvar(jive::theta_output * output);
+
 	virtual jive::theta_node *
 	copy(jive::region * region, jive::substitution_map & smap) const override;
 };
@@ -37,6 +37,15 @@ public:
 
 	virtual std::string
 	debug_string() const = 0;
+
+	/**
+		\brief Hash consistent with operator==
+
+		The default only distinguishes the classes of types, types with
+		attributes refine it.
+	*/
+	virtual size_t
+	hash() const noexcept;
 };
 
 class valuetype : public jive::type {
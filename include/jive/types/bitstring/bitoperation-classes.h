@@ -50,6 +50,57 @@ public:
 	create(size_t nbits) const = 0;
 };
 
+/* Normal form of bitstring binary operations. In addition to the reductions
+ * of binary operations, it applies algebraic identities and replaces
+ * multiplications, divisions and remainders by constants with cheaper
+ * operations. Both are disabled by default. */
+class bitbinary_normal_form final : public binary_normal_form {
+public:
+	virtual
+	~bitbinary_normal_form() noexcept;
+
+	bitbinary_normal_form(
+		const std::type_info & operator_class,
+		jive::node_normal_form * parent,
+		jive::graph * graph);
+
+	virtual bool
+	normalize_node(jive::node * node) const override;
+
+	virtual std::vector<jive::output*>
+	normalized_create(
+		jive::region * region,
+		const jive::simple_op & op,
+		const std::vector<jive::output*> & arguments) const override;
+
+	/* identities, annihilators, and operations with equal operands */
+	virtual void
+	set_algebraic(bool enable);
+
+	inline bool
+	get_algebraic() const noexcept
+	{
+		return enable_algebraic_;
+	}
+
+	/* multiplications, divisions and remainders by constants */
+	virtual void
+	set_strength_reduction(bool enable);
+
+	inline bool
+	get_strength_reduction() const noexcept
+	{
+		return enable_strength_reduction_;
+	}
+
+private:
+	jive::output *
+	simplify(const jive::operation & op, jive::output * arg1, jive::output * arg2) const;
+
+	bool enable_algebraic_;
+	bool enable_strength_reduction_;
+};
+
 /* Represents a binary operation (possibly normalized n-ary if associative)
  * on a bitstring of a specific width, produces another bitstring of the
  * same width. */
@@ -88,6 +139,13 @@ public:
 	{
 		return *static_cast<const bittype*>(&result(0).type());
 	}
+
+	static jive::bitbinary_normal_form *
+	normal_form(jive::graph * graph) noexcept
+	{
+		return static_cast<jive::bitbinary_normal_form*>(
+			graph->node_normal_form(typeid(bitbinary_op)));
+	}
 };
 
 enum class compare_result {
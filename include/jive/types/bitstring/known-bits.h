@@ -0,0 +1,67 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JIVE_TYPES_BITSTRING_KNOWN_BITS_H
+#define JIVE_TYPES_BITSTRING_KNOWN_BITS_H
+
+#include <jive/types/bitstring/value-representation.h>
+#include <jive/util/callbacks.h>
+
+#include <unordered_map>
+
+namespace jive {
+
+class graph;
+class input;
+class output;
+
+/* Computes the bits of bitstring outputs that are known at compile time.
+ * Bits that are not known are represented as 'D'. Results are computed on
+ * demand and invalidated when the operands of a node change. */
+class known_bits final {
+public:
+	~known_bits() noexcept;
+
+	known_bits(jive::graph * graph);
+
+	known_bits(const known_bits &) = delete;
+
+	known_bits &
+	operator=(const known_bits &) = delete;
+
+	const jive::bitvalue_repr &
+	value(const jive::output * output);
+
+	inline jive::graph *
+	graph() const noexcept
+	{
+		return graph_;
+	}
+
+private:
+	jive::bitvalue_repr
+	compute(const jive::output * output);
+
+	void
+	invalidate(const jive::output * output);
+
+	/* invalidates the values that depend on the origin of input */
+	void
+	invalidate(const jive::input * input);
+
+	void
+	input_change(jive::input * input, jive::output * old_origin, jive::output * new_origin);
+
+	void
+	output_destroy(jive::output * output);
+
+	jive::graph * graph_;
+	std::unordered_map<const jive::output*, jive::bitvalue_repr> values_;
+	callback change_callback_, destroy_callback_;
+};
+
+}
+
+#endif
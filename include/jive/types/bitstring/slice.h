@@ -33,6 +33,9 @@ public:
 	virtual std::string
 	debug_string() const override;
 
+	virtual size_t
+	hash() const noexcept override;
+
 	virtual jive_unop_reduction_path_t
 	can_reduce_operand(
 		const jive::output * arg) const noexcept override;
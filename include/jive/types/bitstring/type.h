@@ -42,6 +42,9 @@ public:
 	virtual std::unique_ptr<jive::type>
 	copy() const override;
 
+	virtual size_t
+	hash() const noexcept override;
+
 private:
 	size_t nbits_;
 };
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JIVE_TYPES_DECLARATIONS_H
+#define JIVE_TYPES_DECLARATIONS_H
+
+#include <stdint.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace jive {
+
+class rcddeclaration;
+class unndeclaration;
+class valuetype;
+
+/*
+	Identifier of the contents of a declaration. Identifiers are unique
+	over the lifetime of the program and a declaration obtains a new one
+	whenever it is extended, such that they can key caches of information
+	derived from declarations.
+*/
+uint64_t
+create_declaration_id() noexcept;
+
+/*
+	Record and union declarations of a graph. The store is owned by the graph
+	and the declarations live as long as the graph.
+
+	Declarations that are created with all their element types are unique
+	within a graph, i.e., structurally identical declarations are shared.
+	Declarations that are created empty can be extended afterwards and are
+	never shared.
+*/
+class declaration_store final {
+public:
+	~declaration_store();
+
+	declaration_store();
+
+	declaration_store(const declaration_store &) = delete;
+
+	declaration_store &
+	operator=(const declaration_store &) = delete;
+
+	unndeclaration *
+	create_unndeclaration();
+
+	const unndeclaration *
+	unndeclaration_of(const std::vector<const valuetype*> & types);
+
+	rcddeclaration *
+	create_rcddeclaration();
+
+	const rcddeclaration *
+	rcddeclaration_of(const std::vector<const valuetype*> & types);
+
+	inline size_t
+	nunndeclarations() const noexcept
+	{
+		return unndeclarations_.size();
+	}
+
+	inline size_t
+	nrcddeclarations() const noexcept
+	{
+		return rcddeclarations_.size();
+	}
+
+private:
+	std::vector<std::unique_ptr<unndeclaration>> unndeclarations_;
+	std::vector<std::unique_ptr<rcddeclaration>> rcddeclarations_;
+	std::unordered_multimap<size_t, const unndeclaration*> unique_unndeclarations_;
+	std::unordered_multimap<size_t, const rcddeclaration*> unique_rcddeclarations_;
+};
+
+}
+
+#endif
@@ -10,12 +10,15 @@
 #include <jive/rvsdg/simple-node.h>
 #include <jive/rvsdg/type.h>
 #include <jive/rvsdg/unary.h>
+#include <jive/types/declarations.h>
 
 namespace jive {
 
 /* declaration */
 
 class rcddeclaration final {
+	friend class declaration_store;
+
 public:
 	inline
 	~rcddeclaration()
@@ -24,6 +27,7 @@ public:
 private:
 	inline
 	rcddeclaration()
+	: id_(create_declaration_id())
 	{}
 
 	rcddeclaration(const rcddeclaration &) = delete;
@@ -49,6 +53,14 @@ public:
 	append(const jive::valuetype & type)
 	{
 		types_.push_back(type.copy());
+		id_ = create_declaration_id();
+	}
+
+	/* identifies the current contents of the declaration */
+	inline uint64_t
+	id() const noexcept
+	{
+		return id_;
 	}
 
 	static inline std::unique_ptr<rcddeclaration>
@@ -67,13 +79,17 @@ public:
 		return dcl;
 	}
 
+	/* declaration owned by the graph, shared by all identical declarations of the graph */
+	static const rcddeclaration *
+	create(
+		jive::graph * graph,
+		const std::vector<const valuetype*> & types);
+
 private:
+	uint64_t id_;
 	std::vector<std::unique_ptr<jive::type>> types_;
 };
 
-void
-unregister_rcddeclarations(const jive::graph * graph);
-
 /* record type */
 
 class rcdtype final : public jive::valuetype {
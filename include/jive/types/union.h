@@ -10,12 +10,15 @@
 #include <jive/rvsdg/nullary.h>
 #include <jive/rvsdg/simple-node.h>
 #include <jive/rvsdg/unary.h>
+#include <jive/types/declarations.h>
 
 namespace jive {
 
 /* union declaration */
 
 class unndeclaration final {
+	friend class declaration_store;
+
 public:
 	inline
 	~unndeclaration()
@@ -24,6 +27,7 @@ public:
 private:
 	inline
 	unndeclaration()
+	: id_(create_declaration_id())
 	{}
 
 	unndeclaration(const unndeclaration &) = delete;
@@ -49,30 +53,31 @@ public:
 	append(const jive::valuetype & type)
 	{
 		types_.push_back(type.copy());
+		id_ = create_declaration_id();
+	}
+
+	/* identifies the current contents of the declaration */
+	inline uint64_t
+	id() const noexcept
+	{
+		return id_;
 	}
 
+	/* empty declaration owned by the graph, options are appended subsequently */
 	static unndeclaration *
-	create(const jive::graph * graph);
+	create(jive::graph * graph);
 
-	static inline unndeclaration *
+	/* declaration owned by the graph, shared by all identical declarations of the graph */
+	static const unndeclaration *
 	create(
-		const jive::graph * graph,
-		const std::vector<const valuetype*> & types)
-	{
-		auto dcl = create(graph);
-		for (const auto & type : types)
-			dcl->append(*type);
-
-		return dcl;
-	}
+		jive::graph * graph,
+		const std::vector<const valuetype*> & types);
 
 private:
+	uint64_t id_;
 	std::vector<std::unique_ptr<jive::type>> types_;
 };
 
-void
-unregister_unndeclarations(const jive::graph * graph);
-
 /* union type */
 
 class unntype final : public jive::valuetype {
@@ -67,9 +67,9 @@ public:
 	}
 
 	inline const uint8_t *
-	data()
+	data() const noexcept
 	{
-		return &data_[0];
+		return data_.data();
 	}
 
 	inline const char *
@@ -0,0 +1,24 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JIVE_UTIL_HASH_H
+#define JIVE_UTIL_HASH_H
+
+#include <stddef.h>
+
+namespace jive {
+namespace detail {
+
+/* mixes value into the hash seed, the result depends on the order of combination */
+static inline size_t
+combine_hash(size_t seed, size_t value) noexcept
+{
+	return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+}
+}
+
+#endif
@@ -331,6 +331,9 @@ transform_address(jive::node * node, memlayout_mapper & mapper)
 void
 transform_address(jive::graph * graph, memlayout_mapper & mapper)
 {
+	/* map all layouts up front, the transformations below only hit the caches */
+	mapper.map_types(graph);
+
 	for (auto node : jive::topdown_traverser(graph->root()))
 		transform_address(node, mapper);
 }
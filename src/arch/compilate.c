@@ -40,14 +40,8 @@ resolve_relocation_target(
 {
 	switch (target.type) {
 		case jive_symref_type_section: {
-			size_t n;
-			for (n = 0; n < map->sections.size(); ++n) {
-				if (map->sections[n].section->id() == target.ref.section) {
-					*resolved = map->sections[n].base;
-					return true;
-				}
-			}
-			return false;
+			*resolved = map->section(target.ref.section);
+			return *resolved != nullptr;
 		}
 		case jive_symref_type_linker_symbol: {
 			return jive_linker_symbol_resolver_resolve(sym_resolver, target.ref.linker_symbol, resolved);
@@ -74,14 +68,14 @@ section_process_relocations(
 	const jive_linker_symbol_resolver * sym_resolver,
 	jive_process_relocation_function relocate)
 {
-	for (auto & entry : section->relocations) {
-		void * where = entry->offset() + (char *) base_writable;
-		jive_offset offset = entry->offset() + base;
+	for (const auto & entry : section->relocations()) {
+		void * where = entry.offset() + (char *) base_writable;
+		jive_offset offset = entry.offset() + base;
 		const void * target;
-		if (!resolve_relocation_target(entry->target(), map, sym_resolver, &target))
+		if (!resolve_relocation_target(entry.target(), map, sym_resolver, &target))
 			return false;
-		if (!relocate(where, section->size() - entry->offset(),
-			offset, entry->type(), (uintptr_t) target, entry->value())) {
+		if (!relocate(where, section->size() - entry.offset(),
+			offset, entry.type(), (uintptr_t) target, entry.value())) {
 			return false;
 		}
 	}
@@ -109,7 +103,7 @@ section::add_relocation(
 	jive_symref target,
 	jive_offset value)
 {
-	relocations.insert(new relocation_entry(this->size(), type, target, value));
+	relocations_.push_back(relocation_entry(this->size(), type, target, value));
 	put(data, size);
 }
 
@@ -196,6 +190,13 @@ compilate::load(
 		
 		offset += map->sections[n].size;
 	}
+
+	for (const auto & cs : map->sections) {
+		size_t id = cs.section->id();
+		if (id >= map->bases_.size())
+			map->bases_.resize(id+1, nullptr);
+		map->bases_[id] = cs.base;
+	}
 	
 	/* finalize all sections and switch them over to their correct
 	permissions */
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jive/arch/emission.h>
+
+#include <jive/arch/instruction.h>
+
+namespace {
+
+/*
+	Binary indexed tree over the instruction sizes, yields the offset of an
+	instruction and absorbs a size change in logarithmic time.
+*/
+class offset_tree final {
+public:
+	inline
+	offset_tree(size_t size)
+	: tree_(size+1, 0)
+	{}
+
+	void
+	add(size_t index, ssize_t delta)
+	{
+		for (index++; index < tree_.size(); index += index & -index)
+			tree_[index] += delta;
+	}
+
+	/* sum of the sizes of the instructions preceding index */
+	size_t
+	offset(size_t index) const
+	{
+		ssize_t sum = 0;
+		for (; index > 0; index -= index & -index)
+			sum += tree_[index];
+		return sum;
+	}
+
+private:
+	std::vector<ssize_t> tree_;
+};
+
+static size_t
+encode(
+	const jive::instruction_sequence::entry & entry,
+	std::vector<jive_codegen_imm> & immediates,
+	jive_instruction_encoding_flags * flags,
+	jive::section * target)
+{
+	size_t size = target->size();
+	auto inputs = const_cast<const jive::registers**>(entry.inputs.data());
+	auto outputs = const_cast<const jive::registers**>(entry.outputs.data());
+	entry.icls->encode(target, inputs, outputs, immediates.data(), flags);
+	return target->size() - size;
+}
+
+}
+
+namespace jive {
+
+constexpr size_t instruction_sequence::no_label;
+
+std::vector<size_t>
+emit_instructions(const instruction_sequence & sequence, jive::section * target)
+{
+	size_t ninstructions = sequence.ninstructions();
+	std::vector<jive_instruction_encoding_flags> flags(ninstructions);
+	std::vector<size_t> sizes(ninstructions);
+	std::vector<jive_immediate_int> distances(ninstructions);
+	std::vector<std::vector<jive_codegen_imm>> immediates(ninstructions);
+
+	for (size_t n = 0; n < sequence.nlabels(); n++) {
+		if (sequence.label_position(n) == instruction_sequence::no_label)
+			throw jive::compiler_error("Label has not been placed.");
+	}
+
+	/* initial encoding with label distances unknown, yielding the short forms */
+	jive::section scratch(target->id());
+	offset_tree offsets(ninstructions);
+	std::vector<size_t> branches;
+	for (size_t n = 0; n < ninstructions; n++) {
+		const auto & entry = sequence.instruction(n);
+		immediates[n] = entry.immediates;
+		flags[n] = entry.flags;
+		if (entry.label != instruction_sequence::no_label) {
+			immediates[n][0].info = jive_codegen_imm_info_dynamic_unknown;
+			immediates[n][0].pc_relative = false;
+			branches.push_back(n);
+		}
+
+		scratch.clear();
+		sizes[n] = encode(entry, immediates[n], &flags[n], &scratch);
+		offsets.add(n, sizes[n]);
+	}
+
+	auto label_offset = [&](size_t label)
+	{
+		return offsets.offset(sequence.label_position(label));
+	};
+
+	/* widen label references until no distance changes anymore */
+	bool changed = true;
+	std::vector<bool> encoded(ninstructions, false);
+	while (changed) {
+		changed = false;
+		for (const auto & n : branches) {
+			const auto & entry = sequence.instruction(n);
+			jive_immediate_int distance = entry.immediates[0].value
+				+ jive_immediate_int(label_offset(entry.label)) - jive_immediate_int(offsets.offset(n));
+			if (encoded[n] && distance == distances[n])
+				continue;
+
+			distances[n] = distance;
+			encoded[n] = true;
+			immediates[n][0].info = jive_codegen_imm_info_dynamic_known;
+			immediates[n][0].value = distance;
+
+			scratch.clear();
+			size_t size = encode(entry, immediates[n], &flags[n], &scratch);
+			JIVE_DEBUG_ASSERT(size >= sizes[n]);
+			if (size != sizes[n]) {
+				offsets.add(n, size - sizes[n]);
+				sizes[n] = size;
+				changed = true;
+			}
+		}
+	}
+
+	/* final encoding, the distances are now fixed */
+	for (size_t n = 0; n < ninstructions; n++) {
+		if (sequence.instruction(n).label != instruction_sequence::no_label)
+			immediates[n][0].info = jive_codegen_imm_info_static_known;
+
+		size_t size = encode(sequence.instruction(n), immediates[n], &flags[n], target);
+		if (size != sizes[n])
+			throw jive::compiler_error("Instruction encoding did not converge.");
+	}
+
+	std::vector<size_t> labels;
+	for (size_t n = 0; n < sequence.nlabels(); n++)
+		labels.push_back(label_offset(n));
+
+	return labels;
+}
+
+}
@@ -12,4 +12,10 @@ namespace jive {
 instructionset::~instructionset()
 {}
 
+instruction_timing
+instructionset::timing(const jive::instruction * icls) const noexcept
+{
+	return instruction_timing(1, 1);
+}
+
 }
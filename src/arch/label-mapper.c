@@ -21,12 +21,8 @@ label_name_mapper_simple::~label_name_mapper_simple()
 const char *
 label_name_mapper_simple::map_named_symbol(const jive_linker_symbol * symbol)
 {
-	for (size_t n = 0; n < npairs_; n++) {
-		if (pairs_[n].symbol == symbol)
-			return pairs_[n].name;
-	}
-
-	return nullptr;
+	auto i = named_labels_.find(symbol);
+	return i != named_labels_.end() ? i->second : nullptr;
 }
 
 const char *
@@ -6,12 +6,20 @@
 
 #include <jive/arch/load.h>
 
+#include <jive/arch/address.h>
 #include <jive/arch/addresstype.h>
 #include <jive/arch/store.h>
 #include <jive/rvsdg/graph.h>
+#include <jive/rvsdg/label.h>
 #include <jive/rvsdg/simple-node.h>
+#include <jive/rvsdg/statemux.h>
+#include <jive/types/bitstring/arithmetic.h>
+#include <jive/types/bitstring/constant.h>
 #include <jive/types/bitstring/type.h>
 
+#include <algorithm>
+#include <unordered_map>
+
 namespace {
 
 jive::node_normal_form *
@@ -46,9 +54,11 @@ load_normal_form::load_normal_form(
 	jive::graph * graph) noexcept
 	: simple_normal_form(operator_class, parent, graph)
 	, enable_reducible_(true)
+	, enable_load_reduction_(true)
 {
 	if (auto p = dynamic_cast<load_normal_form *>(parent)) {
 		enable_reducible_ = p->enable_reducible_;
+		enable_load_reduction_ = p->enable_load_reduction_;
 	}
 }
 
@@ -62,32 +72,345 @@ is_matching_store_op(const jive::load_op & l_op, const jive::operation & op)
 	return l_op.addresstype() == s_op->addresstype() && l_op.valuetype() == s_op->valuetype();
 }
 
-static bool is_matching_store_node(
-	const jive::load_op & l_op, const jive::output * address,
-	const jive::node * node) {
-	return node &&
-		is_matching_store_op(l_op, node->operation()) &&
-		node->input(0)->origin() == address;
+/* memory disambiguation */
+
+namespace {
+
+/* An address decomposed into the object it points into and a path of
+ * constant accessors within that object. Record members and array elements
+ * with constant indices are recorded as accessors for address types, and
+ * constant byte offsets are accumulated for bitstring addresses. */
+struct address {
+	/* either a record member or an array element */
+	struct accessor {
+		const jive::rcddeclaration * dcl;
+		const jive::arraysubscript_op * subscript;
+		int64_t index;
+	};
+
+	const jive::output * origin;
+	const jive::label * label;
+	std::vector<accessor> path;
+	int64_t offset;
+};
+
+enum class alias { no, may, must };
+
 }
 
-bool
-load_normal_form::normalize_node(jive::node * node) const
+static bool
+constant_value(const jive::output * output, int64_t & value)
 {
-	if (get_mutable() && get_reducible()) {
-		const jive::load_op & l_op = static_cast<const jive::load_op &>(node->operation());
-		auto address = node->input(0)->origin();
-		jive::node * store_node =
-			(node->ninputs() >= 2 &&
-				is_matching_store_node(l_op, address,
-				node->input(1)->origin()->node())) ?
-			node->input(1)->origin()->node() : nullptr;
-		for (size_t n = 2; n < node->ninputs(); ++n) {
-			if (node->input(n)->origin()->node() != store_node) {
-				store_node = nullptr;
+	auto node = output->node();
+	auto op = node ? dynamic_cast<const bitconstant_op*>(&node->operation()) : nullptr;
+	if (!op || !op->value().is_known())
+		return false;
+
+	value = op->value().to_int();
+	return true;
+}
+
+static address
+decompose(const jive::output * output)
+{
+	address a = {nullptr, nullptr, {}, 0};
+	while (auto node = output->node()) {
+		auto & op = node->operation();
+		int64_t index;
+		if (auto mop = dynamic_cast<const memberof_op*>(&op)) {
+			a.path.push_back({mop->record_decl(), nullptr, static_cast<int64_t>(mop->index())});
+			output = node->input(0)->origin();
+		} else if (auto sop = dynamic_cast<const arraysubscript_op*>(&op)) {
+			if (!constant_value(node->input(1)->origin(), index))
+				break;
+
+			a.path.push_back({nullptr, sop, index});
+			output = node->input(0)->origin();
+		} else if (is<bitadd_op>(node) && node->ninputs() == 2) {
+			if (constant_value(node->input(1)->origin(), index)) {
+				output = node->input(0)->origin();
+			} else if (constant_value(node->input(0)->origin(), index)) {
+				output = node->input(1)->origin();
+			} else {
+				break;
 			}
+
+			a.offset += index;
+		} else {
+			break;
 		}
-		if (store_node) {
-			node->output(0)->divert_users(store_node->input(1)->origin());
+	}
+
+	if (auto node = output->node()) {
+		if (auto op = dynamic_cast<const lbl2addr_op*>(&node->operation()))
+			a.label = op->label();
+		if (auto op = dynamic_cast<const lbl2bit_op*>(&node->operation()))
+			a.label = op->label();
+	}
+
+	a.origin = output;
+	std::reverse(a.path.begin(), a.path.end());
+	return a;
+}
+
+/* the number of bytes accessed, or zero if unknown */
+static size_t
+access_size(const jive::valuetype & type) noexcept
+{
+	if (auto bt = dynamic_cast<const bittype*>(&type))
+		return (bt->nbits() + 7) / 8;
+
+	return 0;
+}
+
+/* stack slots are offsets from the frame or stack pointer, which both point into the stack frame */
+static bool
+is_stack_label(const jive::label * label) noexcept
+{
+	return label == fpoffset_label::get() || label == spoffset_label::get();
+}
+
+static bool
+is_same_object(const address & a1, const address & a2) noexcept
+{
+	if (a1.label && a2.label)
+		return a1.label == a2.label || (is_stack_label(a1.label) && is_stack_label(a2.label));
+
+	return a1.origin == a2.origin;
+}
+
+static bool
+is_distinct_object(const address & a1, const address & a2) noexcept
+{
+	return a1.label && a2.label && a1.label != a2.label
+	    && !(is_stack_label(a1.label) && is_stack_label(a2.label));
+}
+
+static bool
+is_same_aggregate(const address::accessor & acc1, const address::accessor & acc2) noexcept
+{
+	if (acc1.dcl || acc2.dcl)
+		return acc1.dcl == acc2.dcl;
+
+	return *acc1.subscript == *acc2.subscript;
+}
+
+static alias
+compare(const address & a1, size_t size1, const address & a2, size_t size2)
+{
+	if (is_distinct_object(a1, a2))
+		return alias::no;
+
+	if (!is_same_object(a1, a2))
+		return alias::may;
+
+	/* addresses of the frame and the stack pointer differ by an unknown amount */
+	bool same_base = a1.label == a2.label;
+
+	for (size_t n = 0; n < std::min(a1.path.size(), a2.path.size()); n++) {
+		auto & acc1 = a1.path[n], & acc2 = a2.path[n];
+		if (!same_base || !is_same_aggregate(acc1, acc2))
+			return alias::may;
+
+		/* distinct members of a record or distinct elements of an array */
+		if (acc1.index != acc2.index)
+			return alias::no;
+	}
+
+	if (!same_base || a1.path.size() != a2.path.size())
+		return alias::may;
+
+	if (a1.offset == a2.offset)
+		return alias::must;
+
+	if (size1 == 0 || size2 == 0)
+		return alias::may;
+
+	if (a1.offset + int64_t(size1) <= a2.offset || a2.offset + int64_t(size2) <= a1.offset)
+		return alias::no;
+
+	return alias::may;
+}
+
+/* Determines the outputs that define the memory contents at an address for
+ * memory states. Stores that do not alias the address are skipped, and state
+ * merges are looked through if all their operands have the same definition.
+ * The definitions of all visited states are memoized, such that every state
+ * is only visited once per walker, and addresses that must alias the
+ * address of the walker can share it. */
+class definition_walker final {
+public:
+	inline
+	definition_walker(const jive::output * origin, size_t size)
+	: address_(decompose(origin))
+	, size_(size)
+	{}
+
+	inline const address &
+	target() const noexcept
+	{
+		return address_;
+	}
+
+	/* the visited states in the order of their first visit */
+	inline const std::vector<const jive::output*> &
+	states() const noexcept
+	{
+		return states_;
+	}
+
+	const jive::output *
+	definition(const jive::output * state)
+	{
+		std::vector<const jive::output*> chain;
+		const jive::output * def = nullptr;
+		while (!def) {
+			auto it = definitions_.find(state);
+			if (it != definitions_.end()) {
+				def = it->second;
+				break;
+			}
+
+			states_.push_back(state);
+			chain.push_back(state);
+
+			auto node = state->node();
+			if (!node) {
+				def = state;
+			} else if (auto sop = dynamic_cast<const store_op*>(&node->operation())) {
+				auto b = decompose(node->input(0)->origin());
+				if (compare(address_, size_, b, access_size(sop->valuetype())) != alias::no)
+					def = state;
+				else
+					state = node->input(2 + state->index())->origin();
+			} else if (is_mux_op(node->operation()) && node->ninputs() != 0) {
+				def = definition(node->input(0)->origin());
+				for (size_t n = 1; n < node->ninputs(); n++) {
+					if (definition(node->input(n)->origin()) != def) {
+						def = state;
+						break;
+					}
+				}
+			} else {
+				def = state;
+			}
+		}
+
+		for (const auto & s : chain)
+			definitions_[s] = def;
+
+		return def;
+	}
+
+	/* the distinct definitions of the states of a load */
+	std::vector<const jive::output*>
+	definitions(const std::vector<jive::output*> & operands)
+	{
+		std::vector<const jive::output*> defs;
+		for (size_t n = 1; n < operands.size(); n++)
+			defs.push_back(definition(operands[n]));
+
+		std::sort(defs.begin(), defs.end());
+		defs.erase(std::unique(defs.begin(), defs.end()), defs.end());
+		return defs;
+	}
+
+private:
+	address address_;
+	size_t size_;
+	std::vector<const jive::output*> states_;
+	std::unordered_map<const jive::output*, const jive::output*> definitions_;
+};
+
+/* the value of a store that must alias the load and that defines all its states */
+static jive::output *
+forwarded_value(
+	const jive::load_op & op,
+	const std::vector<jive::output*> & operands,
+	definition_walker & walker)
+{
+	auto defs = walker.definitions(operands);
+
+	/* the states of a load can be several outputs of the same store */
+	jive::node * node = nullptr;
+	for (const auto & def : defs) {
+		if (!def->node() || (node && def->node() != node))
+			return nullptr;
+		node = def->node();
+	}
+
+	if (!node || !is_matching_store_op(op, node->operation()))
+		return nullptr;
+
+	auto b = decompose(node->input(0)->origin());
+	auto size = access_size(op.valuetype());
+	if (node->input(0)->origin() != operands[0] && compare(walker.target(), size, b, size) != alias::must)
+		return nullptr;
+
+	return node->input(1)->origin();
+}
+
+/* the value of a load from the same address with the same definitions */
+static jive::output *
+equivalent_load(
+	const jive::load_op & op,
+	const std::vector<jive::output*> & operands,
+	const jive::node * self,
+	definition_walker & walker)
+{
+	auto defs = walker.definitions(operands);
+
+	/* the candidates must alias the load, they share the walker and its memoized definitions */
+	auto size = access_size(op.valuetype());
+	size_t nstates = walker.states().size();
+	for (size_t n = 0; n < nstates; n++) {
+		for (const auto & user : *walker.states()[n]) {
+			auto node = user->node();
+			if (!node || node == self || user->index() == 0 || node->operation() != op)
+				continue;
+
+			/* loads on the same depth or above can not depend on self */
+			if (self && node->depth() > self->depth())
+				continue;
+
+			auto address = node->input(0)->origin();
+			if (address != operands[0]
+			&& compare(walker.target(), size, decompose(address), size) != alias::must)
+				continue;
+
+			if (walker.definitions(jive::operands(node)) == defs)
+				return node->output(0);
+		}
+	}
+
+	return nullptr;
+}
+
+static jive::output *
+reduced_value(
+	const load_normal_form & nf,
+	const jive::load_op & op,
+	const std::vector<jive::output*> & operands,
+	const jive::node * self)
+{
+	definition_walker walker(operands[0], access_size(op.valuetype()));
+
+	jive::output * value = nullptr;
+	if (nf.get_reducible())
+		value = forwarded_value(op, operands, walker);
+	if (!value && nf.get_load_reduction())
+		value = equivalent_load(op, operands, self, walker);
+
+	return value;
+}
+
+bool
+load_normal_form::normalize_node(jive::node * node) const
+{
+	if (get_mutable()) {
+		auto & op = static_cast<const jive::load_op&>(node->operation());
+		if (auto value = reduced_value(*this, op, jive::operands(node), node)) {
+			node->output(0)->divert_users(value);
 			remove(node);
 			return false;
 		}
@@ -102,22 +425,10 @@ load_normal_form::normalized_create(
 	const jive::simple_op & op,
 	const std::vector<jive::output*> & args) const
 {
-	if (get_mutable() && get_reducible()) {
-		const jive::load_op & l_op = static_cast<const jive::load_op &>(op);
-		auto addr = args[0];
-		jive::node * store_node = nullptr;
-		if (args.size() >= 2 && args[1]->node() && is_matching_store_node(l_op, addr, args[1]->node()))
-			store_node = args[1]->node();
-
-		for (size_t n = 2; n < args.size(); ++n) {
-			if (args[n]->node() != store_node) {
-				store_node = nullptr;
-				break;
-			}
-		}
-		if (store_node) {
-			return {store_node->input(1)->origin()};
-		}
+	if (get_mutable()) {
+		auto & l_op = static_cast<const jive::load_op&>(op);
+		if (auto value = reduced_value(*this, l_op, args, nullptr))
+			return {value};
 	}
 
 	return simple_normal_form::normalized_create(region, op, args);
@@ -137,6 +448,20 @@ load_normal_form::set_reducible(bool enable)
 		graph()->mark_denormalized();
 }
 
+void
+load_normal_form::set_load_reduction(bool enable)
+{
+	if (get_load_reduction() == enable) {
+		return;
+	}
+
+	children_set<load_normal_form, &load_normal_form::set_load_reduction>(enable);
+
+	enable_load_reduction_ = enable;
+	if (get_mutable() && enable)
+		graph()->mark_denormalized();
+}
+
 /* load operator */
 
 load_op::~load_op() noexcept
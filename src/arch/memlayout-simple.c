@@ -18,74 +18,114 @@ memlayout_mapper_simple::~memlayout_mapper_simple()
 const record_memlayout &
 memlayout_mapper_simple::map_record(const rcddeclaration * dcl)
 {
-	auto i = record_map_.find(dcl);
-	if (i != record_map_.end())
-		return i->second;
-
-	size_t pos = 0, alignment = 1;
-	std::vector<record_memlayout_element> elements;
-	for (size_t n = 0; n < dcl->nelements(); n++) {
-		auto & ext = map_value_type(dcl->element(n));
-		
-		alignment = std::max(alignment, ext.alignment());
-
-		size_t mask = ext.alignment() - 1;
-		pos = (pos + mask) & ~mask;
-		elements.push_back(record_memlayout_element(ext.size(), pos));
-		
-		pos = pos + ext.size();
+	{
+		std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+		auto i = record_map_.find(dcl->id());
+		if (i != record_map_.end())
+			return *i->second;
 	}
-	pos = (pos + alignment - 1) & ~(alignment - 1);
 
-	record_map_.insert(std::make_pair(dcl, record_memlayout(dcl, elements, pos, alignment)));
-	return record_map_.find(dcl)->second;
+	/*
+		Declarations are owned by graphs and their addresses can be reused,
+		layouts are therefore shared by the layouts of their elements. These
+		are mapped without holding the lock, they might be records themselves.
+	*/
+	structure elements;
+	for (size_t n = 0; n < dcl->nelements(); n++)
+		elements.push_back(&map_value_type(dcl->element(n)));
+
+	std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+	auto i = record_layouts_.find(elements);
+	if (i == record_layouts_.end()) {
+		size_t pos = 0, alignment = 1;
+		std::vector<record_memlayout_element> layouts;
+		for (const auto & ext : elements) {
+			alignment = std::max(alignment, ext->alignment());
+
+			size_t mask = ext->alignment() - 1;
+			pos = (pos + mask) & ~mask;
+			layouts.push_back(record_memlayout_element(ext->size(), pos));
+
+			pos = pos + ext->size();
+		}
+		pos = (pos + alignment - 1) & ~(alignment - 1);
+
+		i = record_layouts_.insert(std::make_pair(elements,
+			record_memlayout(layouts, pos, alignment))).first;
+	}
+
+	record_map_[dcl->id()] = &i->second;
+	return i->second;
 }
 
 const union_memlayout &
 memlayout_mapper_simple::map_union(const unndeclaration * dcl)
 {
-	auto i = union_map_.find(dcl);
-	if (i != union_map_.end())
-		return i->second;
-	
-	size_t size = 0, alignment = 1;
-	for (size_t n = 0; n < dcl->noptions(); n++) {
-		auto & ext = map_value_type(dcl->option(n));
-		alignment = std::max(alignment, ext.alignment());
-		size = std::max(size, ext.size());
+	{
+		std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+		auto i = union_map_.find(dcl->id());
+		if (i != union_map_.end())
+			return *i->second;
 	}
-	size = (size + alignment - 1) & ~(alignment - 1);
 
-	union_map_.insert(std::make_pair(dcl, union_memlayout(dcl, size, alignment)));
-	return union_map_.find(dcl)->second;
+	structure options;
+	for (size_t n = 0; n < dcl->noptions(); n++)
+		options.push_back(&map_value_type(dcl->option(n)));
+
+	std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+	auto i = union_layouts_.find(options);
+	if (i == union_layouts_.end()) {
+		size_t size = 0, alignment = 1;
+		for (const auto & ext : options) {
+			alignment = std::max(alignment, ext->alignment());
+			size = std::max(size, ext->size());
+		}
+		size = (size + alignment - 1) & ~(alignment - 1);
+
+		i = union_layouts_.insert(std::make_pair(options, union_memlayout(size, alignment))).first;
+	}
+
+	union_map_[dcl->id()] = &i->second;
+	return i->second;
 }
 
 const dataitem_memlayout &
 memlayout_mapper_simple::map_bitstring(size_t nbits)
 {
-	auto i = bitstring_map_.find(nbits);
-	if (i != bitstring_map_.end())
-		return i->second;
+	{
+		std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+		auto i = bitstring_map_.find(nbits);
+		if (i != bitstring_map_.end())
+			return *i->second;
+	}
 
+	size_t rounded = nbits;
 	if (nbits > bits_per_word())
-		nbits = (nbits + bits_per_word() - 1) & ~ (bits_per_word() - 1);
+		rounded = (nbits + bits_per_word() - 1) & ~ (bits_per_word() - 1);
 	else if (nbits <= 8)
-		nbits = 8;
+		rounded = 8;
 	else if (nbits <= 16)
-		nbits = 16;
+		rounded = 16;
 	else if (nbits <= 32)
-		nbits = 32;
+		rounded = 32;
 	else if (nbits <= 64)
-		nbits = 64;
+		rounded = 64;
 	else if (nbits <= 128)
-		nbits = 128;
+		rounded = 128;
 	else
 		JIVE_DEBUG_ASSERT(0);
 
-	size_t size = nbits / 8;
-	size_t alignment = std::min(bytes_per_word(), size);
-	bitstring_map_.insert(std::make_pair(nbits, dataitem_memlayout(size, alignment)));
-	return bitstring_map_.find(nbits)->second;
+	std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+	auto i = bitstring_layouts_.find(rounded);
+	if (i == bitstring_layouts_.end()) {
+		size_t size = rounded / 8;
+		size_t alignment = std::min(bytes_per_word(), size);
+		i = bitstring_layouts_.insert(std::make_pair(rounded, dataitem_memlayout(size, alignment))).first;
+	}
+
+	/* cache under the requested width, such that odd widths are found again */
+	bitstring_map_[nbits] = &i->second;
+	return i->second;
 }
 
 const dataitem_memlayout &
@@ -7,9 +7,16 @@
 #include <jive/arch/memlayout.h>
 
 #include <jive/arch/address.h>
+#include <jive/arch/addresstype.h>
+#include <jive/rvsdg/graph.h>
+#include <jive/rvsdg/structural-node.h>
 #include <jive/types/bitstring/type.h>
+#include <jive/types/record.h>
 #include <jive/types/union.h>
 
+#include <typeindex>
+#include <unordered_map>
+
 namespace jive {
 
 dataitem_memlayout::~dataitem_memlayout()
@@ -22,36 +29,105 @@ record_memlayout::~record_memlayout()
 {}
 
 record_memlayout::record_memlayout(
-	const rcddeclaration * dcl,
 	const std::vector<record_memlayout_element> & elements,
 	size_t size,
 	size_t alignment) noexcept
 	: dataitem_memlayout(size, alignment)
-	, dcl_(dcl)
 	, elements_(elements)
-{
-	JIVE_DEBUG_ASSERT(dcl->nelements() == elements.size());
-}
+{}
 
 memlayout_mapper::~memlayout_mapper()
 {}
 
-const dataitem_memlayout &
-memlayout_mapper::map_value_type(const valuetype & type)
+typedef const dataitem_memlayout &(*type_mapper)(memlayout_mapper&, const valuetype&);
+
+static const type_mapper *
+find_type_mapper(const valuetype & type)
+{
+	static const std::unordered_map<std::type_index, type_mapper> map({
+	  {typeid(bittype), [](memlayout_mapper & mapper, const valuetype & type)
+			-> const dataitem_memlayout &
+		{
+			return mapper.map_bitstring(static_cast<const bittype*>(&type)->nbits());
+		}}
+	, {typeid(addrtype), [](memlayout_mapper & mapper, const valuetype & type)
+			-> const dataitem_memlayout &
+		{
+			return mapper.map_address();
+		}}
+	, {typeid(rcdtype), [](memlayout_mapper & mapper, const valuetype & type)
+			-> const dataitem_memlayout &
+		{
+			return mapper.map_record(static_cast<const rcdtype*>(&type)->declaration());
+		}}
+	, {typeid(unntype), [](memlayout_mapper & mapper, const valuetype & type)
+			-> const dataitem_memlayout &
+		{
+			return mapper.map_union(static_cast<const unntype*>(&type)->declaration());
+		}}
+	});
+
+	auto it = map.find(typeid(type));
+	return it != map.end() ? &it->second : nullptr;
+}
+
+/* maps the type if it has a layout, as well as the type an address refers to */
+static void
+map_type(memlayout_mapper & mapper, const jive::type & type)
+{
+	auto vt = dynamic_cast<const valuetype*>(&type);
+	if (!vt)
+		return;
+
+	auto f = find_type_mapper(*vt);
+	if (!f)
+		return;
+
+	(*f)(mapper, *vt);
+	if (auto at = dynamic_cast<const addrtype*>(vt))
+		map_type(mapper, at->type());
+}
+
+static void
+map_types(memlayout_mapper & mapper, const jive::region * region)
 {
-	if (auto t = dynamic_cast<const bittype*>(&type))
-		return map_bitstring(t->nbits());
+	for (size_t n = 0; n < region->narguments(); n++)
+		map_type(mapper, region->argument(n)->type());
+
+	for (const auto & node : region->nodes) {
+		for (size_t n = 0; n < node.noutputs(); n++)
+			map_type(mapper, node.output(n)->type());
 
-	if (dynamic_cast<const addrtype*>(&type))
-		return map_address();
+		auto & op = node.operation();
+		if (auto mop = dynamic_cast<const memberof_op*>(&op))
+			mapper.map_record(mop->record_decl());
+		else if (auto cop = dynamic_cast<const containerof_op*>(&op))
+			mapper.map_record(cop->record_decl());
+		else if (auto sop = dynamic_cast<const arraysubscript_op*>(&op))
+			map_type(mapper, sop->element_type());
+		else if (auto iop = dynamic_cast<const arrayindex_op*>(&op))
+			map_type(mapper, iop->element_type());
 
-	if (auto t = dynamic_cast<const rcdtype*>(&type))
-		return map_record(t->declaration());
+		if (auto snode = dynamic_cast<const jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < snode->nsubregions(); n++)
+				map_types(mapper, snode->subregion(n));
+		}
+	}
+}
 
-	if (auto t = dynamic_cast<const jive::unntype*>(&type))
-		return map_union(t->declaration());
+const dataitem_memlayout &
+memlayout_mapper::map_value_type(const valuetype & type)
+{
+	if (auto f = find_type_mapper(type))
+		return (*f)(*this, type);
 
 	throw compiler_error("Type not supported.");
 }
 
+void
+memlayout_mapper::map_types(const jive::graph * graph)
+{
+	jive::map_types(*this, graph->root());
+}
+
 }
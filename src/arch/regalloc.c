@@ -0,0 +1,449 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jive/arch/regalloc.h>
+
+#include <jive/arch/instruction.h>
+#include <jive/arch/instructionset.h>
+#include <jive/arch/stackslot.h>
+#include <jive/rvsdg/region.h>
+
+#include <algorithm>
+#include <memory>
+#include <queue>
+#include <set>
+
+namespace {
+
+/*
+	Positions within the schedule: node n of the schedule is placed at
+	2(n+1), region arguments are defined at 0 and region results are used
+	at 2(N+1). Spill stores are placed at the odd position following the
+	definition of a value, reloads at the odd position preceding a use.
+*/
+
+class interval final {
+public:
+	inline
+	interval(
+		jive::output * v,
+		const jive::resource_class * cls,
+		size_t s,
+		size_t e,
+		size_t n,
+		bool r)
+	: value(v)
+	, rescls(cls)
+	, start(s)
+	, end(e)
+	, seqno(n)
+	, reload(r)
+	, reg(nullptr)
+	{}
+
+	jive::output * value;
+	const jive::resource_class * rescls;
+	size_t start;
+	size_t end;
+	size_t seqno;
+	bool reload;
+	const jive::registers * reg;
+};
+
+struct interval_order {
+	inline bool
+	operator()(const interval * i1, const interval * i2) const noexcept
+	{
+		if (i1->start != i2->start)
+			return i1->start > i2->start;
+		return i1->seqno > i2->seqno;
+	}
+};
+
+struct spill_slot {
+	size_t size;
+	size_t end;
+	const jive::resource_class * rescls;
+};
+
+struct inserted_node {
+	size_t position;
+	bool reload;
+	jive::node * node;
+};
+
+static inline bool
+is_register_class(const jive::resource_class * rescls) noexcept
+{
+	return rescls->is_resource(&jive::register_resource);
+}
+
+static inline bool
+writes_input(const jive::node * node) noexcept
+{
+	if (!jive::is_instruction_node(node))
+		return false;
+
+	auto icls = static_cast<const jive::instruction_op*>(&node->operation())->icls();
+	return icls->ninputs() > 0
+	    && (icls->flags() & jive::instruction::flags::write_input) != jive::instruction::flags::none;
+}
+
+/*
+	Insert register copies that make the register constraints of an
+	instruction satisfiable: an instruction overwriting its first input
+	must not destroy a value that is still needed, and an operand that is
+	restricted to a narrower class must neither pin all other uses of its
+	value nor the result of an instruction overwriting its input. Values
+	without register constraint of their own, such as region arguments,
+	are treated as belonging to the widest register class of their use.
+*/
+static std::vector<jive::node*>
+insert_copies(
+	jive::region * region,
+	const std::vector<jive::node*> & schedule,
+	const jive::instructionset * isa)
+{
+	std::vector<jive::node*> result;
+	result.reserve(schedule.size());
+	for (const auto & node : schedule) {
+		if (!jive::is_instruction_node(node)) {
+			result.push_back(node);
+			continue;
+		}
+
+		auto icls = static_cast<const jive::instruction_op*>(&node->operation())->icls();
+		for (size_t n = 0; n < icls->ninputs(); n++) {
+			auto input = node->input(n);
+			auto origin = input->origin();
+			auto use_class = input->port().rescls();
+			if (!is_register_class(use_class))
+				continue;
+
+			auto def_class = origin->port().rescls();
+			if (!is_register_class(def_class))
+				def_class = jive::relax(use_class);
+			auto cls = jive::find_intersection(def_class, use_class);
+
+			bool shared = origin->nusers() > 1;
+			bool tied = n == 0 && shared && writes_input(node);
+			bool pinned = origin->node() && origin->index() == 0 && writes_input(origin->node());
+			bool narrowed = (shared || pinned) && cls != def_class;
+			if (!cls || tied || narrowed) {
+				auto xfer = isa->create_xfer(region, origin, def_class, use_class);
+				input->divert_to(xfer.output());
+				result.push_back(xfer.node());
+			}
+		}
+
+		result.push_back(node);
+	}
+
+	return result;
+}
+
+class linear_scan final {
+public:
+	inline
+	linear_scan(
+		jive::region * region,
+		std::vector<jive::node*> & schedule,
+		const jive::instructionset * isa,
+		ssize_t frame_offset)
+	: isa_(isa)
+	, region_(region)
+	, schedule_(schedule)
+	, nspills_(0)
+	, frame_offset_(frame_offset)
+	, lowest_offset_(frame_offset)
+	{}
+
+	void
+	run()
+	{
+		schedule_ = insert_copies(region_, schedule_, isa_);
+		for (size_t n = 0; n < schedule_.size(); n++)
+			position_[schedule_[n]] = 2*(n+1);
+		exit_ = 2*(schedule_.size()+1);
+
+		for (size_t n = 0; n < region_->narguments(); n++)
+			add_interval(region_->argument(n), 0, false);
+		for (const auto & node : schedule_) {
+			for (size_t n = 0; n < node->noutputs(); n++)
+				add_interval(node->output(n), position_[node], false);
+		}
+
+		while (!unhandled_.empty()) {
+			auto current = unhandled_.top();
+			unhandled_.pop();
+
+			expire(current->start);
+			auto reg = select_register(current);
+			if (!reg)
+				reg = evict(current);
+
+			current->reg = reg;
+			occupant_[reg] = current;
+			active_.insert(std::make_pair(current->end, current));
+			registers_[current->value] = reg;
+		}
+
+		rebuild_schedule();
+	}
+
+	inline std::unordered_map<const jive::output*, const jive::registers*> &
+	registers() noexcept
+	{
+		return registers_;
+	}
+
+	inline size_t
+	nspills() const noexcept
+	{
+		return nspills_;
+	}
+
+	inline size_t
+	spill_area_size() const noexcept
+	{
+		return frame_offset_ - lowest_offset_;
+	}
+
+private:
+	size_t
+	use_position(const jive::input * input) const
+	{
+		if (!input->node())
+			return exit_;
+
+		auto it = position_.find(input->node());
+		if (it == position_.end())
+			throw jive::compiler_error("Register value used by unscheduled node.");
+
+		return it->second;
+	}
+
+	void
+	add_interval(jive::output * value, size_t start, bool reload)
+	{
+		bool is_register = is_register_class(value->port().rescls());
+		auto rescls = value->port().rescls();
+		size_t end = start+1;
+		for (const auto & user : *value) {
+			auto use_class = user->port().rescls();
+			is_register = is_register || is_register_class(use_class);
+			rescls = rescls ? jive::find_intersection(rescls, use_class) : nullptr;
+			end = std::max(end, use_position(user));
+		}
+
+		if (!is_register)
+			return;
+
+		if (!rescls)
+			throw jive::compiler_error("Conflicting register constraints for value.");
+
+		intervals_.emplace_back(new interval(value, rescls, start, end, intervals_.size(), reload));
+		unhandled_.push(intervals_.back().get());
+	}
+
+	void
+	expire(size_t position)
+	{
+		while (!active_.empty() && active_.begin()->first <= position) {
+			occupant_.erase(active_.begin()->second->reg);
+			active_.erase(active_.begin());
+		}
+	}
+
+	const jive::registers *
+	select_register(const interval * current) const
+	{
+		/* an instruction overwriting its first input produces its result in the same register */
+		auto node = current->value->node();
+		if (node && current->value->index() == 0 && writes_input(node)) {
+			auto it = registers_.find(node->input(0)->origin());
+			auto reg = it != registers_.end() ? it->second : nullptr;
+			if (!reg || !current->rescls->resources().count(reg) || occupant_.count(reg))
+				throw jive::compiler_error("Unable to satisfy tied register constraint.");
+			return reg;
+		}
+
+		const jive::registers * selected = nullptr;
+		for (const auto & resource : current->rescls->resources()) {
+			auto reg = static_cast<const jive::registers*>(resource);
+			if (occupant_.count(reg))
+				continue;
+
+			if (!selected || reg->code() < selected->code())
+				selected = reg;
+		}
+
+		return selected;
+	}
+
+	const jive::registers *
+	evict(const interval * current)
+	{
+		/*
+			Spill the value whose next use is furthest away. Values defined at
+			the current position, reloads, and values needed by the very next
+			instruction cannot be evicted.
+		*/
+		size_t position = current->start;
+		interval * victim = nullptr;
+		for (const auto & resource : current->rescls->resources()) {
+			auto it = occupant_.find(resource);
+			if (it == occupant_.end())
+				continue;
+
+			auto candidate = it->second;
+			if (candidate->reload || candidate->start >= position || candidate->end <= position+1)
+				continue;
+
+			if (!victim || candidate->end > victim->end
+			|| (candidate->end == victim->end && candidate->seqno < victim->seqno))
+				victim = candidate;
+		}
+
+		if (!victim)
+			throw jive::compiler_error("Register allocation failed: no register available for value.");
+
+		active_.erase(std::make_pair(victim->end, victim));
+		occupant_.erase(victim->reg);
+		spill(victim, position);
+		nspills_++;
+
+		return victim->reg;
+	}
+
+	void
+	spill(interval * victim, size_t position)
+	{
+		std::vector<jive::input*> users;
+		for (const auto & user : *victim->value) {
+			if (use_position(user) > position)
+				users.push_back(user);
+		}
+
+		auto regcls = static_cast<const jive::register_class*>(victim->rescls);
+		auto slot = allocate_slot((regcls->nbits() + 7) / 8, victim->start+1, victim->end);
+
+		auto store = isa_->create_xfer(region_, victim->value, victim->rescls, slot);
+		position_[store.node()] = victim->start+1;
+		inserted_.push_back({victim->start+1, false, store.node()});
+
+		/* one reload per consuming node, all operands of a node share it */
+		std::unordered_map<const jive::node*, jive::output*> reloads;
+		std::vector<jive::output*> outputs;
+		for (const auto & user : users) {
+			auto node = user->node();
+			auto it = node ? reloads.find(node) : reloads.end();
+			if (it != reloads.end()) {
+				user->divert_to(it->second);
+				continue;
+			}
+
+			size_t pos = use_position(user)-1;
+			auto reload = isa_->create_xfer(region_, store.output(), slot, victim->rescls);
+			position_[reload.node()] = pos;
+			inserted_.push_back({pos, true, reload.node()});
+			user->divert_to(reload.output());
+			if (node)
+				reloads[node] = reload.output();
+			outputs.push_back(reload.output());
+		}
+
+		victim->end = position;
+		for (const auto & output : outputs)
+			add_interval(output, position_[output->node()], true);
+	}
+
+	const jive::resource_class *
+	allocate_slot(size_t size, size_t start, size_t end)
+	{
+		for (auto & slot : slots_) {
+			if (slot.size == size && slot.end < start) {
+				slot.end = end;
+				return slot.rescls;
+			}
+		}
+
+		/* slots are aligned to their size */
+		ssize_t alignment = size;
+		ssize_t offset = lowest_offset_ - alignment;
+		offset -= (offset % alignment + alignment) % alignment;
+		lowest_offset_ = offset;
+		auto rescls = jive_fixed_stackslot_class_get(size, size, offset);
+		slots_.push_back({size, end, rescls});
+		return rescls;
+	}
+
+	void
+	rebuild_schedule()
+	{
+		std::stable_sort(inserted_.begin(), inserted_.end(),
+			[](const inserted_node & n1, const inserted_node & n2)
+			{
+				if (n1.position != n2.position)
+					return n1.position < n2.position;
+				return !n1.reload && n2.reload;
+			});
+
+		std::vector<jive::node*> schedule;
+		schedule.reserve(schedule_.size() + inserted_.size());
+		auto it = inserted_.begin();
+		for (size_t n = 0; n < schedule_.size(); n++) {
+			for (; it != inserted_.end() && it->position < 2*(n+1); it++)
+				schedule.push_back(it->node);
+			schedule.push_back(schedule_[n]);
+		}
+		for (; it != inserted_.end(); it++)
+			schedule.push_back(it->node);
+
+		schedule_ = std::move(schedule);
+	}
+
+	const jive::instructionset * isa_;
+	jive::region * region_;
+	std::vector<jive::node*> & schedule_;
+
+	size_t exit_;
+	size_t nspills_;
+	ssize_t frame_offset_;
+	ssize_t lowest_offset_;
+	std::unordered_map<const jive::node*, size_t> position_;
+
+	std::vector<std::unique_ptr<interval>> intervals_;
+	std::priority_queue<interval*, std::vector<interval*>, interval_order> unhandled_;
+	std::set<std::pair<size_t, interval*>> active_;
+	std::unordered_map<const jive::resource*, interval*> occupant_;
+
+	std::vector<spill_slot> slots_;
+	std::vector<inserted_node> inserted_;
+	std::unordered_map<const jive::output*, const jive::registers*> registers_;
+};
+
+}
+
+namespace jive {
+
+register_assignment
+allocate_registers(
+	jive::region * region,
+	std::vector<jive::node*> & schedule,
+	const jive::instructionset * isa,
+	ssize_t frame_offset)
+{
+	linear_scan allocator(region, schedule, isa, frame_offset);
+	allocator.run();
+
+	register_assignment assignment;
+	assignment.registers_ = std::move(allocator.registers());
+	assignment.nspills_ = allocator.nspills();
+	assignment.spill_area_size_ = allocator.spill_area_size();
+	return assignment;
+}
+
+}
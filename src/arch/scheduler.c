@@ -0,0 +1,279 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jive/arch/scheduler.h>
+
+#include <jive/arch/instruction.h>
+#include <jive/arch/instructionset.h>
+#include <jive/arch/registers.h>
+#include <jive/rvsdg/region.h>
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+
+namespace {
+
+class schedule_node final {
+public:
+	inline
+	schedule_node(jive::node * n, size_t s, const jive::instruction * i, jive::instruction_timing t)
+	: node(n)
+	, icls(i)
+	, timing(t)
+	, seqno(s)
+	, height(0)
+	, npending(0)
+	, ready(0)
+	{}
+
+	jive::node * node;
+	const jive::instruction * icls;
+	jive::instruction_timing timing;
+	size_t seqno;
+
+	/* length of the longest latency path to the end of the region */
+	size_t height;
+	size_t npending;
+	/* earliest cycle at which all operands are available */
+	size_t ready;
+	std::vector<schedule_node*> successors;
+};
+
+/* relaxed register class of a value, nullptr for values not held in registers */
+static const jive::resource_class *
+value_class(const jive::output * output)
+{
+	auto rescls = output->port().rescls();
+	if (rescls->is_resource(&jive::register_resource))
+		return jive::relax(rescls);
+
+	for (const auto & user : *output) {
+		if (user->port().rescls()->is_resource(&jive::register_resource))
+			return jive::relax(user->port().rescls());
+	}
+
+	return nullptr;
+}
+
+class register_pressure final {
+public:
+	class effect {
+	public:
+		/* change of the number of live register values */
+		int delta;
+		/* a register class exceeds its number of registers */
+		bool exceeds;
+	};
+
+	inline
+	register_pressure(const jive::region * region)
+	{
+		for (size_t n = 0; n < region->narguments(); n++)
+			define(region->argument(n));
+	}
+
+	bool
+	high() const noexcept
+	{
+		for (const auto & pair : live_) {
+			if (pair.second >= pair.first->nresources())
+				return true;
+		}
+
+		return false;
+	}
+
+	effect
+	compute(const jive::node * node) const
+	{
+		std::unordered_map<const jive::resource_class*, int> deltas;
+		std::unordered_map<const jive::output*, size_t> uses;
+		for (size_t n = 0; n < node->ninputs(); n++) {
+			auto origin = node->input(n)->origin();
+			auto it = nuses_.find(origin);
+			if (it != nuses_.end() && ++uses[origin] == it->second)
+				deltas[value_class(origin)]--;
+		}
+
+		for (size_t n = 0; n < node->noutputs(); n++) {
+			auto output = node->output(n);
+			auto rescls = value_class(output);
+			if (rescls && output->nusers() != 0)
+				deltas[rescls]++;
+		}
+
+		effect e = {0, false};
+		for (const auto & pair : deltas) {
+			e.delta += pair.second;
+			auto it = live_.find(pair.first);
+			auto live = it != live_.end() ? it->second : 0;
+			if (pair.second > 0 && live + pair.second > pair.first->nresources())
+				e.exceeds = true;
+		}
+
+		return e;
+	}
+
+	void
+	update(const jive::node * node)
+	{
+		for (size_t n = 0; n < node->ninputs(); n++) {
+			auto origin = node->input(n)->origin();
+			auto it = nuses_.find(origin);
+			if (it != nuses_.end() && --it->second == 0) {
+				live_[value_class(origin)]--;
+				nuses_.erase(it);
+			}
+		}
+
+		for (size_t n = 0; n < node->noutputs(); n++)
+			define(node->output(n));
+	}
+
+private:
+	void
+	define(const jive::output * output)
+	{
+		auto rescls = value_class(output);
+		if (!rescls || output->nusers() == 0)
+			return;
+
+		/* uses by region results are never scheduled and keep the value alive */
+		nuses_[output] = output->nusers();
+		live_[rescls]++;
+	}
+
+	std::unordered_map<const jive::output*, size_t> nuses_;
+	std::unordered_map<const jive::resource_class*, size_t> live_;
+};
+
+}
+
+namespace jive {
+
+std::vector<jive::node*>
+schedule_instructions(jive::region * region, const jive::instructionset * isa)
+{
+	std::vector<std::unique_ptr<schedule_node>> nodes;
+	std::unordered_map<const jive::node*, schedule_node*> map;
+	for (auto & node : region->nodes) {
+		const jive::instruction * icls = nullptr;
+		jive::instruction_timing timing(0, 0);
+		if (is_instruction_node(&node)) {
+			icls = static_cast<const jive::instruction_op*>(&node.operation())->icls();
+			timing = isa->timing(icls);
+		}
+
+		nodes.emplace_back(new schedule_node(&node, nodes.size(), icls, timing));
+		map[&node] = nodes.back().get();
+	}
+
+	std::vector<schedule_node*> ready;
+	for (const auto & snode : nodes) {
+		for (size_t n = 0; n < snode->node->ninputs(); n++) {
+			auto producer = snode->node->input(n)->origin()->node();
+			if (!producer)
+				continue;
+
+			map[producer]->successors.push_back(snode.get());
+			snode->npending++;
+		}
+
+		if (snode->npending == 0)
+			ready.push_back(snode.get());
+	}
+
+	/* heights, in reverse topological order */
+	std::vector<schedule_node*> order(ready);
+	std::unordered_map<const schedule_node*, size_t> npending;
+	for (size_t n = 0; n < order.size(); n++) {
+		for (const auto & successor : order[n]->successors) {
+			auto it = npending.insert({successor, successor->npending}).first;
+			if (--it->second == 0)
+				order.push_back(successor);
+		}
+	}
+	for (auto it = order.rbegin(); it != order.rend(); it++) {
+		size_t height = 0;
+		for (const auto & successor : (*it)->successors)
+			height = std::max(height, successor->height);
+		(*it)->height = height + (*it)->timing.latency;
+	}
+
+	register_pressure pressure(region);
+	std::unordered_map<const jive::instruction*, size_t> busy;
+	auto earliest = [&](const schedule_node * snode)
+	{
+		auto it = busy.find(snode->icls);
+		return std::max(snode->ready, it != busy.end() ? it->second : 0);
+	};
+
+	size_t cycle = 0;
+	std::vector<jive::node*> schedule;
+	schedule.reserve(nodes.size());
+	while (!ready.empty()) {
+		/* stall until a node can issue */
+		size_t issue = earliest(ready.front());
+		for (const auto & snode : ready)
+			issue = std::min(issue, earliest(snode));
+		cycle = std::max(cycle, issue);
+
+		bool high = pressure.high();
+		size_t selected = ready.size();
+		register_pressure::effect best;
+		for (size_t n = 0; n < ready.size(); n++) {
+			auto candidate = ready[n];
+			if (earliest(candidate) > cycle)
+				continue;
+
+			auto e = pressure.compute(candidate->node);
+			if (selected != ready.size()) {
+				auto current = ready[selected];
+				if (e.exceeds != best.exceeds) {
+					if (e.exceeds)
+						continue;
+				} else if (high && e.delta != best.delta) {
+					if (e.delta > best.delta)
+						continue;
+				} else if (candidate->height != current->height) {
+					if (candidate->height < current->height)
+						continue;
+				} else if (e.delta != best.delta) {
+					if (e.delta > best.delta)
+						continue;
+				} else if (candidate->seqno > current->seqno) {
+					continue;
+				}
+			}
+
+			selected = n;
+			best = e;
+		}
+
+		auto snode = ready[selected];
+		ready[selected] = ready.back();
+		ready.pop_back();
+
+		schedule.push_back(snode->node);
+		pressure.update(snode->node);
+		for (const auto & successor : snode->successors) {
+			successor->ready = std::max(successor->ready, cycle + snode->timing.latency);
+			if (--successor->npending == 0)
+				ready.push_back(successor);
+		}
+
+		/* only instructions occupy the issue slot */
+		if (snode->icls) {
+			busy[snode->icls] = cycle + snode->timing.throughput;
+			cycle++;
+		}
+	}
+
+	JIVE_DEBUG_ASSERT(schedule.size() == nodes.size());
+	return schedule;
+}
+
+}
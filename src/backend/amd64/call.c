@@ -0,0 +1,160 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jive/backend/amd64/call.h>
+
+#include <jive/arch/address.h>
+#include <jive/arch/call.h>
+#include <jive/arch/instruction.h>
+#include <jive/arch/stackslot.h>
+#include <jive/backend/amd64/instructionset.h>
+#include <jive/backend/amd64/registerset.h>
+#include <jive/types/bitstring/type.h>
+#include <jive/types/float/flttype.h>
+#include <jive/types/record.h>
+#include <jive/types/union.h>
+#include <jive/rvsdg/label.h>
+#include <jive/rvsdg/region.h>
+#include <jive/rvsdg/splitnode.h>
+
+#include <algorithm>
+
+namespace jive {
+namespace amd64 {
+
+static const std::vector<const jive::register_class*> int_arguments({
+	&rdi_regcls, &rsi_regcls, &rdx_regcls, &rcx_regcls, &r8_regcls, &r9_regcls
+});
+
+static const std::vector<const jive::register_class*> flt_arguments({
+	&xmm0_regcls, &xmm1_regcls, &xmm2_regcls, &xmm3_regcls,
+	&xmm4_regcls, &xmm5_regcls, &xmm6_regcls, &xmm7_regcls
+});
+
+/* results come first, in the order of int_results and flt_results */
+static const std::vector<const jive::register_class*> clobbers({
+	&rax_regcls, &rdx_regcls, &rcx_regcls, &rsi_regcls, &rdi_regcls,
+	&r8_regcls, &r9_regcls, &r10_regcls, &r11_regcls,
+	&xmm0_regcls, &xmm1_regcls, &xmm2_regcls, &xmm3_regcls,
+	&xmm4_regcls, &xmm5_regcls, &xmm6_regcls, &xmm7_regcls,
+	&xmm8_regcls, &xmm9_regcls, &xmm10_regcls, &xmm11_regcls,
+	&xmm12_regcls, &xmm13_regcls, &xmm14_regcls, &xmm15_regcls,
+	&cc_regcls
+});
+
+static const size_t int_results[] = {0, 1};
+static const size_t flt_results[] = {9, 10};
+
+static inline bool
+is_float(const jive::type & type) noexcept
+{
+	return dynamic_cast<const jive::flt::type*>(&type) != nullptr;
+}
+
+static inline bool
+is_aggregate(const jive::type & type) noexcept
+{
+	return dynamic_cast<const jive::rcdtype*>(&type) != nullptr
+	    || dynamic_cast<const jive::unntype*>(&type) != nullptr;
+}
+
+jive::node *
+substitute_call(jive::node * node)
+{
+	JIVE_DEBUG_ASSERT(is_call_node(node));
+	auto op = static_cast<const jive::call_op*>(&node->operation());
+	auto region = node->region();
+	size_t nargs = node->ninputs() - 1;
+
+	for (size_t n = 0; n < nargs; n++) {
+		if (is_aggregate(node->input(n+1)->type()))
+			throw jive::compiler_error("Aggregates passed by value are not supported.");
+	}
+	for (size_t n = 0; n < op->nresults(); n++) {
+		if (is_aggregate(node->output(n)->type()))
+			throw jive::compiler_error("Aggregates returned by value are not supported.");
+	}
+
+	std::vector<jive::port> iports;
+	std::vector<jive::port> oports;
+	std::vector<jive::output*> operands;
+
+	const jive::instruction * icls;
+	auto & addrop = node->input(0)->origin()->node()->operation();
+	if (auto op = dynamic_cast<const jive::lbl2addr_op*>(&addrop)) {
+		icls = &instr_call::instance();
+		operands.push_back(jive::immediate_op::create(region, immediate(0, op->label())));
+	} else if (auto op = dynamic_cast<const jive::lbl2bit_op*>(&addrop)) {
+		icls = &instr_call::instance();
+		operands.push_back(jive::immediate_op::create(region, immediate(0, op->label())));
+	} else {
+		icls = &instr_call_reg::instance();
+		operands.push_back(node->input(0)->origin());
+	}
+
+	size_t nints = 0, nflts = 0, offset = 0;
+	for (size_t n = 0; n < nargs; n++) {
+		auto value = node->input(n+1)->origin();
+		auto value_cls = value->port().rescls();
+		bool flt = is_float(value->type());
+
+		if (value_cls == &jive_root_resource_class)
+			value_cls = flt ? &xmm_regcls : &gpr_regcls;
+
+		const jive::resource_class * arg_cls;
+		if (flt && nflts < flt_arguments.size()) {
+			arg_cls = flt_arguments[nflts++];
+		} else if (!flt && nints < int_arguments.size()) {
+			arg_cls = int_arguments[nints++];
+		} else {
+			/* the area starts at the stack pointer, which is 16 byte aligned at the call */
+			arg_cls = jive_callslot_class_get(8, offset == 0 ? 16 : 8, offset);
+			offset += 8;
+		}
+
+		iports.push_back(arg_cls);
+		operands.push_back(jive::split_op::create(value, value_cls, arg_cls));
+	}
+
+	for (const auto & cls : clobbers)
+		oports.push_back(cls);
+	for (size_t n = op->nresults(); n < node->noutputs(); n++)
+		oports.push_back(node->output(n)->port());
+
+	auto call = jive::create_instruction(region, icls, operands, iports, oports);
+
+	nints = nflts = 0;
+	for (size_t n = 0; n < op->nresults(); n++) {
+		size_t index;
+		if (is_float(node->output(n)->type())) {
+			JIVE_DEBUG_ASSERT(nflts < 2);
+			index = flt_results[nflts++];
+		} else {
+			JIVE_DEBUG_ASSERT(nints < 2);
+			index = int_results[nints++];
+		}
+		node->output(n)->divert_users(call->output(index));
+	}
+
+	for (size_t n = op->nresults(); n < node->noutputs(); n++)
+		node->output(n)->divert_users(call->output(clobbers.size() + n - op->nresults()));
+
+	return call;
+}
+
+size_t
+call_area_size(const jive::node * call)
+{
+	size_t size = 0;
+	for (size_t n = 0; n < call->ninputs(); n++) {
+		auto cls = dynamic_cast<const jive_callslot_class*>(call->input(n)->port().rescls());
+		if (cls)
+			size = std::max(size, cls->offset + cls->size);
+	}
+
+	return (size + 15) & ~size_t(15);
+}
+
+}}
@@ -0,0 +1,1276 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jive/arch/compilate.h>
+#include <jive/arch/stackslot.h>
+#include <jive/arch/subroutine.h>
+#include <jive/arch/subroutine/nodes.h>
+#include <jive/backend/amd64/classifier.h>
+#include <jive/backend/amd64/instructionset.h>
+#include <jive/backend/amd64/registerset.h>
+#include <jive/backend/amd64/relocation.h>
+#include <jive/util/buffer.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+
+static inline uint32_t
+cpu_to_le32(uint32_t value)
+{
+	/* FIXME: endianness */
+	return value;
+}
+
+static inline uint64_t
+cpu_to_le64(uint64_t value)
+{
+	/* FIXME: endianness */
+	return value;
+}
+
+static void
+putimm(jive::buffer * target, const jive_asmgen_imm * imm)
+{
+	bool empty = true;
+	if (imm->value) {
+		target->push_back(jive::detail::strfmt(imm->value));
+		empty = false;
+	}
+	if (imm->add_symbol) {
+		if (!empty)
+			target->push_back("+");
+		target->push_back(imm->add_symbol);
+		empty = false;
+	}
+	if (imm->sub_symbol) {
+		target->push_back("-");
+		target->push_back(imm->sub_symbol);
+		empty = false;
+	}
+	if (empty) {
+		target->push_back("0");
+	}
+}
+
+/* test whether the given immediate (plus offset) must be assumed to be
+outside the signed range of the given width, thus forcing to do an
+alternate instruction encoding; the encoding flags are also checked and
+possibly updated, to ensure that instruction encoding ultimately reaches
+a fixed point */
+static inline bool
+jive_amd64_check_long_form(
+	const jive_codegen_imm * imm,
+	jive_instruction_encoding_flags * flags,
+	jive_immediate_int offset,
+	size_t nbits = 8)
+{
+	bool need_long_form;
+	int64_t limit = int64_t(1) << (nbits-1);
+
+	switch (imm->info) {
+		case jive_codegen_imm_info_dynamic_known:
+		case jive_codegen_imm_info_static_known: {
+			int64_t dist = imm->value + offset;
+			need_long_form = (dist >= limit) || (dist < -limit);
+			break;
+		}
+		case jive_codegen_imm_info_static_unknown: {
+			need_long_form = true;
+			break;
+		}
+		case jive_codegen_imm_info_dynamic_unknown: {
+			need_long_form = false;
+			break;
+		}
+	}
+
+	if ( (*flags & jive_instruction_encoding_flags_option0) != 0) {
+		need_long_form = true;
+	} else if (need_long_form) {
+		*flags = *flags | jive_instruction_encoding_flags_option0;
+	}
+
+	return need_long_form;
+}
+
+/* PC-relative relocations are computed relative to the immediate field,
+whereas offsets are relative to the start of the instruction */
+static void
+jive_amd64_encode_imm8(
+	const jive_codegen_imm * imm,
+	jive_immediate_int offset,
+	size_t coded_size_so_far,
+	jive::section * target)
+{
+	jive_relocation_type reltype =
+		imm->pc_relative ?
+		JIVE_R_X86_64_PC8 :
+		JIVE_R_X86_64_8;
+
+	uint8_t value = imm->value + offset;
+
+	switch (imm->info) {
+		case jive_codegen_imm_info_dynamic_known:
+		case jive_codegen_imm_info_static_known: {
+			target->putbyte(value);
+			break;
+		}
+		case jive_codegen_imm_info_dynamic_unknown: {
+			target->putbyte(0);
+			break;
+		}
+		case jive_codegen_imm_info_static_unknown: {
+			if (imm->pc_relative)
+				value += coded_size_so_far;
+			target->add_relocation(&value, 1, reltype, imm->symref, 0);
+			break;
+		}
+	}
+}
+
+static void
+jive_amd64_encode_imm32(
+	const jive_codegen_imm * imm,
+	jive_immediate_int offset,
+	size_t coded_size_so_far,
+	jive::section * target)
+{
+	jive_relocation_type reltype =
+		imm->pc_relative ?
+		JIVE_R_X86_64_PC32 :
+		JIVE_R_X86_64_32S;
+
+	uint32_t value = imm->value + offset;
+
+	switch (imm->info) {
+		case jive_codegen_imm_info_dynamic_known:
+		case jive_codegen_imm_info_static_known: {
+			value = cpu_to_le32(value);
+			target->put(&value, sizeof(value));
+			break;
+		}
+		case jive_codegen_imm_info_dynamic_unknown: {
+			value = 0;
+			target->put(&value, sizeof(value));
+			break;
+		}
+		case jive_codegen_imm_info_static_unknown: {
+			if (imm->pc_relative)
+				value += coded_size_so_far;
+			value = cpu_to_le32(value);
+			target->add_relocation(&value, sizeof(value), reltype, imm->symref, 0);
+			break;
+		}
+	}
+}
+
+static void
+jive_amd64_encode_imm64(
+	const jive_codegen_imm * imm,
+	jive_immediate_int offset,
+	size_t coded_size_so_far,
+	jive::section * target)
+{
+	jive_relocation_type reltype =
+		imm->pc_relative ?
+		JIVE_R_X86_64_PC64 :
+		JIVE_R_X86_64_64;
+
+	uint64_t value = imm->value + offset;
+
+	switch (imm->info) {
+		case jive_codegen_imm_info_dynamic_known:
+		case jive_codegen_imm_info_static_known: {
+			value = cpu_to_le64(value);
+			target->put(&value, sizeof(value));
+			break;
+		}
+		case jive_codegen_imm_info_dynamic_unknown: {
+			value = 0;
+			target->put(&value, sizeof(value));
+			break;
+		}
+		case jive_codegen_imm_info_static_unknown: {
+			if (imm->pc_relative)
+				value += coded_size_so_far;
+			value = cpu_to_le64(value);
+			target->add_relocation(&value, sizeof(value), reltype, imm->symref, 0);
+			break;
+		}
+	}
+}
+
+/* emit a REX prefix carrying the operand width and the high bits of the
+register codes, returns the number of bytes emitted */
+static inline size_t
+jive_amd64_encode_rex(jive::section * target, bool wide, int reg, int rm)
+{
+	uint8_t rex = 0x40 | (wide ? 0x08 : 0) | ((reg & 8) >> 1) | ((rm & 8) >> 3);
+	if (rex == 0x40)
+		return 0;
+
+	target->putbyte(rex);
+	return 1;
+}
+
+static void
+putdisp(
+	jive::buffer * target,
+	const jive_asmgen_imm * disp,
+	const jive::registers * reg)
+{
+	putimm(target, disp);
+	target->push_back("(%");
+	target->push_back(reg->name());
+	target->push_back(")");
+}
+
+static inline void
+jive_amd64_r2i(
+	const jive::registers * r1,
+	const jive::registers * r2,
+	const jive_codegen_imm * imm,
+	size_t coded_size_so_far,
+	jive_instruction_encoding_flags * flags,
+	jive::section * target)
+{
+	bool need_long_form = jive_amd64_check_long_form(imm, flags, 0);
+
+	int regcode = (r1->code() & 7) | ((r2->code() & 7) << 3);
+
+	/* special treatment for load/store through rbp and r13: always encode displacement parameter */
+	bool code_displacement =
+		(r1->code() & 7) == 5 ||
+		need_long_form ||
+		imm->value != 0 ||
+		imm->info != jive_codegen_imm_info_static_known;
+
+	if (code_displacement) {
+		if (need_long_form)
+			regcode |= 0x80;
+		else
+			regcode |= 0x40;
+	}
+
+	target->putbyte(regcode);
+	coded_size_so_far ++;
+	if ((r1->code() & 7) == 4) {
+		/* rsp and r12 special treatment */
+		target->putbyte(0x24);
+		coded_size_so_far ++;
+	}
+
+	if (code_displacement) {
+		if (need_long_form) {
+			jive_amd64_encode_imm32(imm, 0, coded_size_so_far, target);
+		} else {
+			jive_amd64_encode_imm8(imm, 0, coded_size_so_far, target);
+		}
+	}
+}
+
+static void
+jive_amd64_encode_simple(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	target->putbyte(icls->code());
+}
+
+static void
+jive_amd64_asm_simple(
+	const jive::instruction * icls,
+	jive::buffer * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_asmgen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	target->push_back(icls->mnemonic());
+}
+
+static void
+jive_amd64_encode_int_load_imm(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	/* sign-extended 32 bit immediates if possible, symbols need the full width */
+	bool need_long_form = jive_amd64_check_long_form(&immediates[0], flags, 0, 32);
+
+	int reg = outputs[0]->code();
+	size_t size = jive_amd64_encode_rex(target, true, 0, reg);
+	if (!need_long_form) {
+		target->putbyte(icls->code());
+		target->putbyte(0xc0|(reg & 7));
+		jive_amd64_encode_imm32(&immediates[0], 0, size+2, target);
+	} else {
+		target->putbyte(0xb8|(reg & 7));
+		jive_amd64_encode_imm64(&immediates[0], 0, size+1, target);
+	}
+}
+
+static void
+jive_amd64_asm_int_load_imm(
+	const jive::instruction * icls,
+	jive::buffer * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_asmgen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	target->push_back(icls->mnemonic());
+	target->push_back("\t$");
+	putimm(target, &immediates[0]);
+	target->push_back(", %");
+	target->push_back(outputs[0]->name());
+}
+
+static void
+jive_amd64_encode_loadstore64_disp(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	const jive::registers * r1 = inputs[0], * r2;
+	if (icls->code() == 0x89)
+		r2 = inputs[1];
+	else
+		r2 = outputs[0];
+
+	size_t size = jive_amd64_encode_rex(target, true, r2->code(), r1->code());
+	target->putbyte(icls->code());
+	jive_amd64_r2i(r1, r2, &immediates[0], size+1, flags, target);
+}
+
+static void
+jive_amd64_asm_load_disp(
+	const jive::instruction * icls,
+	jive::buffer * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_asmgen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	target->push_back(icls->mnemonic());
+	target->push_back("\t");
+	putdisp(target, &immediates[0], inputs[0]);
+	target->push_back(", %");
+	target->push_back(outputs[0]->name());
+}
+
+static void
+jive_amd64_asm_store(
+	const jive::instruction * icls,
+	jive::buffer * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_asmgen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	target->push_back(icls->mnemonic());
+	target->push_back("\t%");
+	target->push_back(inputs[1]->name());
+	target->push_back(", ");
+	putdisp(target, &immediates[0], inputs[0]);
+}
+
+static void
+jive_amd64_encode_cmp_regreg(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	int r1 = inputs[0]->code();
+	int r2 = inputs[1]->code();
+
+	jive_amd64_encode_rex(target, true, r2, r1);
+	target->putbyte(icls->code());
+	target->putbyte(0xc0|(r1 & 7)|((r2 & 7)<<3));
+}
+
+static void
+jive_amd64_encode_regreg(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	JIVE_DEBUG_ASSERT(inputs[0] == outputs[0]);
+	jive_amd64_encode_cmp_regreg(icls, target, inputs, outputs, immediates, flags);
+}
+
+static void
+jive_amd64_asm_regreg(
+	const jive::instruction * icls,
+	jive::buffer * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_asmgen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	target->push_back(icls->mnemonic());
+	target->push_back("\t%");
+	target->push_back(inputs[1]->name());
+	target->push_back(", %");
+	target->push_back(inputs[0]->name());
+}
+
+static void
+jive_amd64_encode_mul_regreg(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	auto r1 = inputs[0]->code();
+	auto r2 = inputs[1]->code();
+
+	JIVE_DEBUG_ASSERT(r1 == outputs[0]->code());
+
+	jive_amd64_encode_rex(target, true, r1, r2);
+	target->putbyte(0x0f);
+	target->putbyte(0xaf);
+	target->putbyte(0xc0|(r2 & 7)|((r1 & 7)<<3));
+}
+
+static void
+jive_amd64_asm_div_reg(
+	const jive::instruction * icls,
+	jive::buffer * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_asmgen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	target->push_back(icls->mnemonic());
+	target->push_back("\t%");
+	target->push_back(inputs[2]->name());
+}
+
+static void
+jive_amd64_encode_div_reg(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	int r = inputs[2]->code();
+
+	jive_amd64_encode_rex(target, true, 0, r);
+	target->putbyte(0xf7);
+	target->putbyte(icls->code() | (r & 7));
+}
+
+static void
+jive_amd64_asm_mul_expand_reg(
+	const jive::instruction * icls,
+	jive::buffer * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_asmgen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	target->push_back(icls->mnemonic());
+	target->push_back("\t%");
+	target->push_back(inputs[1]->name());
+}
+
+static void
+jive_amd64_encode_mul_expand_reg(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	int r = inputs[1]->code();
+
+	jive_amd64_encode_rex(target, true, 0, r);
+	target->putbyte(0xf7);
+	target->putbyte(icls->code() | (r & 7));
+}
+
+static void
+jive_amd64_encode_shift_regimm(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	auto r1 = inputs[0]->code();
+	JIVE_DEBUG_ASSERT(r1 == outputs[0]->code());
+
+	bool code_constant_one =
+		immediates[0].info == jive_codegen_imm_info_static_known &&
+		immediates[0].value == 1 &&
+		immediates[0].symref.type == jive_symref_type_none;
+
+	size_t size = jive_amd64_encode_rex(target, true, 0, r1);
+	if (code_constant_one) {
+		target->putbyte(0xd1);
+		target->putbyte(icls->code() | (r1 & 7));
+	} else {
+		target->putbyte(0xc1);
+		target->putbyte(icls->code() | (r1 & 7));
+		jive_amd64_encode_imm8(&immediates[0], 0, size+2, target);
+	}
+}
+
+static void
+jive_amd64_asm_shift_regreg(
+	const jive::instruction * icls,
+	jive::buffer * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_asmgen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	target->push_back(icls->mnemonic());
+	target->push_back("\t%cl, %");
+	target->push_back(inputs[0]->name());
+}
+
+static void
+jive_amd64_encode_shift_regreg(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	auto r1 = inputs[0]->code();
+	JIVE_DEBUG_ASSERT(r1 == outputs[0]->code());
+
+	jive_amd64_encode_rex(target, true, 0, r1);
+	target->putbyte(0xd3);
+	target->putbyte(icls->code() | (r1 & 7));
+}
+
+static void
+jive_amd64_encode_regimm_readonly(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	int r1 = inputs[0]->code();
+
+	bool need_long_form = jive_amd64_check_long_form(&immediates[0], flags, 0);
+
+	size_t coded_size_so_far = jive_amd64_encode_rex(target, true, 0, r1);
+	target->putbyte(need_long_form ? 0x81 : 0x83);
+	target->putbyte(icls->code() | (r1 & 7));
+	coded_size_so_far += 2;
+
+	if (need_long_form)
+		jive_amd64_encode_imm32(&immediates[0], 0, coded_size_so_far, target);
+	else
+		jive_amd64_encode_imm8(&immediates[0], 0, coded_size_so_far, target);
+}
+
+static void
+jive_amd64_encode_regimm(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	JIVE_DEBUG_ASSERT(inputs[0] == outputs[0]);
+	jive_amd64_encode_regimm_readonly(icls, target, inputs, outputs, immediates, flags);
+}
+
+static void
+jive_amd64_asm_regimm(
+	const jive::instruction * icls,
+	jive::buffer * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_asmgen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	target->push_back(icls->mnemonic());
+	target->push_back("\t$");
+	putimm(target, &immediates[0]);
+	target->push_back(", %");
+	target->push_back(inputs[0]->name());
+}
+
+static void
+jive_amd64_encode_mul_regimm(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	int r1 = inputs[0]->code();
+	int r2 = outputs[0]->code();
+
+	bool need_long_form = jive_amd64_check_long_form(&immediates[0], flags, 0);
+
+	size_t size = jive_amd64_encode_rex(target, true, r2, r1);
+	target->putbyte(need_long_form ? 0x69 : 0x6b);
+	target->putbyte(0xc0 | ((r2 & 7) << 3) | (r1 & 7));
+
+	if (need_long_form)
+		jive_amd64_encode_imm32(&immediates[0], 0, size+2, target);
+	else
+		jive_amd64_encode_imm8(&immediates[0], 0, size+2, target);
+}
+
+static void
+jive_amd64_asm_mul_regimm(
+	const jive::instruction * icls,
+	jive::buffer * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_asmgen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	target->push_back(icls->mnemonic());
+	target->push_back("\t$");
+	putimm(target, &immediates[0]);
+	target->push_back(", %");
+	target->push_back(inputs[0]->name());
+	target->push_back(", %");
+	target->push_back(outputs[0]->name());
+}
+
+static void
+jive_amd64_encode_unaryreg(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	auto r1 = inputs[0]->code();
+
+	JIVE_DEBUG_ASSERT(r1 == outputs[0]->code());
+
+	jive_amd64_encode_rex(target, true, 0, r1);
+	target->putbyte(0xf7);
+	target->putbyte(icls->code()|(r1 & 7));
+}
+
+static void
+jive_amd64_asm_unaryreg(
+	const jive::instruction * icls,
+	jive::buffer * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_asmgen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	target->push_back(icls->mnemonic());
+	target->push_back("\t%");
+	target->push_back(inputs[0]->name());
+}
+
+static void
+jive_amd64_encode_regmove(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	int r1 = outputs[0]->code();
+	int r2 = inputs[0]->code();
+
+	jive_amd64_encode_rex(target, true, r2, r1);
+	target->putbyte(icls->code());
+	target->putbyte(0xc0|(r1 & 7)|((r2 & 7)<<3));
+}
+
+static void
+jive_amd64_asm_regmove(
+	const jive::instruction * icls,
+	jive::buffer * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_asmgen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	target->push_back(icls->mnemonic());
+	target->push_back("\t%");
+	target->push_back(inputs[0]->name());
+	target->push_back(", %");
+	target->push_back(outputs[0]->name());
+}
+
+static void
+jive_amd64_encode_call(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	target->putbyte(icls->code());
+	jive_amd64_encode_imm32(&immediates[0], -5, 1, target);
+}
+
+static void
+jive_amd64_asm_call(
+	const jive::instruction * icls,
+	jive::buffer * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_asmgen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	target->push_back(icls->mnemonic());
+	target->push_back("\t");
+	putimm(target, &immediates[0]);
+}
+
+static void
+jive_amd64_encode_call_reg(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	int r = inputs[0]->code();
+
+	jive_amd64_encode_rex(target, false, 0, r);
+	target->putbyte(0xff);
+	target->putbyte(0xd0 | (r & 7));
+}
+
+static void
+jive_amd64_asm_call_reg(
+	const jive::instruction * icls,
+	jive::buffer * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_asmgen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	target->push_back(icls->mnemonic());
+	target->push_back("\t*%");
+	target->push_back(inputs[0]->name());
+}
+
+static void
+jive_amd64_asm_jump(
+	const jive::instruction * icls,
+	jive::buffer * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_asmgen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	target->push_back(icls->mnemonic());
+	target->push_back("\t");
+	putimm(target, &immediates[0]);
+}
+
+static void
+jive_amd64_encode_jump(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	bool need_long_form = jive_amd64_check_long_form(&immediates[0], flags, -2);
+
+	if (!need_long_form) {
+		target->putbyte(0xeb);
+		jive_amd64_encode_imm8(&immediates[0], -2, 1, target);
+	} else {
+		target->putbyte(0xe9);
+		jive_amd64_encode_imm32(&immediates[0], -5, 1, target);
+	}
+}
+
+static void
+jive_amd64_encode_jump_conditional(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	bool need_long_form = jive_amd64_check_long_form(&immediates[0], flags, -2);
+
+	if (!need_long_form) {
+		target->putbyte(0x70 | icls->code());
+		jive_amd64_encode_imm8(&immediates[0], -2, 1, target);
+	} else {
+		target->putbyte(0x0f);
+		target->putbyte(0x80 | icls->code());
+		jive_amd64_encode_imm32(&immediates[0], -6, 2, target);
+	}
+}
+
+static void
+jive_amd64_encode_loadstoresse_disp(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	const jive::registers * r1 = inputs[0], * r2;
+	if (icls->code() == 0x11)
+		r2 = inputs[1];
+	else
+		r2 = outputs[0];
+
+	/* the REX prefix goes between the mandatory prefix and the opcode */
+	target->putbyte(0xF3);
+	size_t size = jive_amd64_encode_rex(target, false, r2->code(), r1->code());
+	target->putbyte(0x0F);
+	target->putbyte(icls->code());
+	jive_amd64_r2i(r1, r2, &immediates[0], size+3, flags, target);
+}
+
+static void
+jive_amd64_encode_regreg_sse(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	int r1 = inputs[0]->code();
+	int r2 = inputs[1]->code();
+
+	jive_amd64_encode_rex(target, false, r1, r2);
+	target->putbyte(0x0F);
+	target->putbyte(icls->code());
+	target->putbyte(0xc0|(r2 & 7)|((r1 & 7)<<3));
+}
+
+static void
+jive_amd64_encode_regreg_sse_prefixed(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	JIVE_DEBUG_ASSERT(inputs[0] == outputs[0]);
+
+	target->putbyte(0xF3);
+	jive_amd64_encode_regreg_sse(icls, target, inputs, outputs, immediates, flags);
+}
+
+static void
+jive_amd64_encode_regmove_sse(
+	const jive::instruction * icls,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	target->putbyte(0xF3);
+	jive_amd64_encode_regreg_sse(icls, target, outputs, inputs, immediates, flags);
+}
+
+static void
+get_slot_memory_reference(const jive::resource_class * rescls,
+	jive::immediate * displacement, jive::output ** base,
+	jive::output * sp, jive::output * fp)
+{
+	if (rescls->is_resource(&callslot_resource)) {
+		*displacement = jive::immediate(0, jive::spoffset_label::get());
+		*base = sp;
+	} else {
+		*displacement = jive::immediate(0, jive::fpoffset_label::get());
+		*base = fp;
+	}
+}
+
+namespace jive {
+namespace amd64 {
+
+#define DEFINE_AMD64_INSTRUCTION(NAME, CODE, MNEMONIC, \
+	INPUTS, OUTPUTS, NIMMEDIATES, FLAGS, INVERSE_JUMP, \
+	ENCODE, WRITE_ASM) \
+const instr_##NAME instr_##NAME::instance_; \
+ \
+instr_##NAME::instr_##NAME() \
+	: instruction(#NAME, CODE, MNEMONIC, \
+		INPUTS, OUTPUTS, NIMMEDIATES, \
+		FLAGS, INVERSE_JUMP) \
+	{} \
+\
+void \
+instr_##NAME::encode( \
+	jive::section * target, \
+	const jive::registers * inputs[], \
+	const jive::registers * outputs[], \
+	const jive_codegen_imm immediates[], \
+	jive_instruction_encoding_flags * flags) const \
+{ \
+	ENCODE(this, target, inputs, outputs, immediates, flags); \
+} \
+ \
+void \
+instr_##NAME::write_asm( \
+	jive::buffer * target, \
+	const jive::registers * inputs[], \
+	const jive::registers * outputs[], \
+	const jive_asmgen_imm immediates[], \
+	jive_instruction_encoding_flags * flags) const \
+{ \
+	WRITE_ASM(this, target, inputs, outputs, immediates, flags); \
+} \
+ \
+std::unique_ptr<jive::instruction> \
+instr_##NAME::copy() const \
+{ \
+	return std::make_unique<jive::amd64::instr_##NAME>(); \
+} \
+
+#define COMMA ,
+
+DEFINE_AMD64_INSTRUCTION(
+	ret, 0xC3, "ret", {}, {}, 0,
+	instruction::flags::jump, nullptr, jive_amd64_encode_simple, jive_amd64_asm_simple)
+
+/* integer load, store, and move instructions */
+DEFINE_AMD64_INSTRUCTION(
+	int_load_imm, 0xC7, "movq", {}, {&gpr_regcls}, 1,
+	instruction::flags::none, nullptr, jive_amd64_encode_int_load_imm, jive_amd64_asm_int_load_imm)
+DEFINE_AMD64_INSTRUCTION(
+	int_load64_disp, 0x8B, "movq", {&gpr_regcls}, {&gpr_regcls}, 1,
+	instruction::flags::none, nullptr, jive_amd64_encode_loadstore64_disp, jive_amd64_asm_load_disp)
+DEFINE_AMD64_INSTRUCTION(
+	int_store64_disp, 0x89, "movq", {&gpr_regcls COMMA &gpr_regcls}, {}, 1,
+	instruction::flags::none, nullptr, jive_amd64_encode_loadstore64_disp, jive_amd64_asm_store)
+DEFINE_AMD64_INSTRUCTION(
+	int_transfer, 0x89, "movq", {&gpr_regcls}, {&gpr_regcls}, 0,
+	instruction::flags::none, nullptr, jive_amd64_encode_regmove, jive_amd64_asm_regmove)
+
+/* integer arithmetic register register instructions */
+DEFINE_AMD64_INSTRUCTION(
+	int_add, 0x01, "addq",
+	{&gpr_regcls COMMA &gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	instruction::flags::write_input | instruction::flags::commutative, nullptr,
+	jive_amd64_encode_regreg, jive_amd64_asm_regreg)
+DEFINE_AMD64_INSTRUCTION(
+	int_sub, 0x29, "subq",
+	{&gpr_regcls COMMA &gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	instruction::flags::write_input, nullptr, jive_amd64_encode_regreg, jive_amd64_asm_regreg)
+DEFINE_AMD64_INSTRUCTION(
+	int_and, 0x21, "andq",
+	{&gpr_regcls COMMA &gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	instruction::flags::write_input | instruction::flags::commutative, nullptr,
+	jive_amd64_encode_regreg, jive_amd64_asm_regreg)
+DEFINE_AMD64_INSTRUCTION(
+	int_or, 0x09, "orq",
+	{&gpr_regcls COMMA &gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	instruction::flags::write_input | instruction::flags::commutative, nullptr,
+	jive_amd64_encode_regreg, jive_amd64_asm_regreg)
+DEFINE_AMD64_INSTRUCTION(
+	int_xor, 0x31, "xorq",
+	{&gpr_regcls COMMA &gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	instruction::flags::write_input | instruction::flags::commutative, nullptr,
+	jive_amd64_encode_regreg, jive_amd64_asm_regreg)
+DEFINE_AMD64_INSTRUCTION(
+	int_mul, 0xAF0F, "imulq",
+	{&gpr_regcls COMMA &gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	instruction::flags::write_input | instruction::flags::commutative, nullptr,
+	jive_amd64_encode_mul_regreg, jive_amd64_asm_regreg)
+DEFINE_AMD64_INSTRUCTION(
+	int_mul_expand_signed, 0xE8, "imulq",
+	{&rax_regcls COMMA &gpr_regcls}, {&rdx_regcls COMMA &rax_regcls COMMA &cc_regcls}, 0,
+	instruction::flags::commutative, nullptr,
+	jive_amd64_encode_mul_expand_reg, jive_amd64_asm_mul_expand_reg)
+DEFINE_AMD64_INSTRUCTION(
+	int_mul_expand_unsigned, 0xE0, "mulq",
+	{&rax_regcls COMMA &gpr_regcls}, {&rdx_regcls COMMA &rax_regcls COMMA &cc_regcls}, 0,
+	instruction::flags::commutative, nullptr,
+	jive_amd64_encode_mul_expand_reg, jive_amd64_asm_mul_expand_reg)
+DEFINE_AMD64_INSTRUCTION(
+	int_sdiv, 0xF8, "idivq",
+	{&rdx_regcls COMMA &rax_regcls COMMA &gpr_regcls},
+	{&rdx_regcls COMMA &rax_regcls COMMA &cc_regcls}, 0,
+	instruction::flags::none, nullptr, jive_amd64_encode_div_reg, jive_amd64_asm_div_reg)
+DEFINE_AMD64_INSTRUCTION(
+	int_udiv, 0xF0, "divq",
+	{&rdx_regcls COMMA &rax_regcls COMMA &gpr_regcls},
+	{&rdx_regcls COMMA &rax_regcls COMMA &cc_regcls}, 0,
+	instruction::flags::none, nullptr, jive_amd64_encode_div_reg, jive_amd64_asm_div_reg)
+DEFINE_AMD64_INSTRUCTION(
+	int_neg, 0xD8, "negq",
+	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	instruction::flags::write_input, nullptr, jive_amd64_encode_unaryreg, jive_amd64_asm_unaryreg)
+DEFINE_AMD64_INSTRUCTION(
+	int_not, 0xD0, "notq",
+	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	instruction::flags::write_input, nullptr, jive_amd64_encode_unaryreg, jive_amd64_asm_unaryreg)
+DEFINE_AMD64_INSTRUCTION(
+	int_shr, 0xE8, "shrq",
+	{&gpr_regcls COMMA &rcx_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	instruction::flags::write_input, nullptr,
+	jive_amd64_encode_shift_regreg, jive_amd64_asm_shift_regreg)
+DEFINE_AMD64_INSTRUCTION(
+	int_shl, 0xE0, "shlq",
+	{&gpr_regcls COMMA &rcx_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	instruction::flags::write_input, nullptr,
+	jive_amd64_encode_shift_regreg, jive_amd64_asm_shift_regreg)
+DEFINE_AMD64_INSTRUCTION(
+	int_ashr, 0xF8, "sarq",
+	{&gpr_regcls COMMA &rcx_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	instruction::flags::write_input, nullptr,
+	jive_amd64_encode_shift_regreg, jive_amd64_asm_shift_regreg)
+
+/* integer arithmetic register immediate instructions */
+/*
+	for the immediate instructions, code is the ModRM byte carrying the
+	opcode extension, the register is filled in during encoding
+*/
+DEFINE_AMD64_INSTRUCTION(
+	int_add_immediate, 0xC0, "addq",
+	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
+	instruction::flags::write_input, nullptr, jive_amd64_encode_regimm, jive_amd64_asm_regimm)
+DEFINE_AMD64_INSTRUCTION(
+	int_sub_immediate, 0xE8, "subq",
+	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
+	instruction::flags::write_input, nullptr, jive_amd64_encode_regimm, jive_amd64_asm_regimm)
+DEFINE_AMD64_INSTRUCTION(
+	int_and_immediate, 0xE0, "andq",
+	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
+	instruction::flags::write_input, nullptr, jive_amd64_encode_regimm, jive_amd64_asm_regimm)
+DEFINE_AMD64_INSTRUCTION(
+	int_or_immediate, 0xC8, "orq",
+	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
+	instruction::flags::write_input, nullptr, jive_amd64_encode_regimm, jive_amd64_asm_regimm)
+DEFINE_AMD64_INSTRUCTION(
+	int_xor_immediate, 0xF0, "xorq",
+	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
+	instruction::flags::write_input, nullptr, jive_amd64_encode_regimm, jive_amd64_asm_regimm)
+DEFINE_AMD64_INSTRUCTION(
+	int_mul_immediate, 0x69, "imulq",
+	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
+	instruction::flags::none, nullptr, jive_amd64_encode_mul_regimm, jive_amd64_asm_mul_regimm)
+DEFINE_AMD64_INSTRUCTION(
+	int_shr_immediate, 0xE8, "shrq",
+	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
+	instruction::flags::write_input, nullptr, jive_amd64_encode_shift_regimm, jive_amd64_asm_regimm)
+DEFINE_AMD64_INSTRUCTION(
+	int_shl_immediate, 0xE0, "shlq",
+	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
+	instruction::flags::write_input, nullptr, jive_amd64_encode_shift_regimm, jive_amd64_asm_regimm)
+DEFINE_AMD64_INSTRUCTION(
+	int_ashr_immediate, 0xF8, "sarq",
+	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
+	instruction::flags::write_input, nullptr, jive_amd64_encode_shift_regimm, jive_amd64_asm_regimm)
+
+/* call instructions */
+DEFINE_AMD64_INSTRUCTION(
+	call, 0xE8, "call", {}, {}, 1,
+	instruction::flags::none, nullptr, jive_amd64_encode_call, jive_amd64_asm_call)
+DEFINE_AMD64_INSTRUCTION(
+	call_reg, 0xFF, "call_reg", {&gpr_regcls}, {}, 0,
+	instruction::flags::none, nullptr, jive_amd64_encode_call_reg, jive_amd64_asm_call_reg)
+
+/* integer compare instructions */
+DEFINE_AMD64_INSTRUCTION(
+	int_cmp, 0x39, "cmpq",
+	{&gpr_regcls COMMA &gpr_regcls}, {&cc_regcls}, 0,
+	instruction::flags::none, nullptr, jive_amd64_encode_cmp_regreg, jive_amd64_asm_regreg)
+DEFINE_AMD64_INSTRUCTION(
+	int_cmp_immediate, 0xF8, "cmpq",
+	{&gpr_regcls}, {&cc_regcls}, 1,
+	instruction::flags::none, nullptr, jive_amd64_encode_regimm_readonly, jive_amd64_asm_regimm)
+
+/* jump instructions */
+DEFINE_AMD64_INSTRUCTION(
+	int_jump_sless, 0xC, "jl", {&cc_regcls}, {}, 1,
+	instruction::flags::jump | instruction::flags::jump_relative
+	| instruction::flags::jump_conditional_invertible, &instr_int_jump_sgreatereq::instance(),
+	jive_amd64_encode_jump_conditional, jive_amd64_asm_jump)
+DEFINE_AMD64_INSTRUCTION(
+	int_jump_uless, 0x2, "jb", {&cc_regcls}, {}, 1,
+	instruction::flags::jump | instruction::flags::jump_relative
+	| instruction::flags::jump_conditional_invertible, &instr_int_jump_ugreatereq::instance(),
+	jive_amd64_encode_jump_conditional, jive_amd64_asm_jump)
+DEFINE_AMD64_INSTRUCTION(
+	int_jump_slesseq, 0xE, "jle", {&cc_regcls}, {}, 1,
+	instruction::flags::jump | instruction::flags::jump_relative
+	| instruction::flags::jump_conditional_invertible, &instr_int_jump_sgreater::instance(),
+	jive_amd64_encode_jump_conditional, jive_amd64_asm_jump)
+DEFINE_AMD64_INSTRUCTION(
+	int_jump_ulesseq, 0x6, "jbe", {&cc_regcls}, {}, 1,
+	instruction::flags::jump | instruction::flags::jump_relative
+	| instruction::flags::jump_conditional_invertible, &instr_int_jump_ugreater::instance(),
+	jive_amd64_encode_jump_conditional, jive_amd64_asm_jump)
+DEFINE_AMD64_INSTRUCTION(
+	int_jump_equal, 0x4, "je", {&cc_regcls}, {}, 1,
+	instruction::flags::jump | instruction::flags::jump_relative
+	| instruction::flags::jump_conditional_invertible, &instr_int_jump_notequal::instance(),
+	jive_amd64_encode_jump_conditional, jive_amd64_asm_jump)
+DEFINE_AMD64_INSTRUCTION(
+	int_jump_notequal, 0x5, "jne", {&cc_regcls}, {}, 1,
+	instruction::flags::jump | instruction::flags::jump_relative
+	| instruction::flags::jump_conditional_invertible, &instr_int_jump_equal::instance(),
+	jive_amd64_encode_jump_conditional, jive_amd64_asm_jump)
+DEFINE_AMD64_INSTRUCTION(
+	int_jump_sgreater, 0xF, "jg", {&cc_regcls}, {}, 1,
+	instruction::flags::jump | instruction::flags::jump_relative
+	| instruction::flags::jump_conditional_invertible, &instr_int_jump_slesseq::instance(),
+	jive_amd64_encode_jump_conditional, jive_amd64_asm_jump)
+DEFINE_AMD64_INSTRUCTION(
+	int_jump_ugreater, 0x7, "ja", {&cc_regcls}, {}, 1,
+	instruction::flags::jump | instruction::flags::jump_relative
+	| instruction::flags::jump_conditional_invertible, &instr_int_jump_ulesseq::instance(),
+	jive_amd64_encode_jump_conditional, jive_amd64_asm_jump)
+DEFINE_AMD64_INSTRUCTION(
+	int_jump_sgreatereq, 0xD, "jge", {&cc_regcls}, {}, 1,
+	instruction::flags::jump | instruction::flags::jump_relative
+	| instruction::flags::jump_conditional_invertible, &instr_int_jump_sless::instance(),
+	jive_amd64_encode_jump_conditional, jive_amd64_asm_jump)
+DEFINE_AMD64_INSTRUCTION(
+	int_jump_ugreatereq, 0x3, "jae", {&cc_regcls}, {}, 1,
+	instruction::flags::jump | instruction::flags::jump_relative
+	| instruction::flags::jump_conditional_invertible, &instr_int_jump_uless::instance(),
+	jive_amd64_encode_jump_conditional, jive_amd64_asm_jump)
+DEFINE_AMD64_INSTRUCTION(
+	jump, 0xEB, "jmp", {}, {}, 1,
+	instruction::flags::jump_relative, nullptr, jive_amd64_encode_jump, jive_amd64_asm_jump)
+
+/* floating-point instructions */
+DEFINE_AMD64_INSTRUCTION(
+	sse_load32_disp, 0x10, "movss", {&gpr_regcls}, {&xmm_regcls}, 1,
+	instruction::flags::none, nullptr, jive_amd64_encode_loadstoresse_disp, jive_amd64_asm_load_disp)
+DEFINE_AMD64_INSTRUCTION(
+	sse_store32_disp, 0x11, "movss", {&gpr_regcls COMMA &xmm_regcls}, {}, 1,
+	instruction::flags::none, nullptr, jive_amd64_encode_loadstoresse_disp, jive_amd64_asm_store)
+DEFINE_AMD64_INSTRUCTION(
+	sse_xor, 0x57, "xorps", {&xmm_regcls COMMA &xmm_regcls}, {&xmm_regcls}, 0,
+	instruction::flags::write_input | instruction::flags::commutative, nullptr,
+	jive_amd64_encode_regreg_sse, jive_amd64_asm_regreg)
+DEFINE_AMD64_INSTRUCTION(
+	float_add, 0x58, "addss", {&xmm_regcls COMMA &xmm_regcls}, {&xmm_regcls}, 0,
+	instruction::flags::write_input | instruction::flags::commutative, nullptr,
+	jive_amd64_encode_regreg_sse_prefixed, jive_amd64_asm_regreg)
+DEFINE_AMD64_INSTRUCTION(
+	float_sub, 0x5C, "subss", {&xmm_regcls COMMA &xmm_regcls}, {&xmm_regcls}, 0,
+	instruction::flags::write_input, nullptr,
+	jive_amd64_encode_regreg_sse_prefixed, jive_amd64_asm_regreg)
+DEFINE_AMD64_INSTRUCTION(
+	float_mul, 0x59, "mulss", {&xmm_regcls COMMA &xmm_regcls}, {&xmm_regcls}, 0,
+	instruction::flags::write_input | instruction::flags::commutative, nullptr,
+	jive_amd64_encode_regreg_sse_prefixed, jive_amd64_asm_regreg)
+DEFINE_AMD64_INSTRUCTION(
+	float_div, 0x5E, "divss", {&xmm_regcls COMMA &xmm_regcls}, {&xmm_regcls}, 0,
+	instruction::flags::write_input, nullptr,
+	jive_amd64_encode_regreg_sse_prefixed, jive_amd64_asm_regreg)
+DEFINE_AMD64_INSTRUCTION(
+	float_cmp, 0x2E, "ucomiss", {&xmm_regcls COMMA &xmm_regcls}, {&cc_regcls}, 0,
+	instruction::flags::none, nullptr, jive_amd64_encode_regreg_sse, jive_amd64_asm_regreg)
+DEFINE_AMD64_INSTRUCTION(
+	float_transfer, 0x10, "movss", {&xmm_regcls}, {&xmm_regcls}, 0,
+	instruction::flags::none, nullptr, jive_amd64_encode_regmove_sse, jive_amd64_asm_regmove)
+
+/* instructionset */
+
+instructionset::~instructionset()
+{}
+
+const jive::instruction *
+instructionset::jump_instruction() const noexcept
+{
+	return &jive::amd64::instr_jump::instance();
+}
+
+const jive::register_classifier *
+instructionset::classifier() const noexcept
+{
+	return register_classifier::get();
+}
+
+jive::xfer_description
+instructionset::create_xfer(
+	jive::region * region,
+	jive::output * origin,
+	const jive::resource_class * in_class,
+	const jive::resource_class * out_class) const
+{
+	/* stack and frame pointer are only needed for transfers through memory */
+	if (!in_class->is_resource(&jive::register_resource)) {
+		auto sub = jive_region_get_subroutine_node(region);
+		jive::output * base;
+		jive::immediate displacement;
+		get_slot_memory_reference(in_class, &displacement, &base,
+			jive_subroutine_node_get_sp(sub), jive_subroutine_node_get_fp(sub));
+		auto imm = immediate_op::create(region, displacement);
+		auto node = jive::create_instruction(region, &jive::amd64::instr_int_load64_disp::instance(),
+			{base, imm, origin}, {in_class}, {});
+		return jive::xfer_description(node->input(2), node, node->output(0));
+	}
+
+	if (!out_class->is_resource(&jive::register_resource)) {
+		auto sub = jive_region_get_subroutine_node(region);
+		jive::output * base;
+		jive::immediate displacement;
+		get_slot_memory_reference(out_class, &displacement, &base,
+			jive_subroutine_node_get_sp(sub), jive_subroutine_node_get_fp(sub));
+		auto imm = immediate_op::create(region, displacement);
+		auto node = jive::create_instruction(region, &jive::amd64::instr_int_store64_disp::instance(),
+			{base, origin, imm}, {}, {out_class});
+		return jive::xfer_description(node->input(1), node, node->output(0));
+	}
+
+	if (jive::relax(in_class) == &xmm_regcls) {
+		auto node = jive::create_instruction(region, &jive::amd64::instr_float_transfer::instance(),
+			{origin});
+		return jive::xfer_description(node->input(0), node, node->output(0));
+	}
+
+	auto node = jive::create_instruction(region, &jive::amd64::instr_int_transfer::instance(),
+		{origin});
+	return jive::xfer_description(node->input(0), node, node->output(0));
+}
+
+}}
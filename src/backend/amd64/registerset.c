@@ -0,0 +1,121 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jive/backend/amd64/registerset.h>
+
+#include <jive/arch/registers.h>
+#include <jive/arch/stackslot.h>
+#include <jive/types/bitstring/type.h>
+#include <jive/types/float/flttype.h>
+
+namespace jive {
+namespace amd64 {
+
+/* register codes correspond to the hardware encoding, bit 3 goes into the REX prefix */
+
+const jive::registers cc("cc", &cc_regcls, 0);
+const jive::registers rax("rax", &rax_regcls, 0);
+const jive::registers rcx("rcx", &rcx_regcls, 1);
+const jive::registers rdx("rdx", &rdx_regcls, 2);
+const jive::registers rbx("rbx", &rbx_regcls, 3);
+const jive::registers rsp("rsp", &rsp_regcls, 4);
+const jive::registers rbp("rbp", &rbp_regcls, 5);
+const jive::registers rsi("rsi", &rsi_regcls, 6);
+const jive::registers rdi("rdi", &rdi_regcls, 7);
+const jive::registers r8("r8", &r8_regcls, 8);
+const jive::registers r9("r9", &r9_regcls, 9);
+const jive::registers r10("r10", &r10_regcls, 10);
+const jive::registers r11("r11", &r11_regcls, 11);
+const jive::registers r12("r12", &r12_regcls, 12);
+const jive::registers r13("r13", &r13_regcls, 13);
+const jive::registers r14("r14", &r14_regcls, 14);
+const jive::registers r15("r15", &r15_regcls, 15);
+
+const jive::registers xmm0("xmm0", &xmm0_regcls, 0);
+const jive::registers xmm1("xmm1", &xmm1_regcls, 1);
+const jive::registers xmm2("xmm2", &xmm2_regcls, 2);
+const jive::registers xmm3("xmm3", &xmm3_regcls, 3);
+const jive::registers xmm4("xmm4", &xmm4_regcls, 4);
+const jive::registers xmm5("xmm5", &xmm5_regcls, 5);
+const jive::registers xmm6("xmm6", &xmm6_regcls, 6);
+const jive::registers xmm7("xmm7", &xmm7_regcls, 7);
+const jive::registers xmm8("xmm8", &xmm8_regcls, 8);
+const jive::registers xmm9("xmm9", &xmm9_regcls, 9);
+const jive::registers xmm10("xmm10", &xmm10_regcls, 10);
+const jive::registers xmm11("xmm11", &xmm11_regcls, 11);
+const jive::registers xmm12("xmm12", &xmm12_regcls, 12);
+const jive::registers xmm13("xmm13", &xmm13_regcls, 13);
+const jive::registers xmm14("xmm14", &xmm14_regcls, 14);
+const jive::registers xmm15("xmm15", &xmm15_regcls, 15);
+
+#define CLS(x) &x##_regcls
+#define STACK8 &jive_stackslot_class_8_8
+
+static const jive::bittype bits16(16);
+static const jive::bittype bits64(64);
+static const jive::flt::type flt;
+
+const jive::register_class cc_regcls(
+	"cc", {&cc}, &jive_root_register_class, resource_class::priority::reg_high,
+	{{CLS(rax), {CLS(cc), CLS(rax)}}, {STACK8, {CLS(cc), CLS(rax), STACK8}}},
+	&bits16, 16, 0, 0);
+
+/* caller-saved registers first, such that they are preferred by the allocator */
+const jive::register_class gpr_regcls(
+	"gpr", {&rax, &rcx, &rdx, &rsi, &rdi, &r8, &r9, &r10, &r11,
+		&rbx, &r12, &r13, &r14, &r15, &rbp, &rsp},
+	&jive_root_register_class, resource_class::priority::reg_low,
+	{{STACK8, {CLS(gpr), STACK8}}}, &bits64, 64, 64, 8|16|32|64);
+
+#define DEFINE_GPR_CLASS(NAME) \
+const jive::register_class NAME##_regcls( \
+	#NAME, {&NAME}, &gpr_regcls, resource_class::priority::reg_low, \
+	{{CLS(gpr), {CLS(gpr), CLS(gpr)}}, {STACK8, {CLS(gpr), STACK8}}}, \
+	&bits64, 64, 64, 8|16|32|64);
+
+DEFINE_GPR_CLASS(rax)
+DEFINE_GPR_CLASS(rcx)
+DEFINE_GPR_CLASS(rdx)
+DEFINE_GPR_CLASS(rbx)
+DEFINE_GPR_CLASS(rsp)
+DEFINE_GPR_CLASS(rbp)
+DEFINE_GPR_CLASS(rsi)
+DEFINE_GPR_CLASS(rdi)
+DEFINE_GPR_CLASS(r8)
+DEFINE_GPR_CLASS(r9)
+DEFINE_GPR_CLASS(r10)
+DEFINE_GPR_CLASS(r11)
+DEFINE_GPR_CLASS(r12)
+DEFINE_GPR_CLASS(r13)
+DEFINE_GPR_CLASS(r14)
+DEFINE_GPR_CLASS(r15)
+
+const jive::register_class xmm_regcls(
+	"xmm", {&xmm0, &xmm1, &xmm2, &xmm3, &xmm4, &xmm5, &xmm6, &xmm7,
+		&xmm8, &xmm9, &xmm10, &xmm11, &xmm12, &xmm13, &xmm14, &xmm15},
+	&jive_root_register_class, resource_class::priority::reg_low, {}, &flt, 32, 128, 128);
+
+#define DEFINE_XMM_CLASS(NAME) \
+const jive::register_class NAME##_regcls( \
+	#NAME, {&NAME}, &xmm_regcls, resource_class::priority::reg_low, {}, &flt, 32, 128, 128);
+
+DEFINE_XMM_CLASS(xmm0)
+DEFINE_XMM_CLASS(xmm1)
+DEFINE_XMM_CLASS(xmm2)
+DEFINE_XMM_CLASS(xmm3)
+DEFINE_XMM_CLASS(xmm4)
+DEFINE_XMM_CLASS(xmm5)
+DEFINE_XMM_CLASS(xmm6)
+DEFINE_XMM_CLASS(xmm7)
+DEFINE_XMM_CLASS(xmm8)
+DEFINE_XMM_CLASS(xmm9)
+DEFINE_XMM_CLASS(xmm10)
+DEFINE_XMM_CLASS(xmm11)
+DEFINE_XMM_CLASS(xmm12)
+DEFINE_XMM_CLASS(xmm13)
+DEFINE_XMM_CLASS(xmm14)
+DEFINE_XMM_CLASS(xmm15)
+
+}}
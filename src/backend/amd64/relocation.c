@@ -0,0 +1,58 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jive/backend/amd64/relocation.h>
+
+#include <string.h>
+
+#include <type_traits>
+
+template<typename T> static inline bool
+relocate(void * where, size_t max_size, jive_offset value, bool is_signed)
+{
+	if (max_size < sizeof(T))
+		return false;
+
+	/* unaligned access, the data is embedded in the instruction stream */
+	typedef typename std::make_signed<T>::type S;
+	T loc;
+	memcpy(&loc, where, sizeof(T));
+	int64_t addend = is_signed ? int64_t(S(loc)) : int64_t(loc);
+	int64_t result = addend + int64_t(value);
+	loc = T(result);
+	memcpy(where, &loc, sizeof(T));
+
+	/* the truncated value must represent the full result */
+	if (is_signed)
+		return result == int64_t(S(loc));
+	return uint64_t(result) == uint64_t(loc) || sizeof(T) == sizeof(uint64_t);
+}
+
+bool
+jive_amd64_process_relocation(
+	void * where, size_t max_size, jive_offset offset,
+	jive_relocation_type type, jive_offset target, jive_offset value)
+{
+	target += value;
+	/* FIXME: should honor endianness */
+	switch (type.arch_code) {
+		case 1: /* JIVE_R_X86_64_64 */
+			return relocate<uint64_t>(where, max_size, target, false);
+		case 2: /* JIVE_R_X86_64_PC32 */
+			return relocate<uint32_t>(where, max_size, target - offset, true);
+		case 10: /* JIVE_R_X86_64_32 */
+			return relocate<uint32_t>(where, max_size, target, false);
+		case 11: /* JIVE_R_X86_64_32S */
+			return relocate<uint32_t>(where, max_size, target, true);
+		case 14: /* JIVE_R_X86_64_8 */
+			return relocate<uint8_t>(where, max_size, target, false);
+		case 15: /* JIVE_R_X86_64_PC8 */
+			return relocate<uint8_t>(where, max_size, target - offset, true);
+		case 24: /* JIVE_R_X86_64_PC64 */
+			return relocate<uint64_t>(where, max_size, target - offset, true);
+		default:
+			return false;
+	}
+}
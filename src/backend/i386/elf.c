@@ -0,0 +1,353 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jive/backend/i386/elf.h>
+
+#include <elf.h>
+#include <string.h>
+
+#include <unordered_map>
+
+struct elf_section {
+	Elf32_Shdr header;
+	const void * data;
+};
+
+static const char *
+section_name(jive_stdsectionid id)
+{
+	switch (id) {
+		case jive_stdsectionid_code: return ".text";
+		case jive_stdsectionid_data: return ".data";
+		case jive_stdsectionid_rodata: return ".rodata";
+		case jive_stdsectionid_bss: return ".bss";
+		default:
+			throw jive::compiler_error(jive::detail::strfmt("Unsupported section ", id, "."));
+	}
+}
+
+static Elf32_Word
+section_flags(jive_stdsectionid id)
+{
+	switch (id) {
+		case jive_stdsectionid_code: return SHF_ALLOC | SHF_EXECINSTR;
+		case jive_stdsectionid_rodata: return SHF_ALLOC;
+		default: return SHF_ALLOC | SHF_WRITE;
+	}
+}
+
+/* width of the data item patched by a relocation, follows relocation.h */
+static size_t
+relocation_size(const jive_relocation_type & type)
+{
+	switch (type.arch_code) {
+		case 1: case 2: return 4;
+		case 20: case 21: return 2;
+		case 22: case 23: return 1;
+		default:
+			throw jive::compiler_error(jive::detail::strfmt(
+				"Unsupported i386 relocation type ", type.arch_code, "."));
+	}
+}
+
+static Elf32_Word
+add_string(jive::buffer & strtab, const std::string & s)
+{
+	Elf32_Word offset = strtab.size();
+	strtab.push_back(s);
+	strtab.push_back(uint8_t(0));
+	return offset;
+}
+
+static Elf32_Sym
+make_symbol(Elf32_Word name, Elf32_Addr value, Elf32_Word size, unsigned char info, Elf32_Half shndx)
+{
+	Elf32_Sym symbol;
+	memset(&symbol, 0, sizeof(symbol));
+	symbol.st_name = name;
+	symbol.st_value = value;
+	symbol.st_size = size;
+	symbol.st_info = info;
+	symbol.st_shndx = shndx;
+	return symbol;
+}
+
+static elf_section
+make_section(
+	Elf32_Word name,
+	Elf32_Word type,
+	Elf32_Word flags,
+	const void * data,
+	size_t size,
+	Elf32_Word align,
+	Elf32_Word entsize = 0)
+{
+	elf_section section;
+	memset(&section.header, 0, sizeof(section.header));
+	section.header.sh_name = name;
+	section.header.sh_type = type;
+	section.header.sh_flags = flags;
+	section.header.sh_size = size;
+	section.header.sh_addralign = align;
+	section.header.sh_entsize = entsize;
+	section.data = data;
+	return section;
+}
+
+static inline void
+pad(jive::buffer & target, size_t base, size_t offset)
+{
+	while (target.size() - base < offset)
+		target.push_back(uint8_t(0));
+}
+
+/* the object is ELFDATA2LSB, all fields are written little endian independent of the host */
+template<typename T> static inline void
+put(jive::buffer & target, T value)
+{
+	for (size_t n = 0; n < sizeof(T); n++)
+		target.push_back(uint8_t(value >> (8*n)));
+}
+
+static void
+put(jive::buffer & target, const Elf32_Ehdr & ehdr)
+{
+	target.push_back(ehdr.e_ident, EI_NIDENT);
+	put(target, ehdr.e_type);
+	put(target, ehdr.e_machine);
+	put(target, ehdr.e_version);
+	put(target, ehdr.e_entry);
+	put(target, ehdr.e_phoff);
+	put(target, ehdr.e_shoff);
+	put(target, ehdr.e_flags);
+	put(target, ehdr.e_ehsize);
+	put(target, ehdr.e_phentsize);
+	put(target, ehdr.e_phnum);
+	put(target, ehdr.e_shentsize);
+	put(target, ehdr.e_shnum);
+	put(target, ehdr.e_shstrndx);
+}
+
+static void
+put(jive::buffer & target, const Elf32_Shdr & shdr)
+{
+	put(target, shdr.sh_name);
+	put(target, shdr.sh_type);
+	put(target, shdr.sh_flags);
+	put(target, shdr.sh_addr);
+	put(target, shdr.sh_offset);
+	put(target, shdr.sh_size);
+	put(target, shdr.sh_link);
+	put(target, shdr.sh_info);
+	put(target, shdr.sh_addralign);
+	put(target, shdr.sh_entsize);
+}
+
+static void
+put(jive::buffer & target, const Elf32_Sym & symbol)
+{
+	put(target, symbol.st_name);
+	put(target, symbol.st_value);
+	put(target, symbol.st_size);
+	put(target, symbol.st_info);
+	put(target, symbol.st_other);
+	put(target, symbol.st_shndx);
+}
+
+static void
+put(jive::buffer & target, const Elf32_Rel & rel)
+{
+	put(target, rel.r_offset);
+	put(target, rel.r_info);
+}
+
+template<typename T> static void
+put(jive::buffer & target, const std::vector<T> & entries)
+{
+	for (const auto & entry : entries)
+		put(target, entry);
+}
+
+namespace jive {
+namespace i386 {
+
+void
+write_elf(
+	const jive::compilate & compilate,
+	jive::label_name_mapper & mapper,
+	const std::vector<elf_symbol> & symbols,
+	jive::buffer & target)
+{
+	const auto & sections = compilate.sections();
+
+	/*
+		Section header and symbol table indices coincide for the compilate
+		sections: index n+1 holds section n and its section symbol.
+	*/
+	std::unordered_map<int, Elf32_Half> section_index;
+	for (size_t n = 0; n < sections.size(); n++)
+		section_index[sections[n]->id()] = n+1;
+
+	jive::buffer strtab;
+	strtab.push_back(uint8_t(0));
+	std::vector<Elf32_Sym> symtab(1, make_symbol(0, 0, 0, 0, SHN_UNDEF));
+	for (size_t n = 0; n < sections.size(); n++)
+		symtab.push_back(make_symbol(0, 0, 0, ELF32_ST_INFO(STB_LOCAL, STT_SECTION), n+1));
+	size_t nlocals = symtab.size();
+
+	for (const auto & symbol : symbols) {
+		auto it = section_index.find(symbol.section());
+		if (it == section_index.end())
+			throw jive::compiler_error("Symbol " + symbol.name() + " refers to missing section.");
+
+		auto type = symbol.section() == jive_stdsectionid_code ? STT_FUNC : STT_OBJECT;
+		symtab.push_back(make_symbol(add_string(strtab, symbol.name()), symbol.offset(),
+			symbol.size(), ELF32_ST_INFO(STB_GLOBAL, type), it->second));
+	}
+
+	/* translate relocations, folding their values into the section contents */
+	std::unordered_map<const jive_linker_symbol*, Elf32_Word> undefined;
+	std::vector<std::vector<uint8_t>> contents(sections.size());
+	std::vector<std::vector<Elf32_Rel>> relocations(sections.size());
+	for (size_t n = 0; n < sections.size(); n++) {
+		const auto & section = sections[n];
+		contents[n].assign(section->data(), section->data() + section->size());
+		if (section->id() == jive_stdsectionid_bss && !section->relocations().empty())
+			throw jive::compiler_error("Relocations in bss section.");
+
+		for (const auto & entry : section->relocations()) {
+			size_t size = relocation_size(entry.type());
+			if (entry.offset() + size > contents[n].size())
+				throw jive::compiler_error("Relocation exceeds section bounds.");
+
+			Elf32_Word symbol = 0;
+			auto target = entry.target();
+			if (target.type == jive_symref_type_section) {
+				auto it = section_index.find(target.ref.section);
+				if (it == section_index.end())
+					throw jive::compiler_error("Relocation refers to missing section.");
+				symbol = it->second;
+			} else if (target.type == jive_symref_type_linker_symbol) {
+				auto it = undefined.find(target.ref.linker_symbol);
+				if (it == undefined.end()) {
+					auto name = mapper.map_named_symbol(target.ref.linker_symbol);
+					if (!name)
+						throw jive::compiler_error("Unable to map linker symbol.");
+
+					symtab.push_back(make_symbol(add_string(strtab, name), 0, 0,
+						ELF32_ST_INFO(STB_GLOBAL, STT_NOTYPE), SHN_UNDEF));
+					it = undefined.insert({target.ref.linker_symbol, symtab.size()-1}).first;
+				}
+				symbol = it->second;
+			}
+
+			/* i386 uses implicit addends, stored little endian */
+			uint8_t * where = &contents[n][entry.offset()];
+			uint32_t addend = 0;
+			for (size_t b = 0; b < size; b++)
+				addend |= uint32_t(where[b]) << (8*b);
+			addend += entry.value();
+			for (size_t b = 0; b < size; b++)
+				where[b] = addend >> (8*b);
+
+			Elf32_Rel rel;
+			rel.r_offset = entry.offset();
+			rel.r_info = ELF32_R_INFO(symbol, entry.type().arch_code);
+			relocations[n].push_back(rel);
+		}
+	}
+
+	/* section headers */
+	size_t nrel = 0;
+	for (const auto & rels : relocations)
+		nrel += !rels.empty();
+	Elf32_Half symtab_index = 1 + sections.size() + nrel;
+
+	std::vector<jive::buffer> reltabs(sections.size());
+	for (size_t n = 0; n < sections.size(); n++)
+		put(reltabs[n], relocations[n]);
+
+	jive::buffer shstrtab;
+	shstrtab.push_back(uint8_t(0));
+	std::vector<elf_section> elf_sections(1, make_section(0, SHT_NULL, 0, nullptr, 0, 0));
+	for (size_t n = 0; n < sections.size(); n++) {
+		auto id = sections[n]->id();
+		auto type = id == jive_stdsectionid_bss ? SHT_NOBITS : SHT_PROGBITS;
+		auto align = id == jive_stdsectionid_code ? 16 : 4;
+		elf_sections.push_back(make_section(add_string(shstrtab, section_name(id)), type,
+			section_flags(id), contents[n].data(), contents[n].size(), align));
+	}
+
+	for (size_t n = 0; n < sections.size(); n++) {
+		if (relocations[n].empty())
+			continue;
+
+		auto name = add_string(shstrtab, std::string(".rel") + section_name(sections[n]->id()));
+		auto section = make_section(name, SHT_REL, 0, reltabs[n].data(),
+			reltabs[n].size(), 4, sizeof(Elf32_Rel));
+		section.header.sh_link = symtab_index;
+		section.header.sh_info = n+1;
+		elf_sections.push_back(section);
+	}
+
+	jive::buffer symbytes;
+	put(symbytes, symtab);
+	auto symtab_section = make_section(add_string(shstrtab, ".symtab"), SHT_SYMTAB, 0,
+		symbytes.data(), symbytes.size(), 4, sizeof(Elf32_Sym));
+	symtab_section.header.sh_link = symtab_index + 1;
+	symtab_section.header.sh_info = nlocals;
+	elf_sections.push_back(symtab_section);
+
+	elf_sections.push_back(make_section(add_string(shstrtab, ".strtab"), SHT_STRTAB, 0,
+		strtab.data(), strtab.size(), 1));
+	auto shstrtab_name = add_string(shstrtab, ".shstrtab");
+	elf_sections.push_back(make_section(shstrtab_name, SHT_STRTAB, 0,
+		shstrtab.data(), shstrtab.size(), 1));
+
+	/* layout */
+	size_t offset = sizeof(Elf32_Ehdr);
+	for (size_t n = 1; n < elf_sections.size(); n++) {
+		auto & header = elf_sections[n].header;
+		offset = (offset + header.sh_addralign - 1) / header.sh_addralign * header.sh_addralign;
+		header.sh_offset = offset;
+		if (header.sh_type != SHT_NOBITS)
+			offset += header.sh_size;
+	}
+	offset = (offset + 3) & ~3;
+
+	Elf32_Ehdr ehdr;
+	memset(&ehdr, 0, sizeof(ehdr));
+	memcpy(ehdr.e_ident, ELFMAG, SELFMAG);
+	ehdr.e_ident[EI_CLASS] = ELFCLASS32;
+	ehdr.e_ident[EI_DATA] = ELFDATA2LSB;
+	ehdr.e_ident[EI_VERSION] = EV_CURRENT;
+	ehdr.e_ident[EI_OSABI] = ELFOSABI_SYSV;
+	ehdr.e_type = ET_REL;
+	ehdr.e_machine = EM_386;
+	ehdr.e_version = EV_CURRENT;
+	ehdr.e_shoff = offset;
+	ehdr.e_ehsize = sizeof(Elf32_Ehdr);
+	ehdr.e_shentsize = sizeof(Elf32_Shdr);
+	ehdr.e_shnum = elf_sections.size();
+	ehdr.e_shstrndx = elf_sections.size()-1;
+
+	size_t base = target.size();
+	put(target, ehdr);
+	for (size_t n = 1; n < elf_sections.size(); n++) {
+		const auto & section = elf_sections[n];
+		if (section.header.sh_type == SHT_NOBITS)
+			continue;
+
+		pad(target, base, section.header.sh_offset);
+		target.push_back(section.data, section.header.sh_size);
+	}
+
+	pad(target, base, ehdr.e_shoff);
+	for (const auto & section : elf_sections)
+		put(target, section.header);
+}
+
+}
+}
@@ -18,6 +18,8 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include <unordered_map>
+
 static inline uint32_t
 cpu_to_le32(uint32_t value)
 {
@@ -169,14 +171,14 @@ putdisp(
 
 static void
 jive_i386_encode_simple(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
 	const jive_codegen_imm immediates[],
 	jive_instruction_encoding_flags * flags)
 {
-	target->putbyte(icls->code());
+	target->putbyte(desc.code);
 }
 
 static void
@@ -193,7 +195,7 @@ jive_i386_asm_simple(
 
 static void
 jive_i386_encode_int_load_imm(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -201,7 +203,7 @@ jive_i386_encode_int_load_imm(
 	jive_instruction_encoding_flags * flags)
 {
 	int reg = outputs[0]->code();
-	target->putbyte(icls->code()|reg);
+	target->putbyte(desc.code|reg);
 	jive_i386_encode_imm32(&immediates[0], 0, 1, target);
 }
 
@@ -267,7 +269,7 @@ jive_i386_r2i(
 
 static void
 jive_i386_encode_loadstore32_disp(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -275,12 +277,12 @@ jive_i386_encode_loadstore32_disp(
 	jive_instruction_encoding_flags * flags)
 {
 	const jive::registers * r1 = inputs[0], * r2;
-	if (icls->code() == 0x89)
+	if (desc.code == 0x89)
 		r2 = inputs[1];
 	else
 		r2 = outputs[0];
 	
-	target->putbyte(icls->code());
+	target->putbyte(desc.code);
 	jive_i386_r2i(r1, r2, &immediates[0], 1, flags, target);
 }
 
@@ -334,7 +336,7 @@ jive_i386_asm_store(
 
 static void
 jive_i386_encode_regreg(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -346,7 +348,7 @@ jive_i386_encode_regreg(
 	int r1 = inputs[0]->code();
 	int r2 = inputs[1]->code();
 	
-	target->putbyte(icls->code());
+	target->putbyte(desc.code);
 	target->putbyte(0xc0|r1|(r2<<3));
 }
 
@@ -368,7 +370,7 @@ jive_i386_asm_regreg(
 
 static void
 jive_i386_encode_cmp_regreg(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -378,13 +380,13 @@ jive_i386_encode_cmp_regreg(
 	int r1 = inputs[1]->code();
 	int r2 = inputs[0]->code();
 	
-	target->putbyte(icls->code());
+	target->putbyte(desc.code);
 	target->putbyte(0xc0|r1|(r2<<3));
 }
 
 static void
 jive_i386_encode_cmp_regreg_sse(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -392,7 +394,7 @@ jive_i386_encode_cmp_regreg_sse(
 	jive_instruction_encoding_flags * flags)
 {
 	target->putbyte(0x0F);
-	jive_i386_encode_cmp_regreg(icls, target, inputs, outputs, immediates, flags);
+	jive_i386_encode_cmp_regreg(desc, target, inputs, outputs, immediates, flags);
 }
 
 static void
@@ -414,7 +416,7 @@ jive_i386_asm_imul(
 
 static void
 jive_i386_encode_imull(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -424,7 +426,7 @@ jive_i386_encode_imull(
 	auto r1 = inputs[0]->code();
 	auto r2 = inputs[1]->code();
 
-	target->putbyte(icls->code());
+	target->putbyte(desc.code);
 
 	JIVE_DEBUG_ASSERT(r1 == outputs[1]->code());
 	target->putbyte(0xe8|r2);
@@ -432,7 +434,7 @@ jive_i386_encode_imull(
 
 static void
 jive_i386_encode_mul_regreg(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -465,7 +467,7 @@ jive_i386_asm_mul(
 
 static void
 jive_i386_encode_mull(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -477,7 +479,7 @@ jive_i386_encode_mull(
 
 	JIVE_DEBUG_ASSERT(r1 == outputs[1]->code());
 
-	target->putbyte(icls->code());
+	target->putbyte(desc.code);
 	target->putbyte(0xe0|r2);
 }
 
@@ -497,7 +499,7 @@ jive_i386_asm_div_reg(
 
 static void
 jive_i386_encode_div_reg(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -507,12 +509,12 @@ jive_i386_encode_div_reg(
 	int r = inputs[2]->code();
 
 	target->putbyte(0xf7);
-	target->putbyte(icls->code() | r);
+	target->putbyte(desc.code | r);
 }
 
 static void
 jive_i386_encode_shift_regimm(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -529,10 +531,10 @@ jive_i386_encode_shift_regimm(
 	
 	if (code_constant_one) {
 		target->putbyte(0xd1);
-		target->putbyte(icls->code() | r1);
+		target->putbyte(desc.code | r1);
 	} else {
 		target->putbyte(0xc1);
-		target->putbyte(icls->code() | r1);
+		target->putbyte(desc.code | r1);
 		jive_i386_encode_imm8(&immediates[0], 0, 2, target);
 	}
 }
@@ -553,7 +555,7 @@ jive_i386_asm_shift_regreg(
 
 static void
 jive_i386_encode_shift_regreg(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -564,12 +566,12 @@ jive_i386_encode_shift_regreg(
 	JIVE_DEBUG_ASSERT(r1 == outputs[0]->code());
 	
 	target->putbyte(0xd3);
-	target->putbyte(icls->code() | r1);
+	target->putbyte(desc.code | r1);
 }
 
 static void
 jive_i386_encode_regimm_readonly(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -584,11 +586,11 @@ jive_i386_encode_regimm_readonly(
 	char prefix = need_long_form ? 0x81 : 0x83;
 	
 	if (r1 == 0 && need_long_form) {
-		char opcode = icls->code() >> 8;
+		char opcode = desc.code >> 8;
 		target->putbyte(opcode);
 		coded_size_so_far ++;
 	} else {
-		char opcode = icls->code() & 255;
+		char opcode = desc.code & 255;
 		target->putbyte(prefix);
 		target->putbyte(opcode | r1);
 		coded_size_so_far += 2;
@@ -602,7 +604,7 @@ jive_i386_encode_regimm_readonly(
 
 static void
 jive_i386_encode_regimm(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -610,7 +612,7 @@ jive_i386_encode_regimm(
 	jive_instruction_encoding_flags * flags)
 {
 	JIVE_DEBUG_ASSERT(inputs[0] == outputs[0]);
-	jive_i386_encode_regimm_readonly(icls, target, inputs, outputs, immediates, flags);
+	jive_i386_encode_regimm_readonly(desc, target, inputs, outputs, immediates, flags);
 }
 
 static void
@@ -631,7 +633,7 @@ jive_i386_asm_regimm(
 
 static void
 jive_i386_encode_mul_regimm(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -676,7 +678,7 @@ jive_i386_asm_mul_regimm(
 
 static void
 jive_i386_encode_unaryreg(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -688,7 +690,7 @@ jive_i386_encode_unaryreg(
 	JIVE_DEBUG_ASSERT(r1 == outputs[0]->code());
 	
 	target->putbyte(0xf7);
-	target->putbyte(icls->code()|r1);
+	target->putbyte(desc.code|r1);
 }
 
 static void
@@ -707,7 +709,7 @@ jive_i386_asm_unaryreg(
 
 static void
 jive_i386_encode_regmove(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -717,13 +719,13 @@ jive_i386_encode_regmove(
 	int r1 = outputs[0]->code();
 	int r2 = inputs[0]->code();
 	
-	target->putbyte(icls->code());
+	target->putbyte(desc.code);
 	target->putbyte(0xc0|r1|(r2<<3));
 }
 
 static void
 jive_i386_encode_regmove_sse(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -732,7 +734,7 @@ jive_i386_encode_regmove_sse(
 {
 	target->putbyte(0xF3);
 	target->putbyte(0x0F);
-	jive_i386_encode_regmove(icls, target, outputs, inputs, immediates, flags);
+	jive_i386_encode_regmove(desc, target, outputs, inputs, immediates, flags);
 }
 
 static void
@@ -753,14 +755,14 @@ jive_i386_asm_regmove(
 
 static void
 jive_i386_encode_call(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
 	const jive_codegen_imm immediates[],
 	jive_instruction_encoding_flags * flags)
 {
-	target->putbyte(icls->code());
+	target->putbyte(desc.code);
 	jive_i386_encode_imm32(&immediates[0], 0, 1, target);
 }
 
@@ -780,7 +782,7 @@ jive_i386_asm_call(
 
 static void
 jive_i386_encode_call_reg(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -823,7 +825,7 @@ jive_i386_asm_jump(
 
 static void
 jive_i386_encode_jump(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -843,7 +845,7 @@ jive_i386_encode_jump(
 
 static void
 jive_i386_encode_jump_conditional(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -853,18 +855,18 @@ jive_i386_encode_jump_conditional(
 	bool need_long_form = jive_i386_check_long_form(&immediates[0], flags, -2);
 	
 	if (!need_long_form) {
-		target->putbyte(0x70 | icls->code());
+		target->putbyte(0x70 | desc.code);
 		jive_i386_encode_imm8(&immediates[0], -2, 1, target);
 	} else {
 		target->putbyte(0x0f);
-		target->putbyte(0x80 | icls->code());
+		target->putbyte(0x80 | desc.code);
 		jive_i386_encode_imm32(&immediates[0], -6, 2, target);
 	}
 }
 
 static void
 jive_i386_encode_loadstoresse_disp(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -876,19 +878,19 @@ jive_i386_encode_loadstoresse_disp(
 	target->putbyte(0xF3);
 	target->putbyte(0x0F);
 	
-	if (icls->code() == 0x11)
+	if (desc.code == 0x11)
 		r2 = inputs[1];
 	else
 		r2 = outputs[0];
 	
-	target->putbyte(icls->code());
+	target->putbyte(desc.code);
 	jive_i386_r2i(r1, r2, &immediates[0], 3, flags, target);
 	
 }
 
 static void
 jive_i386_encode_sseload_abs(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -897,7 +899,7 @@ jive_i386_encode_sseload_abs(
 {
 	target->putbyte(0xF3);
 	target->putbyte(0x0F);
-	target->putbyte(icls->code());
+	target->putbyte(desc.code);
 	target->putbyte(0x5 | outputs[0]->code() << 3);
 
 	jive_i386_encode_imm32(&immediates[0], 0, 4, target);
@@ -905,7 +907,7 @@ jive_i386_encode_sseload_abs(
 
 static void
 jive_i386_encode_regreg_sse(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -918,13 +920,13 @@ jive_i386_encode_regreg_sse(
 	int r2 = inputs[1]->code();
 	
 	target->putbyte(0x0F);
-	target->putbyte(icls->code());
+	target->putbyte(desc.code);
 	target->putbyte(0xc0|r2|(r1<<3));
 }
 
 static void
 jive_i386_encode_regreg_sse_prefixed(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -934,7 +936,7 @@ jive_i386_encode_regreg_sse_prefixed(
 	JIVE_DEBUG_ASSERT(inputs[0] == outputs[0]);
 	
 	target->putbyte(0xF3);
-	jive_i386_encode_regreg_sse(icls, target, inputs, outputs, immediates, flags);
+	jive_i386_encode_regreg_sse(desc, target, inputs, outputs, immediates, flags);
 }
 
 static void
@@ -953,7 +955,7 @@ jive_i386_asm_fp(
 
 static void
 jive_i386_encode_fp(
-	const jive::instruction * icls,
+	const jive::i386::instruction_descriptor & desc,
 	jive::section * target,
 	const jive::registers * inputs[],
 	const jive::registers * outputs[],
@@ -968,6 +970,75 @@ jive_i386_encode_fp(
 	jive_i386_r2i(r1, r2, &immediates[0], 1, flags, target);
 }
 
+static inline void
+encode_instruction(
+	const jive::i386::instruction_descriptor & desc,
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags)
+{
+	using namespace jive::i386;
+
+#define FORM(NAME) \
+	case encoding_form::NAME: \
+		jive_i386_encode_##NAME(desc, target, inputs, outputs, immediates, flags); \
+		break;
+
+	switch (desc.form) {
+	FORM(simple)
+	FORM(int_load_imm)
+	FORM(loadstore32_disp)
+	FORM(regreg)
+	FORM(cmp_regreg)
+	FORM(cmp_regreg_sse)
+	FORM(imull)
+	FORM(mul_regreg)
+	FORM(mull)
+	FORM(div_reg)
+	FORM(shift_regimm)
+	FORM(shift_regreg)
+	FORM(regimm_readonly)
+	FORM(regimm)
+	FORM(mul_regimm)
+	FORM(unaryreg)
+	FORM(regmove)
+	FORM(regmove_sse)
+	FORM(call)
+	FORM(call_reg)
+	FORM(jump)
+	FORM(jump_conditional)
+	FORM(loadstoresse_disp)
+	FORM(sseload_abs)
+	FORM(regreg_sse)
+	FORM(regreg_sse_prefixed)
+	FORM(fp)
+	}
+
+#undef FORM
+}
+
+/* registers are within the operand masks of the descriptor */
+static inline bool
+check_operands(
+	const jive::i386::instruction_descriptor & desc,
+	const jive::registers * const inputs[],
+	const jive::registers * const outputs[])
+{
+	for (size_t n = 0; n < 3 && desc.inputs[n] != 0; n++) {
+		if ((jive::i386::operand_mask(inputs[n]) & desc.inputs[n]) == 0)
+			return false;
+	}
+
+	for (size_t n = 0; n < 3 && desc.outputs[n] != 0; n++) {
+		if ((jive::i386::operand_mask(outputs[n]) & desc.outputs[n]) == 0)
+			return false;
+	}
+
+	return true;
+}
+
 static void
 get_slot_memory_reference(const jive::resource_class * rescls,
 	jive::immediate * displacement, jive::output ** base,
@@ -985,28 +1056,64 @@ get_slot_memory_reference(const jive::resource_class * rescls,
 namespace jive {
 namespace i386 {
 
-/* FIXME: encode and write_asm take nullptr as first argument */
-#define DEFINE_I386_INSTRUCTION(NAME, CODE, MNEMONIC, \
+uint32_t
+operand_mask(const jive::registers * reg) noexcept
+{
+	auto rescls = jive::relax(reg->resource_class);
+	if (rescls == &gpr_regcls)
+		return 1 << reg->code();
+	if (rescls == &xmm_regcls)
+		return 1 << (8 + reg->code());
+	if (rescls == &cc_regcls)
+		return operand_cc;
+	if (rescls == &fp_regcls)
+		return operand_fp;
+
+	return operand_none;
+}
+
+instruction::~instruction()
+{}
+
+void
+instruction::encode(
+	jive::section * target,
+	const jive::registers * inputs[],
+	const jive::registers * outputs[],
+	const jive_codegen_imm immediates[],
+	jive_instruction_encoding_flags * flags) const
+{
+#ifdef JIVE_DEBUG
+	JIVE_DEBUG_ASSERT(check_operands(descriptor(), inputs, outputs));
+#endif
+	encode_instruction(descriptor(), target, inputs, outputs, immediates, flags);
+}
+
+void
+encode_batch(encoding_entry * entries, size_t nentries, jive::section * target)
+{
+	for (size_t n = 0; n < nentries; n++) {
+		auto & entry = entries[n];
+#ifdef JIVE_DEBUG
+		JIVE_DEBUG_ASSERT(check_operands(*entry.descriptor, entry.inputs, entry.outputs));
+#endif
+		encode_instruction(*entry.descriptor, target, entry.inputs, entry.outputs, &entry.immediate,
+			&entry.flags);
+	}
+}
+
+#define DEFINE_I386_INSTRUCTION(NAME, MNEMONIC, \
 	INPUTS, OUTPUTS, NIMMEDIATES, FLAGS, INVERSE_JUMP, \
-	ENCODE, WRITE_ASM) \
+	WRITE_ASM, ...) \
+static constexpr instruction_descriptor NAME##_descriptor = __VA_ARGS__; \
+\
 const instr_##NAME instr_##NAME::instance_; \
  \
 instr_##NAME::instr_##NAME() \
-	: instruction(#NAME, CODE, MNEMONIC, \
+	: instruction(#NAME, NAME##_descriptor, MNEMONIC, \
 		INPUTS, OUTPUTS, NIMMEDIATES, \
 		FLAGS, INVERSE_JUMP) \
 	{} \
-\
-void \
-instr_##NAME::encode( \
-	jive::section * target, \
-	const jive::registers * inputs[], \
-	const jive::registers * outputs[], \
-	const jive_codegen_imm immediates[], \
-	jive_instruction_encoding_flags * flags) const \
-{ \
-	ENCODE(nullptr, target, inputs, outputs, immediates, flags); \
-} \
  \
 void \
 instr_##NAME::write_asm( \
@@ -1016,7 +1123,7 @@ instr_##NAME::write_asm( \
 	const jive_asmgen_imm immediates[], \
 	jive_instruction_encoding_flags * flags) const \
 { \
-	WRITE_ASM(nullptr, target, inputs, outputs, immediates, flags); \
+	WRITE_ASM(this, target, inputs, outputs, immediates, flags); \
 } \
  \
 std::unique_ptr<jive::instruction> \
@@ -1028,94 +1135,108 @@ instr_##NAME::copy() const \
 #define COMMA ,
 
 DEFINE_I386_INSTRUCTION(
-	ret, 0xC3, "ret", {}, {}, 0,
-	instruction::flags::jump, nullptr, jive_i386_encode_simple, jive_i386_asm_simple)
+	ret, "ret", {}, {}, 0,
+	instruction::flags::jump, nullptr, jive_i386_asm_simple,
+	{0xC3, encoding_form::simple, 0, {}, {}})
 
 /* integer load, store, and move instructions */
 DEFINE_I386_INSTRUCTION(
-	int_load_imm, 0x8B, "movl", {}, {&gpr_regcls}, 1,
-	instruction::flags::none, nullptr, jive_i386_encode_int_load_imm, jive_i386_asm_int_load_imm)
+	int_load_imm, "movl", {}, {&gpr_regcls}, 1,
+	instruction::flags::none, nullptr, jive_i386_asm_int_load_imm,
+	{0x8B, encoding_form::int_load_imm, 32, {}, {operand_gpr}})
 DEFINE_I386_INSTRUCTION(
-	int_load32_disp, 0x8B, "movl", {&gpr_regcls}, {&gpr_regcls}, 1,
-	instruction::flags::none, nullptr, jive_i386_encode_loadstore32_disp, jive_i386_asm_load_disp)
+	int_load32_disp, "movl", {&gpr_regcls}, {&gpr_regcls}, 1,
+	instruction::flags::none, nullptr, jive_i386_asm_load_disp,
+	{0x8B, encoding_form::loadstore32_disp, 32, {operand_gpr}, {operand_gpr}})
 DEFINE_I386_INSTRUCTION(
-	int_store32_disp, 0x89, "movl", {&gpr_regcls COMMA &gpr_regcls}, {}, 1,
-	instruction::flags::none, nullptr, jive_i386_encode_loadstore32_disp, jive_i386_asm_store)
+	int_store32_disp, "movl", {&gpr_regcls COMMA &gpr_regcls}, {}, 1,
+	instruction::flags::none, nullptr, jive_i386_asm_store,
+	{0x89, encoding_form::loadstore32_disp, 32, {operand_gpr, operand_gpr}, {}})
 DEFINE_I386_INSTRUCTION(
-	int_transfer, 0x89, "movl", {&gpr_regcls}, {&gpr_regcls}, 0,
-	instruction::flags::none, nullptr, jive_i386_encode_regmove, jive_i386_asm_regmove)
+	int_lea_disp, "leal", {&gpr_regcls}, {&gpr_regcls}, 1,
+	instruction::flags::none, nullptr, jive_i386_asm_load_disp,
+	{0x8D, encoding_form::loadstore32_disp, 32, {operand_gpr}, {operand_gpr}})
+DEFINE_I386_INSTRUCTION(
+	int_transfer, "movl", {&gpr_regcls}, {&gpr_regcls}, 0,
+	instruction::flags::none, nullptr, jive_i386_asm_regmove,
+	{0x89, encoding_form::regmove, 0, {operand_gpr}, {operand_gpr}})
 
 /* integer arithmetic register register instructions */
 DEFINE_I386_INSTRUCTION(
-	int_add, 0x01, "addl",
-	{&gpr_regcls COMMA &gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	int_add, "addl", {&gpr_regcls COMMA &gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
 	instruction::flags::write_input | instruction::flags::commutative, nullptr,
-	jive_i386_encode_regreg, jive_i386_asm_regreg)
+	jive_i386_asm_regreg,
+	{0x01, encoding_form::regreg, 0, {operand_gpr, operand_gpr}, {operand_gpr, operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_sub, 0x29, "subl",
-	{&gpr_regcls COMMA &gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
-	instruction::flags::write_input, nullptr, jive_i386_encode_regreg, jive_i386_asm_regreg)
+	int_sub, "subl", {&gpr_regcls COMMA &gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	instruction::flags::write_input, nullptr, jive_i386_asm_regreg,
+	{0x29, encoding_form::regreg, 0, {operand_gpr, operand_gpr}, {operand_gpr, operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_and, 0x21, "andl",
-	{&gpr_regcls COMMA &gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	int_and, "andl", {&gpr_regcls COMMA &gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
 	instruction::flags::write_input | instruction::flags::commutative, nullptr,
-	jive_i386_encode_regreg, jive_i386_asm_regreg)
+	jive_i386_asm_regreg,
+	{0x21, encoding_form::regreg, 0, {operand_gpr, operand_gpr}, {operand_gpr, operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_or, 0x09, "orl",
-	{&gpr_regcls COMMA &gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	int_or, "orl", {&gpr_regcls COMMA &gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
 	instruction::flags::write_input | instruction::flags::commutative, nullptr,
-	jive_i386_encode_regreg, jive_i386_asm_regreg)
+	jive_i386_asm_regreg,
+	{0x09, encoding_form::regreg, 0, {operand_gpr, operand_gpr}, {operand_gpr, operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_xor, 0x31, "xorl",
-	{&gpr_regcls COMMA &gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	int_xor, "xorl", {&gpr_regcls COMMA &gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
 	instruction::flags::write_input | instruction::flags::commutative, nullptr,
-	jive_i386_encode_regreg, jive_i386_asm_regreg)
+	jive_i386_asm_regreg,
+	{0x31, encoding_form::regreg, 0, {operand_gpr, operand_gpr}, {operand_gpr, operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_mul, 0xC0AF0F, "imull",
-	{&gpr_regcls COMMA &gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	int_mul, "imull", {&gpr_regcls COMMA &gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
 	instruction::flags::write_input | instruction::flags::commutative, nullptr,
-	jive_i386_encode_mul_regreg, jive_i386_asm_regreg)
+	jive_i386_asm_regreg,
+	{0xC0AF0F, encoding_form::mul_regreg, 0, {operand_gpr, operand_gpr}, {operand_gpr, operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_mul_expand_signed, 0xF7, "imull",
+	int_mul_expand_signed, "imull",
 	{&eax_regcls COMMA &gpr_regcls}, {&edx_regcls COMMA &eax_regcls COMMA &cc_regcls}, 0,
-	instruction::flags::commutative, nullptr, jive_i386_encode_imull, jive_i386_asm_imul)
+	instruction::flags::commutative, nullptr, jive_i386_asm_imul,
+	{0xF7, encoding_form::imull, 0,
+		{operand_eax, operand_gpr}, {operand_edx, operand_eax, operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_mul_expand_unsigned, 0xF7, "mull",
+	int_mul_expand_unsigned, "mull",
 	{&eax_regcls COMMA &gpr_regcls}, {&edx_regcls COMMA &eax_regcls COMMA &cc_regcls}, 0,
-	instruction::flags::commutative, nullptr, jive_i386_encode_mull, jive_i386_asm_mul)
+	instruction::flags::commutative, nullptr, jive_i386_asm_mul,
+	{0xF7, encoding_form::mull, 0,
+		{operand_eax, operand_gpr}, {operand_edx, operand_eax, operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_sdiv, 0xF8, "idivl",
+	int_sdiv, "idivl",
 	{&edx_regcls COMMA &eax_regcls COMMA &gpr_regcls},
 	{&edx_regcls COMMA &eax_regcls COMMA &cc_regcls}, 0,
-	instruction::flags::none, nullptr, jive_i386_encode_div_reg, jive_i386_asm_div_reg)
+	instruction::flags::none, nullptr, jive_i386_asm_div_reg,
+	{0xF8, encoding_form::div_reg, 0,
+		{operand_edx, operand_eax, operand_gpr}, {operand_edx, operand_eax, operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_udiv, 0xF0, "divl",
+	int_udiv, "divl",
 	{&edx_regcls COMMA &eax_regcls COMMA &gpr_regcls},
 	{&edx_regcls COMMA &eax_regcls COMMA &cc_regcls}, 0,
-	instruction::flags::none, nullptr, jive_i386_encode_div_reg, jive_i386_asm_div_reg)
+	instruction::flags::none, nullptr, jive_i386_asm_div_reg,
+	{0xF0, encoding_form::div_reg, 0,
+		{operand_edx, operand_eax, operand_gpr}, {operand_edx, operand_eax, operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_neg, 0xD8, "negl",
-	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
-	instruction::flags::write_input, nullptr, jive_i386_encode_unaryreg, jive_i386_asm_unaryreg)
+	int_neg, "negl", {&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	instruction::flags::write_input, nullptr, jive_i386_asm_unaryreg,
+	{0xD8, encoding_form::unaryreg, 0, {operand_gpr}, {operand_gpr, operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_not, 0xD0, "notl",
-	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
-	instruction::flags::write_input, nullptr, jive_i386_encode_unaryreg, jive_i386_asm_unaryreg)
+	int_not, "notl", {&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	instruction::flags::write_input, nullptr, jive_i386_asm_unaryreg,
+	{0xD0, encoding_form::unaryreg, 0, {operand_gpr}, {operand_gpr, operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_shr, 0xE8, "shrl",
-	{&gpr_regcls COMMA &ecx_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
-	instruction::flags::write_input, nullptr,
-	jive_i386_encode_shift_regreg, jive_i386_asm_shift_regreg)
+	int_shr, "shrl", {&gpr_regcls COMMA &ecx_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	instruction::flags::write_input, nullptr, jive_i386_asm_shift_regreg,
+	{0xE8, encoding_form::shift_regreg, 0, {operand_gpr, operand_ecx}, {operand_gpr, operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_shl, 0xE0, "shll",
-	{&gpr_regcls COMMA &ecx_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
-	instruction::flags::write_input, nullptr,
-	jive_i386_encode_shift_regreg, jive_i386_asm_shift_regreg)
+	int_shl, "shll", {&gpr_regcls COMMA &ecx_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	instruction::flags::write_input, nullptr, jive_i386_asm_shift_regreg,
+	{0xE0, encoding_form::shift_regreg, 0, {operand_gpr, operand_ecx}, {operand_gpr, operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_ashr, 0xF8, "sarl",
-	{&gpr_regcls COMMA &ecx_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
-	instruction::flags::write_input, nullptr,
-	jive_i386_encode_shift_regreg, jive_i386_asm_shift_regreg)
+	int_ashr, "sarl", {&gpr_regcls COMMA &ecx_regcls}, {&gpr_regcls COMMA &cc_regcls}, 0,
+	instruction::flags::write_input, nullptr, jive_i386_asm_shift_regreg,
+	{0xF8, encoding_form::shift_regreg, 0, {operand_gpr, operand_ecx}, {operand_gpr, operand_cc}})
 
 /* integer arithmetic register immediate instructions */
 /*
@@ -1123,161 +1244,232 @@ DEFINE_I386_INSTRUCTION(
 	coding function for explanation
 */
 DEFINE_I386_INSTRUCTION(
-	int_add_immediate, 0xC0 | (0x05 << 8), "addl",
-	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
-	instruction::flags::write_input, nullptr, jive_i386_encode_regimm, jive_i386_asm_regimm)
+	int_add_immediate, "addl", {&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
+	instruction::flags::write_input, nullptr, jive_i386_asm_regimm,
+	{0xC0 | (0x05 << 8), encoding_form::regimm, 32, {operand_gpr}, {operand_gpr, operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_sub_immediate, 0xE8 | (0x2D << 8), "subl",
-	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
-	instruction::flags::write_input, nullptr, jive_i386_encode_regimm, jive_i386_asm_regimm)
+	int_sub_immediate, "subl", {&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
+	instruction::flags::write_input, nullptr, jive_i386_asm_regimm,
+	{0xE8 | (0x2D << 8), encoding_form::regimm, 32, {operand_gpr}, {operand_gpr, operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_and_immediate, 0xE0 | (0x25 << 8), "andl",
-	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
-	instruction::flags::write_input, nullptr, jive_i386_encode_regimm, jive_i386_asm_regimm)
+	int_and_immediate, "andl", {&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
+	instruction::flags::write_input, nullptr, jive_i386_asm_regimm,
+	{0xE0 | (0x25 << 8), encoding_form::regimm, 32, {operand_gpr}, {operand_gpr, operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_or_immediate, 0xC8 | (0x0D << 8), "orl",
-	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
-	instruction::flags::write_input, nullptr, jive_i386_encode_regimm, jive_i386_asm_regimm)
+	int_or_immediate, "orl", {&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
+	instruction::flags::write_input, nullptr, jive_i386_asm_regimm,
+	{0xC8 | (0x0D << 8), encoding_form::regimm, 32, {operand_gpr}, {operand_gpr, operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_xor_immediate, 0xF0 | (0x35 << 8), "xorl",
-	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
-	instruction::flags::write_input, nullptr, jive_i386_encode_regimm, jive_i386_asm_regimm)
+	int_xor_immediate, "xorl", {&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
+	instruction::flags::write_input, nullptr, jive_i386_asm_regimm,
+	{0xF0 | (0x35 << 8), encoding_form::regimm, 32, {operand_gpr}, {operand_gpr, operand_cc}})
 DEFINE_I386_INSTRUCTION(
 	/* FIXME: code is the same as for int_add_immediate, flags is none */
-	int_mul_immediate, 0xC0 | (0x05 << 8), "imull",
-	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
-	instruction::flags::none, nullptr, jive_i386_encode_mul_regimm, jive_i386_asm_mul_regimm)
+	int_mul_immediate, "imull", {&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
+	instruction::flags::none, nullptr, jive_i386_asm_mul_regimm,
+	{0xC0 | (0x05 << 8), encoding_form::mul_regimm, 32, {operand_gpr}, {operand_gpr, operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_shr_immediate, 0xE8, "shrl",
-	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
-	instruction::flags::write_input, nullptr, jive_i386_encode_shift_regimm, jive_i386_asm_regimm)
+	int_shr_immediate, "shrl", {&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
+	instruction::flags::write_input, nullptr, jive_i386_asm_regimm,
+	{0xE8, encoding_form::shift_regimm, 8, {operand_gpr}, {operand_gpr, operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_shl_immediate, 0xE0, "shll",
-	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
-	instruction::flags::write_input, nullptr, jive_i386_encode_shift_regimm, jive_i386_asm_regimm)
+	int_shl_immediate, "shll", {&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
+	instruction::flags::write_input, nullptr, jive_i386_asm_regimm,
+	{0xE0, encoding_form::shift_regimm, 8, {operand_gpr}, {operand_gpr, operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_ashr_immediate, 0xF8, "sarl",
-	{&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
-	instruction::flags::write_input, nullptr, jive_i386_encode_shift_regimm, jive_i386_asm_regimm)
+	int_ashr_immediate, "sarl", {&gpr_regcls}, {&gpr_regcls COMMA &cc_regcls}, 1,
+	instruction::flags::write_input, nullptr, jive_i386_asm_regimm,
+	{0xF8, encoding_form::shift_regimm, 8, {operand_gpr}, {operand_gpr, operand_cc}})
 
 /* call instructions */
 DEFINE_I386_INSTRUCTION(
-	call, 0xE8, "call", {}, {}, 1,
-	instruction::flags::none, nullptr, jive_i386_encode_call, jive_i386_asm_call)
+	call, "call", {}, {}, 1,
+	instruction::flags::none, nullptr, jive_i386_asm_call,
+	{0xE8, encoding_form::call, 32, {}, {}})
 DEFINE_I386_INSTRUCTION(
-	call_reg, 0xFF, "call_reg", {&gpr_regcls}, {}, 0,
-	instruction::flags::none, nullptr, jive_i386_encode_call_reg, jive_i386_asm_call_reg)
+	call_reg, "call_reg", {&gpr_regcls}, {}, 0,
+	instruction::flags::none, nullptr, jive_i386_asm_call_reg,
+	{0xFF, encoding_form::call_reg, 0, {operand_gpr}, {}})
 
 /* integer compare instructions */
 DEFINE_I386_INSTRUCTION(
-	int_cmp, 0x3b, "cmpl",
-	{&gpr_regcls COMMA &gpr_regcls}, {&cc_regcls}, 0,
-	instruction::flags::none, nullptr, jive_i386_encode_cmp_regreg, jive_i386_asm_regreg)
+	int_cmp, "cmpl", {&gpr_regcls COMMA &gpr_regcls}, {&cc_regcls}, 0,
+	instruction::flags::none, nullptr, jive_i386_asm_regreg,
+	{0x3b, encoding_form::cmp_regreg, 0, {operand_gpr, operand_gpr}, {operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	int_cmp_immediate, 0xF8 | (0x3D << 8), "cmpl",
-	{&gpr_regcls}, {&cc_regcls}, 1,
-	instruction::flags::none, nullptr, jive_i386_encode_regimm_readonly, jive_i386_asm_regimm)
+	int_cmp_immediate, "cmpl", {&gpr_regcls}, {&cc_regcls}, 1,
+	instruction::flags::none, nullptr, jive_i386_asm_regimm,
+	{0xF8 | (0x3D << 8), encoding_form::regimm_readonly, 32, {operand_gpr}, {operand_cc}})
 
 /* jump instructions */
 DEFINE_I386_INSTRUCTION(
-	int_jump_sless, 0xC, "jl", {&cc_regcls}, {}, 1,
-	instruction::flags::jump |	instruction::flags::jump_relative
+	int_jump_sless, "jl", {&cc_regcls}, {}, 1,
+	instruction::flags::jump | instruction::flags::jump_relative
 	| instruction::flags::jump_conditional_invertible, &instr_int_jump_sgreatereq::instance(),
-	jive_i386_encode_jump_conditional, jive_i386_asm_jump)
+	jive_i386_asm_jump,
+	{0xC, encoding_form::jump_conditional, 32, {operand_cc}, {}})
 DEFINE_I386_INSTRUCTION(
-	int_jump_uless, 0x2, "jb", {&cc_regcls}, {}, 1,
+	int_jump_uless, "jb", {&cc_regcls}, {}, 1,
 	instruction::flags::jump | instruction::flags::jump_relative
 	| instruction::flags::jump_conditional_invertible, &instr_int_jump_ugreatereq::instance(),
-	jive_i386_encode_jump_conditional, jive_i386_asm_jump)
+	jive_i386_asm_jump,
+	{0x2, encoding_form::jump_conditional, 32, {operand_cc}, {}})
 DEFINE_I386_INSTRUCTION(
-	int_jump_slesseq, 0xE, "jle", {&cc_regcls}, {}, 1,
+	int_jump_slesseq, "jle", {&cc_regcls}, {}, 1,
 	instruction::flags::jump | instruction::flags::jump_relative
 	| instruction::flags::jump_conditional_invertible, &instr_int_jump_sgreater::instance(),
-	jive_i386_encode_jump_conditional, jive_i386_asm_jump)
+	jive_i386_asm_jump,
+	{0xE, encoding_form::jump_conditional, 32, {operand_cc}, {}})
 DEFINE_I386_INSTRUCTION(
-	int_jump_ulesseq, 0x6, "jbe", {&cc_regcls}, {}, 1,
+	int_jump_ulesseq, "jbe", {&cc_regcls}, {}, 1,
 	instruction::flags::jump | instruction::flags::jump_relative
 	| instruction::flags::jump_conditional_invertible, &instr_int_jump_ugreater::instance(),
-	jive_i386_encode_jump_conditional, jive_i386_asm_jump)
+	jive_i386_asm_jump,
+	{0x6, encoding_form::jump_conditional, 32, {operand_cc}, {}})
 DEFINE_I386_INSTRUCTION(
-	int_jump_equal, 0x4, "je", {&cc_regcls}, {}, 1,
+	int_jump_equal, "je", {&cc_regcls}, {}, 1,
 	instruction::flags::jump | instruction::flags::jump_relative
 	| instruction::flags::jump_conditional_invertible, &instr_int_jump_notequal::instance(),
-	jive_i386_encode_jump_conditional, jive_i386_asm_jump)
+	jive_i386_asm_jump,
+	{0x4, encoding_form::jump_conditional, 32, {operand_cc}, {}})
 DEFINE_I386_INSTRUCTION(
-	int_jump_notequal, 0x5, "jne", {&cc_regcls}, {}, 1,
+	int_jump_notequal, "jne", {&cc_regcls}, {}, 1,
 	instruction::flags::jump | instruction::flags::jump_relative
 	| instruction::flags::jump_conditional_invertible, &instr_int_jump_equal::instance(),
-	jive_i386_encode_jump_conditional, jive_i386_asm_jump)
+	jive_i386_asm_jump,
+	{0x5, encoding_form::jump_conditional, 32, {operand_cc}, {}})
 DEFINE_I386_INSTRUCTION(
-	int_jump_sgreater, 0xF, "jg", {&cc_regcls}, {}, 1,
+	int_jump_sgreater, "jg", {&cc_regcls}, {}, 1,
 	instruction::flags::jump | instruction::flags::jump_relative
 	| instruction::flags::jump_conditional_invertible, &instr_int_jump_slesseq::instance(),
-	jive_i386_encode_jump_conditional, jive_i386_asm_jump)
+	jive_i386_asm_jump,
+	{0xF, encoding_form::jump_conditional, 32, {operand_cc}, {}})
 DEFINE_I386_INSTRUCTION(
-	int_jump_ugreater, 0x7, "ja", {&cc_regcls}, {}, 1,
+	int_jump_ugreater, "ja", {&cc_regcls}, {}, 1,
 	instruction::flags::jump | instruction::flags::jump_relative
 	| instruction::flags::jump_conditional_invertible, &instr_int_jump_ulesseq::instance(),
-	jive_i386_encode_jump_conditional, jive_i386_asm_jump)
+	jive_i386_asm_jump,
+	{0x7, encoding_form::jump_conditional, 32, {operand_cc}, {}})
 DEFINE_I386_INSTRUCTION(
-	int_jump_sgreatereq, 0xD, "jge", {&cc_regcls}, {}, 1,
+	int_jump_sgreatereq, "jge", {&cc_regcls}, {}, 1,
 	instruction::flags::jump | instruction::flags::jump_relative
 	| instruction::flags::jump_conditional_invertible, &instr_int_jump_sless::instance(),
-	jive_i386_encode_jump_conditional, jive_i386_asm_jump)
+	jive_i386_asm_jump,
+	{0xD, encoding_form::jump_conditional, 32, {operand_cc}, {}})
 DEFINE_I386_INSTRUCTION(
-	int_jump_ugreatereq, 0x3, "jae", {&cc_regcls}, {}, 1,
+	int_jump_ugreatereq, "jae", {&cc_regcls}, {}, 1,
 	instruction::flags::jump | instruction::flags::jump_relative
 	| instruction::flags::jump_conditional_invertible, &instr_int_jump_uless::instance(),
-	jive_i386_encode_jump_conditional, jive_i386_asm_jump)
+	jive_i386_asm_jump,
+	{0x3, encoding_form::jump_conditional, 32, {operand_cc}, {}})
 DEFINE_I386_INSTRUCTION(
-	jump, 0xEB, "jmp", {}, {}, 1,
-	instruction::flags::jump_relative, nullptr, jive_i386_encode_jump, jive_i386_asm_jump)
+	jump, "jmp", {}, {}, 1,
+	instruction::flags::jump_relative, nullptr, jive_i386_asm_jump,
+	{0xEB, encoding_form::jump, 32, {}, {}})
 
 /* floating-point instructions */
 DEFINE_I386_INSTRUCTION(
-	fp_load_disp, 0x0, "flds", {&gpr_regcls}, {&fp_regcls}, 1,
-	instruction::flags::none, nullptr, jive_i386_encode_fp, jive_i386_asm_fp)
+	fp_load_disp, "flds", {&gpr_regcls}, {&fp_regcls}, 1,
+	instruction::flags::none, nullptr, jive_i386_asm_fp,
+	{0x0, encoding_form::fp, 32, {operand_gpr}, {operand_fp}})
 DEFINE_I386_INSTRUCTION(
-	sse_load32_disp, 0x10, "movss", {&gpr_regcls}, {&xmm_regcls}, 1,
-	instruction::flags::none, nullptr, jive_i386_encode_loadstoresse_disp, jive_i386_asm_load_disp)
+	sse_load32_disp, "movss", {&gpr_regcls}, {&xmm_regcls}, 1,
+	instruction::flags::none, nullptr, jive_i386_asm_load_disp,
+	{0x10, encoding_form::loadstoresse_disp, 32, {operand_gpr}, {operand_xmm}})
 DEFINE_I386_INSTRUCTION(
-	sse_load_abs, 0x10, "movss", {}, {&xmm_regcls}, 1,
-	instruction::flags::none, nullptr, jive_i386_encode_sseload_abs, jive_i386_asm_load_abs)
+	sse_load_abs, "movss", {}, {&xmm_regcls}, 1,
+	instruction::flags::none, nullptr, jive_i386_asm_load_abs,
+	{0x10, encoding_form::sseload_abs, 32, {}, {operand_xmm}})
 DEFINE_I386_INSTRUCTION(
-	sse_store32_disp, 0x11, "movss", {&gpr_regcls COMMA &xmm_regcls}, {}, 1,
-	instruction::flags::none, nullptr, jive_i386_encode_loadstoresse_disp, jive_i386_asm_store)
+	sse_store32_disp, "movss", {&gpr_regcls COMMA &xmm_regcls}, {}, 1,
+	instruction::flags::none, nullptr, jive_i386_asm_store,
+	{0x11, encoding_form::loadstoresse_disp, 32, {operand_gpr, operand_xmm}, {}})
 DEFINE_I386_INSTRUCTION(
-	sse_xor, 0x57, "xorps", {&xmm_regcls COMMA &xmm_regcls}, {&xmm_regcls}, 0,
+	sse_xor, "xorps", {&xmm_regcls COMMA &xmm_regcls}, {&xmm_regcls}, 0,
 	instruction::flags::write_input | instruction::flags::commutative, nullptr,
-	jive_i386_encode_regreg_sse, jive_i386_asm_regreg)
+	jive_i386_asm_regreg,
+	{0x57, encoding_form::regreg_sse, 0, {operand_xmm, operand_xmm}, {operand_xmm}})
 DEFINE_I386_INSTRUCTION(
-	float_add, 0x58, "addss", {&xmm_regcls COMMA &xmm_regcls}, {&xmm_regcls}, 0,
+	float_add, "addss", {&xmm_regcls COMMA &xmm_regcls}, {&xmm_regcls}, 0,
 	instruction::flags::write_input | instruction::flags::commutative, nullptr,
-	jive_i386_encode_regreg_sse_prefixed, jive_i386_asm_regreg)
+	jive_i386_asm_regreg,
+	{0x58, encoding_form::regreg_sse_prefixed, 0, {operand_xmm, operand_xmm}, {operand_xmm}})
 DEFINE_I386_INSTRUCTION(
-	float_sub, 0x5C, "subss", {&xmm_regcls COMMA &xmm_regcls}, {&xmm_regcls}, 0,
-	instruction::flags::write_input, nullptr,
-	jive_i386_encode_regreg_sse_prefixed, jive_i386_asm_regreg)
+	float_sub, "subss", {&xmm_regcls COMMA &xmm_regcls}, {&xmm_regcls}, 0,
+	instruction::flags::write_input, nullptr, jive_i386_asm_regreg,
+	{0x5C, encoding_form::regreg_sse_prefixed, 0, {operand_xmm, operand_xmm}, {operand_xmm}})
 DEFINE_I386_INSTRUCTION(
-	float_mul, 0x59, "mulss", {&xmm_regcls COMMA &xmm_regcls}, {&xmm_regcls}, 0,
+	float_mul, "mulss", {&xmm_regcls COMMA &xmm_regcls}, {&xmm_regcls}, 0,
 	instruction::flags::write_input | instruction::flags::commutative, nullptr,
-	jive_i386_encode_regreg_sse_prefixed, jive_i386_asm_regreg)
+	jive_i386_asm_regreg,
+	{0x59, encoding_form::regreg_sse_prefixed, 0, {operand_xmm, operand_xmm}, {operand_xmm}})
 DEFINE_I386_INSTRUCTION(
-	float_div, 0x5E, "divss", {&xmm_regcls COMMA &xmm_regcls}, {&xmm_regcls}, 0,
-	instruction::flags::write_input, nullptr,
-	jive_i386_encode_regreg_sse_prefixed, jive_i386_asm_regreg)
+	float_div, "divss", {&xmm_regcls COMMA &xmm_regcls}, {&xmm_regcls}, 0,
+	instruction::flags::write_input, nullptr, jive_i386_asm_regreg,
+	{0x5E, encoding_form::regreg_sse_prefixed, 0, {operand_xmm, operand_xmm}, {operand_xmm}})
 DEFINE_I386_INSTRUCTION(
-	float_cmp, 0x2E, "ucomiss", {&xmm_regcls COMMA &xmm_regcls}, {&cc_regcls}, 0,
-	instruction::flags::none, nullptr, jive_i386_encode_cmp_regreg_sse, jive_i386_asm_regreg)
+	float_cmp, "ucomiss", {&xmm_regcls COMMA &xmm_regcls}, {&cc_regcls}, 0,
+	instruction::flags::none, nullptr, jive_i386_asm_regreg,
+	{0x2E, encoding_form::cmp_regreg_sse, 0, {operand_xmm, operand_xmm}, {operand_cc}})
 DEFINE_I386_INSTRUCTION(
-	float_transfer, 0x10, "movss", {&xmm_regcls}, {&xmm_regcls}, 0,
-	instruction::flags::none, nullptr, jive_i386_encode_regmove_sse, jive_i386_asm_regmove)
+	float_transfer, "movss", {&xmm_regcls}, {&xmm_regcls}, 0,
+	instruction::flags::none, nullptr, jive_i386_asm_regmove,
+	{0x10, encoding_form::regmove_sse, 0, {operand_xmm}, {operand_xmm}})
+
+/*
+	instruction timings, latency and reciprocal throughput in cycles
+
+	The figures are representative of out-of-order i686 cores, instructions
+	not listed complete in a single cycle.
+*/
+
+#define TIMING(NAME, LATENCY, THROUGHPUT) \
+	{&instr_##NAME::instance(), jive::instruction_timing(LATENCY, THROUGHPUT)}
+
+static const std::unordered_map<const jive::instruction*, jive::instruction_timing> &
+timings()
+{
+	static const std::unordered_map<const jive::instruction*, jive::instruction_timing> map({
+		TIMING(int_load32_disp, 3, 1)
+	, TIMING(int_store32_disp, 1, 1)
+	, TIMING(int_shl, 2, 1)
+	, TIMING(int_shr, 2, 1)
+	, TIMING(int_ashr, 2, 1)
+	, TIMING(int_mul, 3, 1)
+	, TIMING(int_mul_immediate, 3, 1)
+	, TIMING(int_mul_expand_signed, 4, 1)
+	, TIMING(int_mul_expand_unsigned, 4, 1)
+	, TIMING(int_sdiv, 26, 26)
+	, TIMING(int_udiv, 26, 26)
+	, TIMING(call, 5, 2)
+	, TIMING(call_reg, 5, 2)
+	, TIMING(fp_load_disp, 3, 1)
+	, TIMING(sse_load32_disp, 3, 1)
+	, TIMING(sse_load_abs, 3, 1)
+	, TIMING(float_add, 3, 1)
+	, TIMING(float_sub, 3, 1)
+	, TIMING(float_mul, 5, 1)
+	, TIMING(float_div, 18, 18)
+	, TIMING(float_cmp, 2, 1)
+	});
+
+	return map;
+}
+
+#undef TIMING
 
 /* instructionset */
 
 instructionset::~instructionset()
 {}
 
+jive::instruction_timing
+instructionset::timing(const jive::instruction * icls) const noexcept
+{
+	auto it = timings().find(icls);
+	return it != timings().end() ? it->second : jive::instruction_timing(1, 1);
+}
+
 const jive::instruction *
 instructionset::jump_instruction() const noexcept
 {
@@ -1295,17 +1487,16 @@ instructionset::create_xfer(
 	jive::region * region,
 	jive::output * origin,
 	const jive::resource_class * in_class,
-	const jive::resource_class * out_class)
+	const jive::resource_class * out_class) const
 {
+	/* stack and frame pointer are only needed for transfers through memory */
 	auto sub = jive_region_get_subroutine_node(region);
 
-	auto sp = jive_subroutine_node_get_sp(sub);
-	auto fp = jive_subroutine_node_get_fp(sub);
-
 	if (!in_class->is_resource(&jive::register_resource)) {
 		jive::output * base;
 		jive::immediate displacement;
-		get_slot_memory_reference(in_class, &displacement, &base, sp, fp);
+		get_slot_memory_reference(in_class, &displacement, &base,
+			jive_subroutine_node_get_sp(sub), jive_subroutine_node_get_fp(sub));
 		auto imm = immediate_op::create(region, displacement);
 		auto node = jive::create_instruction(region, &jive::i386::instr_int_load32_disp::instance(),
 			{base, imm, origin}, {in_class}, {});
@@ -1315,7 +1506,8 @@ instructionset::create_xfer(
 	if (!out_class->is_resource(&jive::register_resource)) {
 		jive::output * base;
 		jive::immediate displacement;
-		get_slot_memory_reference(out_class, &displacement, &base, sp, fp);
+		get_slot_memory_reference(out_class, &displacement, &base,
+			jive_subroutine_node_get_sp(sub), jive_subroutine_node_get_fp(sub));
 		auto imm = immediate_op::create(region, displacement);
 		auto node = jive::create_instruction(region, &jive::i386::instr_int_store32_disp::instance(),
 			{base, origin, imm}, {}, {out_class});
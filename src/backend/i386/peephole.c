@@ -0,0 +1,314 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jive/arch/instruction.h>
+#include <jive/backend/i386/instructionset.h>
+#include <jive/backend/i386/peephole.h>
+#include <jive/rvsdg/graph.h>
+#include <jive/rvsdg/structural-node.h>
+#include <jive/rvsdg/traverser.h>
+
+#include <functional>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+namespace jive {
+namespace i386 {
+
+namespace {
+
+typedef std::tuple<jive_immediate_int, const jive::label*, const jive::label*, const void*>
+	immediate_key;
+
+/* state shared by the patterns within one region */
+class peephole_context final {
+public:
+	std::map<immediate_key, jive::node*> loads;
+};
+
+typedef std::function<bool(jive::node*, peephole_context&)> pattern;
+
+static inline const jive::instruction *
+icls(const jive::node * node) noexcept
+{
+	if (!node || !is_instruction_node(node))
+		return nullptr;
+
+	return static_cast<const jive::instruction_op*>(&node->operation())->icls();
+}
+
+static inline const jive::immediate &
+immediate_operand(const jive::node * node, size_t index) noexcept
+{
+	auto origin = node->input(index)->origin()->node();
+	JIVE_DEBUG_ASSERT(is_immediate_node(origin));
+	return static_cast<const jive::immediate_op*>(&origin->operation())->value();
+}
+
+/* immediate materialized by an int_load_imm, nullptr for other values */
+static const jive::immediate *
+loaded_immediate(const jive::output * output) noexcept
+{
+	auto node = output->node();
+	if (icls(node) != &instr_int_load_imm::instance())
+		return nullptr;
+
+	return &immediate_operand(node, 0);
+}
+
+/* the instruction exactly consists of its instruction class operands and results */
+static inline bool
+is_plain(const jive::node * node) noexcept
+{
+	auto i = icls(node);
+	return node->ninputs() == i->ninputs() + i->nimmediates() && node->noutputs() == i->noutputs();
+}
+
+/* all results except the first, i.e. the condition codes, are unused */
+static inline bool
+only_result_used(const jive::node * node) noexcept
+{
+	for (size_t n = 1; n < node->noutputs(); n++) {
+		if (node->output(n)->nusers() != 0)
+			return false;
+	}
+
+	return true;
+}
+
+static void
+replace(jive::node * node, jive::node * replacement)
+{
+	JIVE_DEBUG_ASSERT(node->noutputs() == replacement->noutputs());
+	for (size_t n = 0; n < node->noutputs(); n++)
+		node->output(n)->divert_users(replacement->output(n));
+	remove(node);
+}
+
+static void
+replace(jive::node * node, jive::output * value)
+{
+	JIVE_DEBUG_ASSERT(only_result_used(node));
+	node->output(0)->divert_users(value);
+	remove(node);
+}
+
+static jive::node *
+create_regimm(
+	jive::region * region,
+	const jive::instruction * regimm,
+	jive::output * operand,
+	const jive::immediate & imm)
+{
+	auto tmp = jive::immediate_op::create(region, imm);
+	return jive::create_instruction(region, regimm, {operand, tmp});
+}
+
+/* op r1, r2 with r2 loaded from an immediate => op r1, imm */
+static pattern
+fold_immediate(const jive::instruction * regimm)
+{
+	return [=](jive::node * node, peephole_context &)
+	{
+		if (!is_plain(node))
+			return false;
+
+		auto arg1 = node->input(0)->origin();
+		auto arg2 = node->input(1)->origin();
+		auto imm = loaded_immediate(arg2);
+		if (!imm && icls(node)->is_commutative()) {
+			imm = loaded_immediate(arg1);
+			arg1 = arg2;
+		}
+
+		if (!imm)
+			return false;
+
+		replace(node, create_regimm(node->region(), regimm, arg1, *imm));
+		return true;
+	};
+}
+
+/* op r, imm with imm neutral => r */
+static pattern
+remove_neutral(jive_immediate_int neutral)
+{
+	return [=](jive::node * node, peephole_context &)
+	{
+		if (!is_plain(node) || !only_result_used(node))
+			return false;
+
+		auto & imm = immediate_operand(node, 1);
+		if (imm.has_symbols() || uint32_t(imm.offset()) != uint32_t(neutral))
+			return false;
+
+		replace(node, node->input(0)->origin());
+		return true;
+	};
+}
+
+/* op (op r, imm1), imm2 => op r, imm1+imm2, for additions and subtractions */
+static pattern
+combine_chain()
+{
+	return [=](jive::node * node, peephole_context &)
+	{
+		auto inner = node->input(0)->origin()->node();
+		if (icls(inner) != icls(node) || !is_plain(node) || !is_plain(inner)
+		|| inner->output(0)->nusers() != 1 || !only_result_used(inner) || !only_result_used(node))
+			return false;
+
+		auto imm = immediate_operand(inner, 1);
+		if (imm.has_symbols() || immediate_operand(node, 1).has_symbols())
+			return false;
+
+		imm += immediate_operand(node, 1);
+		auto operand = inner->input(0)->origin();
+		replace(node, create_regimm(node->region(), icls(node), operand, imm));
+		/* remove the inner instruction right away such that longer chains fold as well */
+		remove(inner);
+		return true;
+	};
+}
+
+/*
+	add r, imm with r still live afterwards => lea imm(r), r'
+
+	The addition overwrites its operand, such that the register allocator
+	would have to copy r beforehand. The address computation writes a
+	separate register instead.
+*/
+static pattern
+add_to_lea(bool negate)
+{
+	return [=](jive::node * node, peephole_context &)
+	{
+		auto operand = node->input(0)->origin();
+		if (!is_plain(node) || !only_result_used(node) || operand->nusers() < 2)
+			return false;
+
+		auto imm = immediate_operand(node, 1);
+		if (negate) {
+			if (imm.has_symbols())
+				return false;
+			imm = jive::immediate(-imm.offset());
+		}
+
+		replace(node, create_regimm(node->region(), &instr_int_lea_disp::instance(), operand, imm)
+			->output(0));
+		return true;
+	};
+}
+
+/* imul r, 2^k => shl r, k */
+static pattern
+multiply_to_shift()
+{
+	return [=](jive::node * node, peephole_context &)
+	{
+		if (!is_plain(node) || !only_result_used(node))
+			return false;
+
+		auto & imm = immediate_operand(node, 1);
+		uint32_t value = imm.offset();
+		if (imm.has_symbols() || value < 2 || (value & (value-1)) != 0)
+			return false;
+
+		jive_immediate_int shift = 0;
+		while ((value >>= 1) != 0)
+			shift++;
+
+		replace(node, create_regimm(node->region(), &instr_int_shl_immediate::instance(),
+			node->input(0)->origin(), jive::immediate(shift)));
+		return true;
+	};
+}
+
+/* identical immediate loads within a region => single load */
+static pattern
+share_load()
+{
+	return [=](jive::node * node, peephole_context & context)
+	{
+		if (!is_plain(node))
+			return false;
+
+		auto & imm = immediate_operand(node, 0);
+		immediate_key key(imm.offset(), imm.add_label(), imm.sub_label(), imm.modifier());
+		auto it = context.loads.find(key);
+		if (it == context.loads.end()) {
+			context.loads[key] = node;
+			return false;
+		}
+
+		replace(node, it->second);
+		return true;
+	};
+}
+
+static const std::unordered_map<const jive::instruction*, std::vector<pattern>> &
+patterns()
+{
+	static const std::unordered_map<const jive::instruction*, std::vector<pattern>> map({
+	  {&instr_int_add::instance(), {fold_immediate(&instr_int_add_immediate::instance())}}
+	, {&instr_int_sub::instance(), {fold_immediate(&instr_int_sub_immediate::instance())}}
+	, {&instr_int_and::instance(), {fold_immediate(&instr_int_and_immediate::instance())}}
+	, {&instr_int_or::instance(), {fold_immediate(&instr_int_or_immediate::instance())}}
+	, {&instr_int_xor::instance(), {fold_immediate(&instr_int_xor_immediate::instance())}}
+	, {&instr_int_mul::instance(), {fold_immediate(&instr_int_mul_immediate::instance())}}
+	, {&instr_int_shl::instance(), {fold_immediate(&instr_int_shl_immediate::instance())}}
+	, {&instr_int_shr::instance(), {fold_immediate(&instr_int_shr_immediate::instance())}}
+	, {&instr_int_ashr::instance(), {fold_immediate(&instr_int_ashr_immediate::instance())}}
+	, {&instr_int_cmp::instance(), {fold_immediate(&instr_int_cmp_immediate::instance())}}
+	, {&instr_int_add_immediate::instance(),
+		{remove_neutral(0), combine_chain(), add_to_lea(false)}}
+	, {&instr_int_sub_immediate::instance(),
+		{remove_neutral(0), combine_chain(), add_to_lea(true)}}
+	, {&instr_int_and_immediate::instance(), {remove_neutral(-1)}}
+	, {&instr_int_or_immediate::instance(), {remove_neutral(0)}}
+	, {&instr_int_xor_immediate::instance(), {remove_neutral(0)}}
+	, {&instr_int_mul_immediate::instance(), {remove_neutral(1), multiply_to_shift()}}
+	, {&instr_int_shl_immediate::instance(), {remove_neutral(0)}}
+	, {&instr_int_shr_immediate::instance(), {remove_neutral(0)}}
+	, {&instr_int_ashr_immediate::instance(), {remove_neutral(0)}}
+	, {&instr_int_load_imm::instance(), {share_load()}}
+	});
+
+	return map;
+}
+
+static void
+optimize_region(jive::region * region)
+{
+	peephole_context context;
+	for (auto node : bottomup_traverser(region, true)) {
+		if (auto snode = dynamic_cast<jive::structural_node*>(node)) {
+			for (size_t n = 0; n < snode->nsubregions(); n++)
+				optimize_region(snode->subregion(n));
+			continue;
+		}
+
+		auto it = patterns().find(icls(node));
+		if (it == patterns().end())
+			continue;
+
+		for (const auto & pattern : it->second) {
+			if (pattern(node, context))
+				break;
+		}
+	}
+}
+
+}
+
+void
+optimize_peephole(jive::graph * graph)
+{
+	optimize_region(graph->root());
+	graph->prune();
+}
+
+}}
@@ -471,7 +471,9 @@ eval_argument(const jive::argument * argument, context & ctx)
 		}
 	} else {
 		result = eval_input(argument->input(), ctx);
-		ctx.insert(argument, result.get());
+		/* function values depend on the arguments of the apply node evaluating them */
+		if (!dynamic_cast<const jive::fcttype*>(&argument->type()))
+			ctx.insert(argument, result.get());
 	}
 
 	return result;
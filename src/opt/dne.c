@@ -0,0 +1,282 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jive/opt/dne.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/graph.h>
+#include <jive/rvsdg/phi.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/rvsdg/traverser.h>
+#include <jive/types/function.h>
+
+#include <unordered_set>
+
+namespace {
+
+class dne_context {
+public:
+	void
+	mark(const jive::region * root);
+
+	void
+	sweep(jive::region * region);
+
+private:
+	inline void
+	mark(const jive::output * output)
+	{
+		if (live_.insert(output).second)
+			worklist_.push_back(output);
+	}
+
+	void
+	mark_argument(const jive::argument * argument);
+
+	void
+	mark_output(const jive::output * output);
+
+	inline bool
+	is_live(const jive::output * output) const noexcept
+	{
+		return live_.find(output) != live_.end();
+	}
+
+	bool
+	is_live(const jive::node * node) const noexcept;
+
+	void
+	sweep_gamma(jive::gamma_node * gamma);
+
+	void
+	sweep_theta(jive::theta_node * theta);
+
+	void
+	sweep_phi(jive::structural_node * phi);
+
+	void
+	remove_dependencies(jive::structural_node * node);
+
+	std::unordered_set<const jive::output*> live_;
+	std::vector<const jive::output*> worklist_;
+};
+
+void
+dne_context::mark(const jive::region * root)
+{
+	for (size_t n = 0; n < root->nresults(); n++)
+		mark(root->result(n)->origin());
+
+	while (!worklist_.empty()) {
+		auto output = worklist_.back();
+		worklist_.pop_back();
+
+		if (auto argument = dynamic_cast<const jive::argument*>(output))
+			mark_argument(argument);
+		else
+			mark_output(output);
+	}
+}
+
+void
+dne_context::mark_argument(const jive::argument * argument)
+{
+	auto region = argument->region();
+	if (auto input = argument->input()) {
+		mark(input->origin());
+
+		/* the value of a loop variable in the next iteration */
+		if (jive::is<jive::theta_op>(region->node()))
+			mark(region->result(argument->index()+1)->origin());
+		return;
+	}
+
+	if (jive::is<jive::phi_op>(region->node()))
+		mark(region->result(jive::recvar_index(argument))->origin());
+}
+
+void
+dne_context::mark_output(const jive::output * output)
+{
+	auto node = output->node();
+	auto snode = dynamic_cast<const jive::structural_node*>(node);
+	if (!snode) {
+		for (size_t n = 0; n < node->ninputs(); n++)
+			mark(node->input(n)->origin());
+		return;
+	}
+
+	if (auto gamma = dynamic_cast<const jive::gamma_node*>(snode)) {
+		mark(gamma->predicate()->origin());
+		for (size_t n = 0; n < gamma->nsubregions(); n++)
+			mark(gamma->subregion(n)->result(output->index())->origin());
+		return;
+	}
+
+	if (auto theta = dynamic_cast<const jive::theta_node*>(snode)) {
+		/* the output is the value of the loop variable after the last iteration,
+		 * which is the input if the body is never repeated */
+		mark(theta->predicate()->origin());
+		mark(theta->subregion()->argument(output->index()));
+		return;
+	}
+
+	if (jive::is<jive::phi_op>(snode)) {
+		mark(snode->subregion(0)->result(output->index())->origin());
+		return;
+	}
+
+	/* the results of lambdas and unknown structural nodes are all live */
+	for (size_t r = 0; r < snode->nsubregions(); r++) {
+		for (size_t n = 0; n < snode->subregion(r)->nresults(); n++)
+			mark(snode->subregion(r)->result(n)->origin());
+	}
+
+	if (dynamic_cast<const jive::lambda_node*>(snode))
+		return;
+
+	for (size_t n = 0; n < snode->ninputs(); n++)
+		mark(snode->input(n)->origin());
+}
+
+bool
+dne_context::is_live(const jive::node * node) const noexcept
+{
+	for (size_t n = 0; n < node->noutputs(); n++) {
+		if (is_live(node->output(n)))
+			return true;
+	}
+
+	return false;
+}
+
+void
+dne_context::sweep(jive::region * region)
+{
+	/* users are visited first, so dead outputs have no users left when they are removed */
+	for (auto node : jive::bottomup_traverser(region)) {
+		if (!is_live(node)) {
+			remove(node);
+			continue;
+		}
+
+		if (auto gamma = dynamic_cast<jive::gamma_node*>(node)) {
+			sweep_gamma(gamma);
+		} else if (auto theta = dynamic_cast<jive::theta_node*>(node)) {
+			sweep_theta(theta);
+		} else if (jive::is<jive::phi_op>(node)) {
+			sweep_phi(static_cast<jive::structural_node*>(node));
+		} else if (auto lambda = dynamic_cast<jive::lambda_node*>(node)) {
+			sweep(lambda->subregion());
+			remove_dependencies(lambda);
+		} else if (auto snode = dynamic_cast<jive::structural_node*>(node)) {
+			for (size_t n = 0; n < snode->nsubregions(); n++)
+				sweep(snode->subregion(n));
+		}
+	}
+}
+
+void
+dne_context::sweep_gamma(jive::gamma_node * gamma)
+{
+	for (size_t n = gamma->noutputs(); n > 0; n--) {
+		if (is_live(gamma->output(n-1)))
+			continue;
+
+		for (size_t r = 0; r < gamma->nsubregions(); r++)
+			gamma->subregion(r)->remove_result(n-1);
+		gamma->remove_output(n-1);
+	}
+
+	for (size_t r = 0; r < gamma->nsubregions(); r++)
+		sweep(gamma->subregion(r));
+
+	/* the predicate is always live */
+	for (size_t n = gamma->ninputs()-1; n > 0; n--) {
+		bool used = false;
+		for (size_t r = 0; r < gamma->nsubregions(); r++)
+			used = used || gamma->subregion(r)->argument(n-1)->nusers() != 0;
+		if (used)
+			continue;
+
+		for (size_t r = 0; r < gamma->nsubregions(); r++)
+			gamma->subregion(r)->remove_argument(n-1);
+		gamma->remove_input(n);
+	}
+}
+
+void
+dne_context::sweep_theta(jive::theta_node * theta)
+{
+	std::vector<jive::theta_output*> dead;
+	for (const auto & lv : *theta) {
+		if (is_live(lv) || is_live(lv->argument()))
+			continue;
+
+		lv->result()->divert_to(lv->argument());
+		dead.push_back(lv);
+	}
+
+	sweep(theta->subregion());
+
+	for (auto it = dead.rbegin(); it != dead.rend(); it++)
+		theta->remove_loopvar(*it);
+}
+
+void
+dne_context::sweep_phi(jive::structural_node * phi)
+{
+	auto subregion = phi->subregion(0);
+
+	std::vector<jive::argument*> recvars;
+	for (size_t n = 0; n < subregion->narguments(); n++) {
+		if (subregion->argument(n)->input() == nullptr)
+			recvars.push_back(subregion->argument(n));
+	}
+
+	std::vector<jive::argument*> dead;
+	for (size_t n = phi->noutputs(); n > 0; n--) {
+		if (is_live(phi->output(n-1)) || is_live(recvars[n-1]))
+			continue;
+
+		subregion->remove_result(n-1);
+		phi->remove_output(n-1);
+		dead.push_back(recvars[n-1]);
+	}
+
+	sweep(subregion);
+
+	for (const auto & argument : dead)
+		subregion->remove_argument(argument->index());
+	remove_dependencies(phi);
+}
+
+void
+dne_context::remove_dependencies(jive::structural_node * node)
+{
+	auto subregion = node->subregion(0);
+	for (size_t n = subregion->narguments(); n > 0; n--) {
+		auto argument = subregion->argument(n-1);
+		auto input = argument->input();
+		if (!input || argument->nusers() != 0)
+			continue;
+
+		subregion->remove_argument(n-1);
+		node->remove_input(input->index());
+	}
+}
+
+}
+
+namespace jive {
+
+void
+dne(jive::graph * graph)
+{
+	dne_context context;
+	context.mark(graph->root());
+	context.sweep(graph->root());
+}
+
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jive/opt/gvn.h>
+#include <jive/opt/route.h>
+#include <jive/rvsdg/graph.h>
+#include <jive/rvsdg/simple-node.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/rvsdg/traverser.h>
+#include <jive/util/hash.h>
+
+#include <map>
+#include <unordered_map>
+
+namespace {
+
+/* an operation applied to the congruence classes of its operands */
+struct expression {
+	const jive::node * node;
+	std::vector<size_t> operands;
+};
+
+struct expression_hash {
+	size_t
+	operator()(const expression & e) const
+	{
+		size_t hash = e.node->operation().hash();
+		for (const auto & operand : e.operands)
+			hash = jive::detail::combine_hash(hash, operand);
+
+		return hash;
+	}
+};
+
+struct expression_equal {
+	bool
+	operator()(const expression & e1, const expression & e2) const
+	{
+		return e1.operands == e2.operands
+		    && e1.node->noutputs() == e2.node->noutputs()
+		    && e1.node->operation() == e2.node->operation();
+	}
+};
+
+class gvn_context {
+public:
+	inline
+	gvn_context()
+	: nclasses_(0)
+	{}
+
+	void
+	number(jive::region * region);
+
+private:
+	size_t
+	congruence_class(const jive::output * output);
+
+	jive::output *
+	available(jive::output * output, jive::region * region);
+
+	size_t nclasses_;
+	std::unordered_map<const jive::output*, size_t> classes_;
+	std::unordered_map<expression, jive::node*, expression_hash, expression_equal> leaders_;
+	std::map<std::pair<const jive::output*, const jive::region*>, jive::output*> routed_;
+};
+
+size_t
+gvn_context::congruence_class(const jive::output * output)
+{
+	auto it = classes_.find(output);
+	if (it != classes_.end())
+		return it->second;
+
+	/* arguments are congruent to their origin unless they vary within a loop */
+	auto argument = dynamic_cast<const jive::argument*>(output);
+	if (argument && argument->input()) {
+		auto theta_input = dynamic_cast<const jive::theta_input*>(argument->input());
+		if (!theta_input || jive::is_invariant(theta_input))
+			return classes_[output] = congruence_class(argument->input()->origin());
+	}
+
+	return classes_[output] = nclasses_++;
+}
+
+jive::output *
+gvn_context::available(jive::output * output, jive::region * region)
+{
+	if (output->region() == region)
+		return output;
+
+	auto key = std::make_pair(output, region);
+	auto it = routed_.find(key);
+	if (it != routed_.end())
+		return it->second;
+
+	return routed_[key] = jive::route(output, region);
+}
+
+void
+gvn_context::number(jive::region * region)
+{
+	/* leaders of this region, along with the leaders of enclosing regions they shadow */
+	std::vector<std::pair<expression, jive::node*>> scope;
+	for (auto node : jive::topdown_traverser(region)) {
+		if (auto snode = dynamic_cast<jive::structural_node*>(node)) {
+			for (size_t n = 0; n < snode->nsubregions(); n++)
+				number(snode->subregion(n));
+
+			for (size_t n = 0; n < node->noutputs(); n++)
+				congruence_class(node->output(n));
+			continue;
+		}
+
+		expression e({node, {}});
+		for (size_t n = 0; n < node->ninputs(); n++)
+			e.operands.push_back(congruence_class(node->input(n)->origin()));
+
+		auto it = leaders_.find(e);
+		if (it == leaders_.end()) {
+			leaders_[e] = node;
+			scope.push_back({e, nullptr});
+			for (size_t n = 0; n < node->noutputs(); n++)
+				congruence_class(node->output(n));
+			continue;
+		}
+
+		/* constants are cheaper to recompute than to route into a region */
+		auto leader = it->second;
+		if (node->ninputs() == 0 && leader->region() != region) {
+			it->second = node;
+			scope.push_back({e, leader});
+			for (size_t n = 0; n < node->noutputs(); n++)
+				classes_[node->output(n)] = congruence_class(leader->output(n));
+			continue;
+		}
+
+		for (size_t n = 0; n < node->noutputs(); n++) {
+			auto output = available(leader->output(n), region);
+			node->output(n)->divert_users(output);
+			classes_.erase(node->output(n));
+		}
+		remove(node);
+	}
+
+	/* leaders of this region are not available in enclosing or sibling regions */
+	for (const auto & pair : scope) {
+		if (pair.second)
+			leaders_[pair.first] = pair.second;
+		else
+			leaders_.erase(pair.first);
+	}
+}
+
+}
+
+namespace jive {
+
+void
+gvn(jive::graph * graph)
+{
+	gvn_context context;
+	context.number(graph->root());
+}
+
+}
@@ -0,0 +1,233 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jive/opt/inlining.h>
+#include <jive/opt/route.h>
+#include <jive/rvsdg/graph.h>
+#include <jive/rvsdg/phi.h>
+#include <jive/rvsdg/substitution.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/types/function.h>
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace jive {
+
+static jive::lambda_node *
+trace(const jive::output * output, bool & recursive)
+{
+	if (auto node = output->node()) {
+		if (auto lambda = dynamic_cast<jive::lambda_node*>(node))
+			return lambda;
+
+		if (is<phi_op>(node)) {
+			auto phi = static_cast<const jive::structural_node*>(node);
+			return trace(phi->subregion(0)->result(output->index())->origin(), recursive);
+		}
+
+		return nullptr;
+	}
+
+	auto argument = static_cast<const jive::argument*>(output);
+	auto region = argument->region();
+	if (auto input = argument->input()) {
+		if (is<theta_op>(region->node()) && !is_invariant(static_cast<const theta_input*>(input)))
+			return nullptr;
+
+		return trace(input->origin(), recursive);
+	}
+
+	if (is<phi_op>(region->node())) {
+		recursive = true;
+		return trace(region->result(recvar_index(argument))->origin(), recursive);
+	}
+
+	return nullptr;
+}
+
+jive::lambda_node *
+callee(const jive::output * function, bool * recursive)
+{
+	bool is_recursive = false;
+	auto lambda = trace(function, is_recursive);
+	if (recursive)
+		*recursive = is_recursive;
+
+	return lambda;
+}
+
+/*
+	Returns a value equivalent to origin in region or an ancestor of region.
+	Values of a phi's subregion are replaced by the phi's operands or outputs.
+*/
+static jive::output *
+lift(jive::output * origin, const jive::region * region)
+{
+	if (is_ancestor(origin->region(), region))
+		return origin;
+
+	auto argument = dynamic_cast<jive::argument*>(origin);
+	if (!argument || !is<phi_op>(argument->region()->node()))
+		return nullptr;
+
+	if (argument->input())
+		return lift(argument->input()->origin(), region);
+
+	auto phi = argument->region()->node();
+	return lift(phi->output(recvar_index(argument)), region);
+}
+
+static jive::lambda_node *
+copy_lambda(const jive::lambda_node * lambda)
+{
+	std::vector<jive::output*> operands;
+	for (size_t n = 0; n < lambda->ninputs(); n++)
+		operands.push_back(lambda->input(n)->origin());
+
+	auto copy = static_cast<const jive::node*>(lambda)->copy(lambda->region(), operands);
+	return static_cast<jive::lambda_node*>(copy);
+}
+
+/*
+	Inlines the body of source, which is either the callee itself or a copy
+	of it, at the call site.
+*/
+static bool
+inline_call(jive::node * apply, jive::lambda_node * lambda, jive::lambda_node * source)
+{
+	auto region = apply->region();
+	auto nparameters = lambda->function_type().narguments();
+	bool nested = is_ancestor(lambda->subregion(), region);
+
+	/* context variables, taken from within the lambda for recursive calls in its own body */
+	std::vector<jive::output*> context;
+	for (size_t n = nparameters; n < source->subregion()->narguments(); n++) {
+		auto argument = lambda->subregion()->argument(n);
+		auto origin = nested ? argument : lift(argument->input()->origin(), region);
+		if (!origin)
+			return false;
+
+		context.push_back(origin);
+	}
+
+	/*
+		A region cannot be copied into one of its own descendants. Recursive calls
+		in the callee's body are inlined from a temporary copy of the callee.
+	*/
+	auto temporary = (source == lambda && nested) ? copy_lambda(lambda) : nullptr;
+	if (temporary)
+		source = temporary;
+
+	jive::substitution_map smap;
+	for (size_t n = 0; n < nparameters; n++)
+		smap.insert(source->subregion()->argument(n), apply->input(n+1)->origin());
+
+	for (size_t n = 0; n < context.size(); n++) {
+		auto argument = source->subregion()->argument(nparameters+n);
+		if (argument->nusers() != 0)
+			smap.insert(argument, route(context[n], region));
+	}
+
+	source->subregion()->copy(region, smap, false, false);
+
+	for (size_t n = 0; n < apply->noutputs(); n++) {
+		auto origin = smap.lookup(source->subregion()->result(n)->origin());
+		apply->output(n)->divert_users(origin);
+	}
+	remove(apply);
+
+	if (temporary)
+		remove(temporary);
+
+	return true;
+}
+
+bool
+inline_apply(jive::node * apply)
+{
+	JIVE_DEBUG_ASSERT(is<apply_op>(apply));
+
+	auto lambda = callee(apply->input(0)->origin());
+	if (!lambda)
+		return false;
+
+	return inline_call(apply, lambda, lambda);
+}
+
+static void
+collect_applies(
+	jive::region * region,
+	const std::unordered_set<const jive::node*> & snapshots,
+	std::vector<jive::node*> & applies)
+{
+	for (auto & node : region->nodes) {
+		if (snapshots.find(&node) != snapshots.end())
+			continue;
+
+		if (is<apply_op>(&node)) {
+			applies.push_back(&node);
+			continue;
+		}
+
+		if (auto snode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < snode->nsubregions(); n++)
+				collect_applies(snode->subregion(n), snapshots, applies);
+		}
+	}
+}
+
+void
+inlining(jive::graph * graph, size_t max_size, size_t max_depth)
+{
+	/*
+		Each round inlines the calls present at its beginning. Recursive callees
+		are inlined from copies of their original bodies, such that every round
+		unfolds recursive calls exactly once more.
+	*/
+	std::unordered_set<const jive::node*> copies;
+	std::unordered_map<jive::lambda_node*, jive::lambda_node*> snapshots;
+	for (size_t depth = 0; ; depth++) {
+		std::vector<jive::node*> applies;
+		collect_applies(graph->root(), copies, applies);
+
+		std::vector<std::pair<jive::node*, jive::lambda_node*>> calls;
+		for (const auto & apply : applies) {
+			bool recursive;
+			auto lambda = callee(apply->input(0)->origin(), &recursive);
+			if (!lambda || lambda->subregion()->nnodes() > max_size)
+				continue;
+
+			if (recursive) {
+				if (depth >= max_depth)
+					continue;
+
+				if (snapshots.find(lambda) == snapshots.end()) {
+					snapshots[lambda] = copy_lambda(lambda);
+					copies.insert(snapshots[lambda]);
+				}
+			}
+
+			calls.push_back({apply, lambda});
+		}
+
+		bool inlined = false;
+		for (const auto & call : calls) {
+			auto it = snapshots.find(call.second);
+			auto source = it != snapshots.end() ? it->second : call.second;
+			inlined |= inline_call(call.first, call.second, source);
+		}
+
+		if (!inlined)
+			break;
+	}
+
+	for (const auto & snapshot : snapshots)
+		remove(snapshot.second);
+
+	graph->prune();
+}
+
+}
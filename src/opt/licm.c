@@ -0,0 +1,126 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jive/opt/licm.h>
+#include <jive/rvsdg/graph.h>
+#include <jive/rvsdg/simple-node.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/rvsdg/traverser.h>
+
+namespace jive {
+
+static inline bool
+is_invariant_argument(const jive::output * output) noexcept
+{
+	auto argument = dynamic_cast<const jive::argument*>(output);
+	if (!argument)
+		return false;
+
+	auto input = dynamic_cast<const jive::theta_input*>(argument->input());
+	return input && is_invariant(input);
+}
+
+static inline bool
+is_constant(const jive::output * output) noexcept
+{
+	auto node = output->node();
+	return node
+	    && node->ninputs() == 0
+	    && dynamic_cast<const jive::simple_node*>(node)
+	    && !dynamic_cast<const jive::statetype*>(&output->type());
+}
+
+static bool
+is_hoistable(const jive::node * node) noexcept
+{
+	if (!dynamic_cast<const jive::simple_node*>(node)
+	|| node->ninputs() == 0
+	|| node->noutputs() == 0)
+		return false;
+
+	for (size_t n = 0; n < node->ninputs(); n++) {
+		auto input = node->input(n);
+		if (dynamic_cast<const jive::statetype*>(&input->type()))
+			return false;
+
+		if (!is_invariant_argument(input->origin()) && !is_constant(input->origin()))
+			return false;
+	}
+
+	for (size_t n = 0; n < node->noutputs(); n++) {
+		if (dynamic_cast<const jive::statetype*>(&node->output(n)->type()))
+			return false;
+	}
+
+	return true;
+}
+
+bool
+hoist_invariants(jive::theta_node * theta)
+{
+	/*
+		Constants are not hoisted by themselves, but copied in front of the
+		theta for the nodes that are. This keeps constant predicates visible
+		to the theta normal form.
+	*/
+	std::vector<jive::theta_output*> loopvars;
+	for (auto node : jive::topdown_traverser(theta->subregion())) {
+		if (!is_hoistable(node))
+			continue;
+
+		std::vector<jive::output*> operands;
+		for (size_t n = 0; n < node->ninputs(); n++) {
+			auto origin = node->input(n)->origin();
+			if (auto argument = dynamic_cast<const jive::argument*>(origin)) {
+				operands.push_back(argument->input()->origin());
+			} else {
+				auto constant = origin->node()->copy(theta->region(), {});
+				operands.push_back(constant->output(origin->index()));
+			}
+		}
+
+		/* the results of the hoisted node become invariant loop variables */
+		auto copy = node->copy(theta->region(), operands);
+		for (size_t n = 0; n < node->noutputs(); n++) {
+			auto lv = theta->add_loopvar(copy->output(n));
+			node->output(n)->divert_users(lv->argument());
+			loopvars.push_back(lv);
+		}
+		remove(node);
+	}
+
+	/* loop variables of values that were only used by other hoisted nodes */
+	for (auto it = loopvars.rbegin(); it != loopvars.rend(); it++) {
+		if ((*it)->argument()->nusers() == 1)
+			theta->remove_loopvar(*it);
+	}
+
+	return !loopvars.empty();
+}
+
+static void
+licm(jive::region * region)
+{
+	for (auto node : jive::topdown_traverser(region)) {
+		auto snode = dynamic_cast<jive::structural_node*>(node);
+		if (!snode)
+			continue;
+
+		for (size_t n = 0; n < snode->nsubregions(); n++)
+			licm(snode->subregion(n));
+
+		if (auto theta = dynamic_cast<jive::theta_node*>(snode))
+			hoist_invariants(theta);
+	}
+}
+
+void
+licm(jive::graph * graph)
+{
+	licm(graph->root());
+	graph->prune();
+}
+
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jive/opt/narrowing.h>
+#include <jive/rvsdg/graph.h>
+#include <jive/rvsdg/simple-node.h>
+#include <jive/rvsdg/structural-node.h>
+#include <jive/rvsdg/traverser.h>
+#include <jive/types/bitstring/arithmetic.h>
+#include <jive/types/bitstring/concat.h>
+#include <jive/types/bitstring/constant.h>
+#include <jive/types/bitstring/known-bits.h>
+#include <jive/types/bitstring/slice.h>
+
+namespace jive {
+
+/* the lower bits of the result only depend on the lower bits of the operands */
+static bool
+is_narrowable(const jive::node * node) noexcept
+{
+	auto & op = node->operation();
+	if (dynamic_cast<const bitunary_op*>(&op))
+		return true;
+
+	if (node->ninputs() != 2)
+		return false;
+
+	return dynamic_cast<const bitadd_op*>(&op)
+	    || dynamic_cast<const bitsub_op*>(&op)
+	    || dynamic_cast<const bitmul_op*>(&op)
+	    || dynamic_cast<const bitand_op*>(&op)
+	    || dynamic_cast<const bitor_op*>(&op)
+	    || dynamic_cast<const bitxor_op*>(&op);
+}
+
+static void
+narrow(jive::node * node, jive::known_bits & bits)
+{
+	auto output = node->output(0);
+	auto value = bits.value(output);
+	if (value.is_known()) {
+		output->divert_users(create_bitconstant(node->region(), value));
+		return;
+	}
+
+	size_t width = value.nbits();
+	while (value[width-1] == '0' || value[width-1] == '1')
+		width--;
+
+	if (width == value.nbits() || !is_narrowable(node))
+		return;
+
+	std::vector<jive::output*> operands;
+	for (size_t n = 0; n < node->ninputs(); n++)
+		operands.push_back(jive_bitslice(node->input(n)->origin(), 0, width));
+
+	std::unique_ptr<jive::simple_op> op;
+	if (auto uop = dynamic_cast<const bitunary_op*>(&node->operation()))
+		op = uop->create(width);
+	else
+		op = static_cast<const bitbinary_op*>(&node->operation())->create(width);
+
+	auto low = simple_node::create_normalized(node->region(), *op, operands)[0];
+	auto high = create_bitconstant(node->region(), value.slice(width, value.nbits()));
+	output->divert_users(jive_bitconcat({low, high}));
+}
+
+static void
+narrow(jive::region * region, jive::known_bits & bits)
+{
+	for (auto node : jive::topdown_traverser(region)) {
+		if (auto snode = dynamic_cast<jive::structural_node*>(node)) {
+			for (size_t n = 0; n < snode->nsubregions(); n++)
+				narrow(snode->subregion(n), bits);
+			continue;
+		}
+
+		if (node->ninputs() == 0 || node->noutputs() != 1
+		|| !dynamic_cast<const bittype*>(&node->output(0)->type()))
+			continue;
+
+		narrow(node, bits);
+	}
+}
+
+void
+narrow(jive::graph * graph)
+{
+	jive::known_bits bits(graph);
+	narrow(graph->root(), bits);
+	graph->prune();
+}
+
+}
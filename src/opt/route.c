@@ -0,0 +1,51 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jive/opt/route.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/types/function.h>
+
+namespace jive {
+
+bool
+is_ancestor(const jive::region * ancestor, const jive::region * region) noexcept
+{
+	while (region) {
+		if (region == ancestor)
+			return true;
+
+		region = region->node() ? region->node()->region() : nullptr;
+	}
+
+	return false;
+}
+
+jive::output *
+route(jive::output * origin, jive::region * region)
+{
+	JIVE_DEBUG_ASSERT(is_ancestor(origin->region(), region));
+
+	if (origin->region() == region)
+		return origin;
+
+	auto node = region->node();
+	origin = route(origin, node->region());
+
+	if (auto gamma = dynamic_cast<jive::gamma_node*>(node)) {
+		gamma->add_entryvar(origin);
+	} else if (auto theta = dynamic_cast<jive::theta_node*>(node)) {
+		theta->add_loopvar(origin);
+	} else if (auto lambda = dynamic_cast<jive::lambda_node*>(node)) {
+		lambda->add_dependency(origin);
+	} else {
+		auto input = node->add_input(origin->type(), origin);
+		region->add_argument(input, origin->type());
+	}
+
+	return region->argument(region->narguments()-1);
+}
+
+}
@@ -0,0 +1,271 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jive/opt/unroll.h>
+#include <jive/rvsdg/control.h>
+#include <jive/rvsdg/graph.h>
+#include <jive/rvsdg/substitution.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/rvsdg/traverser.h>
+#include <jive/types/bitstring/bitoperation-classes.h>
+#include <jive/types/bitstring/constant.h>
+
+namespace jive {
+
+/* maximum number of iterations that are simulated to find the trip count */
+static constexpr size_t max_trips = 1 << 16;
+
+static const jive::bitvalue_repr *
+constant_value(const jive::output * output)
+{
+	auto node = jive::producer(output);
+	if (!is<bitconstant_op>(node))
+		return nullptr;
+
+	return &static_cast<const bitconstant_op*>(&node->operation())->value();
+}
+
+/*
+	An operand of the loop's comparison: either a constant, or an induction
+	variable before (argument) or after (update) its update.
+*/
+struct induction_operand {
+	const jive::bitvalue_repr * constant;
+	const jive::node * update;
+	bool updated;
+};
+
+static bool
+is_induction_update(const jive::node * node, const jive::argument * argument)
+{
+	if (!node || !dynamic_cast<const bitbinary_op*>(&node->operation()) || node->ninputs() != 2)
+		return false;
+
+	auto o0 = node->input(0)->origin();
+	auto o1 = node->input(1)->origin();
+	return (o0 == argument && constant_value(o1)) || (o1 == argument && constant_value(o0));
+}
+
+static bool
+classify(const jive::theta_node * theta, const jive::output * origin, induction_operand & operand)
+{
+	operand = {constant_value(origin), nullptr, false};
+	if (operand.constant)
+		return true;
+
+	auto argument = dynamic_cast<const jive::argument*>(origin);
+	if (argument && argument->region() == theta->subregion()) {
+		auto update = theta->subregion()->result(argument->index()+1)->origin()->node();
+		if (!is_induction_update(update, argument))
+			return false;
+
+		operand.update = update;
+		return true;
+	}
+
+	auto node = origin->node();
+	if (node && node->region() == theta->subregion()) {
+		for (size_t n = 0; n < node->ninputs(); n++) {
+			auto argument = dynamic_cast<const jive::argument*>(node->input(n)->origin());
+			if (argument
+			&& theta->subregion()->result(argument->index()+1)->origin() == origin
+			&& is_induction_update(node, argument)) {
+				operand = {nullptr, node, true};
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+size_t
+trip_count(const jive::theta_node * theta, size_t max)
+{
+	auto match = theta->predicate()->origin()->node();
+	if (!is<match_op>(match))
+		return 0;
+
+	auto compare = match->input(0)->origin()->node();
+	if (!compare || !dynamic_cast<const bitcompare_op*>(&compare->operation()))
+		return 0;
+
+	induction_operand operands[2];
+	if (!classify(theta, compare->input(0)->origin(), operands[0])
+	|| !classify(theta, compare->input(1)->origin(), operands[1]))
+		return 0;
+
+	auto & iv = operands[0].update ? operands[0] : operands[1];
+	if (!iv.update || (operands[0].update && operands[1].update))
+		return 0;
+
+	/* the induction variable's argument is the non-constant operand of its update */
+	auto update = iv.update;
+	size_t index = constant_value(update->input(0)->origin()) ? 1 : 0;
+	auto argument = static_cast<const jive::argument*>(update->input(index)->origin());
+	auto init = constant_value(argument->input()->origin());
+	if (!init)
+		return 0;
+
+	auto step = constant_value(update->input(1-index)->origin());
+	auto & update_op = *static_cast<const bitbinary_op*>(&update->operation());
+	auto & compare_op = *static_cast<const bitcompare_op*>(&compare->operation());
+	auto & match_op = *static_cast<const jive::match_op*>(&match->operation());
+
+	jive::bitvalue_repr value = *init;
+	for (size_t count = 1; count <= max; count++) {
+		auto next = index == 0
+			? update_op.reduce_constants(value, *step)
+			: update_op.reduce_constants(*step, value);
+
+		auto operand_value = [&](const induction_operand & operand) -> const jive::bitvalue_repr &
+		{
+			if (operand.constant)
+				return *operand.constant;
+
+			return operand.updated ? next : value;
+		};
+
+		auto result = compare_op.reduce_constants(operand_value(operands[0]),
+			operand_value(operands[1]));
+		if (result == compare_result::undecidable)
+			return 0;
+
+		if (match_op.alternative(result == compare_result::static_true ? 1 : 0) == 0)
+			return count;
+
+		value = next;
+	}
+
+	return 0;
+}
+
+/*
+	Copies the body of theta in front of it. Returns the values of the loop
+	variables after the iterations.
+*/
+static std::vector<jive::output*>
+peel(const jive::theta_node * theta, std::vector<jive::output*> values, size_t niterations)
+{
+	auto subregion = theta->subregion();
+	for (size_t i = 0; i < niterations; i++) {
+		jive::substitution_map smap;
+		for (size_t n = 0; n < subregion->narguments(); n++)
+			smap.insert(subregion->argument(n), values[n]);
+
+		subregion->copy(theta->region(), smap, false, false);
+
+		for (size_t n = 0; n < subregion->narguments(); n++)
+			values[n] = smap.lookup(subregion->result(n+1)->origin());
+	}
+
+	return values;
+}
+
+static void
+unroll_full(jive::theta_node * theta, size_t niterations)
+{
+	std::vector<jive::output*> values;
+	for (size_t n = 0; n < theta->ninputs(); n++)
+		values.push_back(theta->input(n)->origin());
+
+	values = peel(theta, values, niterations);
+	for (size_t n = 0; n < theta->noutputs(); n++)
+		theta->output(n)->divert_users(values[n]);
+
+	remove(theta);
+}
+
+static void
+unroll_partial(jive::theta_node * theta, size_t niterations, size_t factor)
+{
+	/* peel the residual iterations */
+	std::vector<jive::output*> values;
+	for (size_t n = 0; n < theta->ninputs(); n++)
+		values.push_back(theta->input(n)->origin());
+
+	values = peel(theta, values, niterations % factor);
+	for (size_t n = 0; n < theta->ninputs(); n++)
+		theta->input(n)->divert_to(values[n]);
+
+	/* replicate the body from a copy of the original loop */
+	auto copy = static_cast<jive::theta_node*>(static_cast<const jive::node*>(theta)->copy(
+		theta->region(), values));
+	auto source = copy->subregion();
+	auto subregion = theta->subregion();
+
+	std::vector<jive::output*> results;
+	for (size_t n = 0; n < subregion->nresults(); n++)
+		results.push_back(subregion->result(n)->origin());
+
+	for (size_t i = 1; i < factor; i++) {
+		jive::substitution_map smap;
+		for (size_t n = 0; n < source->narguments(); n++)
+			smap.insert(source->argument(n), results[n+1]);
+
+		source->copy(subregion, smap, false, false);
+
+		for (size_t n = 0; n < source->nresults(); n++)
+			results[n] = smap.lookup(source->result(n)->origin());
+	}
+
+	for (size_t n = 0; n < subregion->nresults(); n++)
+		subregion->result(n)->divert_to(results[n]);
+
+	remove(copy);
+}
+
+bool
+unroll(jive::theta_node * theta, size_t factor)
+{
+	if (factor < 2)
+		return false;
+
+	auto niterations = trip_count(theta, max_trips);
+	if (niterations == 0)
+		return false;
+
+	if (niterations <= factor)
+		unroll_full(theta, niterations);
+	else
+		unroll_partial(theta, niterations, factor);
+
+	return true;
+}
+
+static void
+unroll(jive::region * region, size_t max_size, size_t factor)
+{
+	for (auto node : jive::topdown_traverser(region)) {
+		auto snode = dynamic_cast<jive::structural_node*>(node);
+		if (!snode)
+			continue;
+
+		for (size_t n = 0; n < snode->nsubregions(); n++)
+			unroll(snode->subregion(n), max_size, factor);
+
+		auto theta = dynamic_cast<jive::theta_node*>(snode);
+		if (!theta)
+			continue;
+
+		auto niterations = trip_count(theta, max_trips);
+		if (niterations == 0)
+			continue;
+
+		if (niterations * nnodes(theta->subregion()) <= max_size)
+			unroll_full(theta, niterations);
+		else if (factor > 1 && niterations > factor)
+			unroll_partial(theta, niterations, factor);
+	}
+}
+
+void
+unroll(jive::graph * graph, size_t max_size, size_t factor)
+{
+	unroll(graph->root(), max_size, factor);
+	graph->prune();
+}
+
+}
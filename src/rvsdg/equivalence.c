@@ -7,16 +7,13 @@
 #include <unordered_map>
 
 #include <jive/rvsdg/equivalence.h>
+#include <jive/rvsdg/structural-node.h>
 
 class jive_node_equiv_entry {
 public:
 	const jive::node * first;
 	const jive::node * second;
 	bool pending;
-	struct {
-		jive_node_equiv_entry * prev;
-		jive_node_equiv_entry * next;
-	} hash_chain;
 
 private:
 	jive::detail::intrusive_list_anchor<
@@ -35,36 +32,27 @@ typedef jive::detail::intrusive_list<
 	jive_node_equiv_entry::pending_accessor
 > pending_list;
 
+/*
+	Entries are stored by value: references to elements of an unordered_map
+	remain valid on rehashing, which keeps the intrusive pending list intact.
+*/
 class jive_equiv_state {
 public:
 	pending_list pending;
-	std::unordered_map<const jive::node *, jive_node_equiv_entry*> node_mapping;
+	std::unordered_map<const jive::node *, jive_node_equiv_entry> node_mapping;
 };
 
-static void
-jive_equiv_state_fini(jive_equiv_state * self)
-{
-	while (self->node_mapping.size()) {
-		jive_node_equiv_entry * entry = self->node_mapping.begin()->second;
-		self->node_mapping.erase(self->node_mapping.begin());
-		delete entry;
-	}
-}
-
 static jive_node_equiv_entry *
 jive_equiv_state_lookup(jive_equiv_state * self, const jive::node * node)
 {
-	jive_node_equiv_entry * entry;
-	auto i = self->node_mapping.find(node);
-	if (i == self->node_mapping.end()) {
-		entry = new jive_node_equiv_entry;
+	auto result = self->node_mapping.emplace(node, jive_node_equiv_entry());
+	jive_node_equiv_entry * entry = &result.first->second;
+	if (result.second) {
 		entry->first = node;
 		entry->second = 0;
 		entry->pending = true;
-		self->node_mapping[node] = entry;
 		self->pending.push_back(entry);
-	} else
-		entry = i->second;
+	}
 
 	return entry;
 }
@@ -77,6 +65,26 @@ jive_equiv_state_mark_verified(jive_equiv_state * self, jive_node_equiv_entry *
 	self->pending.erase(entry);
 }
 
+static bool
+jive_equiv_state_check_origins(
+	jive_equiv_state * self,
+	const jive::output * o1,
+	const jive::output * o2)
+{
+	if (o1->index() != o2->index() || o1->type() != o2->type())
+		return false;
+
+	if (!o1->node() || !o2->node())
+		return !o1->node() && !o2->node();
+
+	jive_node_equiv_entry * entry = jive_equiv_state_lookup(self, o1->node());
+	if (entry->second && entry->second != o2->node())
+		return false;
+	entry->second = o2->node();
+
+	return true;
+}
+
 static bool
 jive_equiv_state_check_node(jive_equiv_state * self, const jive::node * n1, const jive::node * n2)
 {
@@ -86,64 +94,115 @@ jive_equiv_state_check_node(jive_equiv_state * self, const jive::node * n1, cons
 	if (n1->ninputs() != n2->ninputs()) {
 		return false;
 	}
-	if (n1->ninputs() != n2->ninputs()) {
-		return false;
-	}
 	if (n1->operation() != n2->operation()) {
 		return false;
 	}
 
-	size_t n = 0;
-	for (n = 0; n < n1->ninputs(); ++n) {
+	for (size_t n = 0; n < n1->ninputs(); ++n) {
 		auto o1 = n1->input(n)->origin();
 		auto o2 = n2->input(n)->origin();
-		
-		jive_node_equiv_entry * entry = jive_equiv_state_lookup(self, o1->node());
-		if (entry->second && entry->second != o2->node())
+		if (!jive_equiv_state_check_origins(self, o1, o2))
 			return false;
-		entry->second = o2->node();
 	}
-	
+
+	/*
+		Nodes within subregions are matched through the results of the
+		subregions, the hash is only used to reject mismatches early.
+	*/
+	auto s1 = dynamic_cast<const jive::structural_node*>(n1);
+	auto s2 = dynamic_cast<const jive::structural_node*>(n2);
+	if (!s1 || !s2)
+		return !s1 && !s2;
+
+	if (s1->nsubregions() != s2->nsubregions())
+		return false;
+
+	for (size_t r = 0; r < s1->nsubregions(); r++) {
+		auto r1 = s1->subregion(r);
+		auto r2 = s2->subregion(r);
+		if (r1->narguments() != r2->narguments() || r1->nresults() != r2->nresults())
+			return false;
+
+		for (size_t n = 0; n < r1->nresults(); n++) {
+			auto o1 = r1->result(n)->origin();
+			auto o2 = r2->result(n)->origin();
+			if (!jive_equiv_state_check_origins(self, o1, o2))
+				return false;
+		}
+	}
+
 	return true;
 }
 
+static bool
+jive_equiv_state_verify(jive_equiv_state * self)
+{
+	bool satisfied = true;
+	while (satisfied && self->pending.first()) {
+		auto entry = self->pending.first();
+		satisfied = jive_equiv_state_check_node(self, entry->first, entry->second);
+		jive_equiv_state_mark_verified(self, entry);
+	}
+
+	return satisfied;
+}
+
 bool
 jive_graphs_equivalent(
 	jive::graph * graph1, jive::graph * graph2,
 	size_t ncheck, jive::node * const check1[], jive::node * const check2[],
 	size_t nassumed, jive::node * const ass1[], jive::node * const ass2[])
 {
-	jive_equiv_state state;
+	/*
+		Without assumptions, structurally equivalent nodes have equal
+		hashes. Reject mismatches before setting up the matcher.
+	*/
+	if (nassumed == 0) {
+		for (size_t n = 0; n < ncheck; ++n) {
+			if (check1[n]->structural_hash() != check2[n]->structural_hash())
+				return false;
+		}
+	}
 
-	bool satisfied = true;
+	jive_equiv_state state;
 	size_t n;
 	
 	for (n = 0; n < nassumed; ++n) {
 		jive_node_equiv_entry * entry = jive_equiv_state_lookup(&state, ass1[n]);
-		if (entry->second != 0 && entry->second != ass2[n]) {
-			satisfied = false;
-			break;
-		}
+		if (entry->second != 0 && entry->second != ass2[n])
+			return false;
 		entry->second = ass2[n];
 		jive_equiv_state_mark_verified(&state, entry);
 	}
 	
 	for (n = 0; n < ncheck; ++n) {
 		jive_node_equiv_entry * entry = jive_equiv_state_lookup(&state, check1[n]);
-		if (entry->second != 0 && entry->second != check2[n]) {
-			satisfied = false;
-			break;
-		}
+		if (entry->second != 0 && entry->second != check2[n])
+			return false;
 		entry->second = check2[n];
 	}
 	
-	while (satisfied && state.pending.first()) {
-		auto entry = state.pending.first();
-		satisfied = jive_equiv_state_check_node(&state, entry->first, entry->second);
-		jive_equiv_state_mark_verified(&state, entry);
+	return jive_equiv_state_verify(&state);
+}
+
+bool
+jive_graphs_equivalent(jive::graph * graph1, jive::graph * graph2)
+{
+	auto root1 = graph1->root();
+	auto root2 = graph2->root();
+	if (root1->narguments() != root2->narguments() || root1->nresults() != root2->nresults())
+		return false;
+
+	if (jive::structural_hash(root1) != jive::structural_hash(root2))
+		return false;
+
+	jive_equiv_state state;
+	for (size_t n = 0; n < root1->nresults(); n++) {
+		auto o1 = root1->result(n)->origin();
+		auto o2 = root2->result(n)->origin();
+		if (!jive_equiv_state_check_origins(&state, o1, o2))
+			return false;
 	}
-	
-	jive_equiv_state_fini(&state);
-	
-	return satisfied;
+
+	return jive_equiv_state_verify(&state);
 }
@@ -13,6 +13,7 @@
 #include <jive/rvsdg/gamma.h>
 #include <jive/rvsdg/graph.h>
 #include <jive/rvsdg/region.h>
+#include <jive/rvsdg/simple-node.h>
 #include <jive/rvsdg/substitution.h>
 #include <jive/rvsdg/traverser.h>
 #include <jive/util/strfmt.h>
@@ -144,6 +145,205 @@ perform_control_constant_reduction(std::unordered_set<jive::structural_output*>
 	}
 }
 
+/* true if other is reachable from the outputs of node */
+static bool
+reaches(const jive::node * node, const jive::node * other)
+{
+	std::unordered_set<const jive::node*> visited({node});
+	std::vector<const jive::node*> stack({node});
+	while (!stack.empty()) {
+		auto n = stack.back();
+		stack.pop_back();
+
+		for (size_t i = 0; i < n->noutputs(); i++) {
+			for (const auto & user : *n->output(i)) {
+				auto successor = user->node();
+				if (successor == other)
+					return true;
+
+				if (successor && visited.insert(successor).second)
+					stack.push_back(successor);
+			}
+		}
+	}
+
+	return false;
+}
+
+static jive::gamma_node *
+is_fusable(const jive::gamma_node * gamma)
+{
+	for (const auto & user : *gamma->predicate()->origin()) {
+		auto other = dynamic_cast<jive::gamma_node*>(user->node());
+		if (!other || other == gamma || user != other->predicate())
+			continue;
+
+		if (!reaches(gamma, other) && !reaches(other, gamma))
+			return other;
+	}
+
+	return nullptr;
+}
+
+static jive::gamma_input *
+find_entryvar(const jive::gamma_node * gamma, const jive::output * origin)
+{
+	for (auto it = gamma->begin_entryvar(); it != gamma->end_entryvar(); it++) {
+		if (it->origin() == origin)
+			return it.input();
+	}
+
+	return nullptr;
+}
+
+static void
+perform_fusion(jive::gamma_node * gamma, jive::gamma_node * other)
+{
+	std::vector<jive::substitution_map> smap(gamma->nsubregions());
+	for (auto it = other->begin_entryvar(); it != other->end_entryvar(); it++) {
+		auto ev = find_entryvar(gamma, it->origin());
+		if (!ev)
+			ev = gamma->add_entryvar(it->origin());
+
+		for (size_t n = 0; n < gamma->nsubregions(); n++)
+			smap[n].insert(it->argument(n), ev->argument(n));
+	}
+
+	for (size_t n = 0; n < gamma->nsubregions(); n++)
+		other->subregion(n)->copy(gamma->subregion(n), smap[n], false, false);
+
+	for (auto it = other->begin_exitvar(); it != other->end_exitvar(); it++) {
+		std::vector<jive::output*> values;
+		for (size_t n = 0; n < gamma->nsubregions(); n++)
+			values.push_back(smap[n].lookup(it->result(n)->origin()));
+
+		it->divert_users(gamma->add_exitvar(values));
+	}
+
+	remove(other);
+}
+
+static bool
+is_constant(const jive::output * output) noexcept
+{
+	auto node = output->node();
+	return node && node->ninputs() == 0 && dynamic_cast<const jive::simple_node*>(node);
+}
+
+static bool
+is_hoistable(const jive::node * node) noexcept
+{
+	if (!dynamic_cast<const jive::simple_node*>(node) || node->noutputs() == 0)
+		return false;
+
+	bool has_argument = false;
+	for (size_t n = 0; n < node->ninputs(); n++) {
+		auto origin = node->input(n)->origin();
+		if (dynamic_cast<const jive::statetype*>(&origin->type()))
+			return false;
+
+		if (dynamic_cast<const jive::argument*>(origin))
+			has_argument = true;
+		else if (!is_constant(origin))
+			return false;
+	}
+
+	for (size_t n = 0; n < node->noutputs(); n++) {
+		if (dynamic_cast<const jive::statetype*>(&node->output(n)->type()))
+			return false;
+	}
+
+	return has_argument;
+}
+
+/* finds the node in alternative that corresponds to node of alternative zero */
+static jive::node *
+find_equivalent(const jive::node * node, size_t alternative)
+{
+	auto corresponds = [&](const jive::output * origin, const jive::output * other)
+	{
+		if (auto argument = dynamic_cast<const jive::argument*>(origin)) {
+			auto input = static_cast<const jive::gamma_input*>(argument->input());
+			return other == input->argument(alternative);
+		}
+
+		return is_constant(other)
+		    && other->index() == origin->index()
+		    && other->node()->operation() == origin->node()->operation();
+	};
+
+	size_t index = 0;
+	while (!dynamic_cast<const jive::argument*>(node->input(index)->origin()))
+		index++;
+
+	auto argument = static_cast<const jive::argument*>(node->input(index)->origin());
+	auto input = static_cast<const jive::gamma_input*>(argument->input());
+	for (const auto & user : *input->argument(alternative)) {
+		auto other = user->node();
+		if (!other
+		|| other->ninputs() != node->ninputs()
+		|| other->operation() != node->operation())
+			continue;
+
+		size_t n;
+		for (n = 0; n < node->ninputs(); n++) {
+			if (!corresponds(node->input(n)->origin(), other->input(n)->origin()))
+				break;
+		}
+
+		if (n == node->ninputs())
+			return other;
+	}
+
+	return nullptr;
+}
+
+static bool
+perform_hoisting(jive::gamma_node * gamma)
+{
+	bool was_normalized = true;
+	for (auto node : jive::topdown_traverser(gamma->subregion(0))) {
+		if (!is_hoistable(node))
+			continue;
+
+		std::vector<jive::node*> nodes({node});
+		for (size_t n = 1; n < gamma->nsubregions(); n++) {
+			auto other = find_equivalent(node, n);
+			if (!other)
+				break;
+
+			nodes.push_back(other);
+		}
+		if (nodes.size() != gamma->nsubregions())
+			continue;
+
+		std::vector<jive::output*> operands;
+		for (size_t n = 0; n < node->ninputs(); n++) {
+			auto origin = node->input(n)->origin();
+			if (auto argument = dynamic_cast<const jive::argument*>(origin)) {
+				operands.push_back(argument->input()->origin());
+			} else {
+				auto constant = origin->node()->copy(gamma->region(), {});
+				operands.push_back(constant->output(origin->index()));
+			}
+		}
+
+		auto copy = node->copy(gamma->region(), operands);
+		for (size_t n = 0; n < copy->noutputs(); n++) {
+			auto ev = gamma->add_entryvar(copy->output(n));
+			for (size_t r = 0; r < nodes.size(); r++)
+				nodes[r]->output(n)->divert_users(ev->argument(r));
+		}
+
+		for (const auto & other : nodes)
+			remove(other);
+
+		was_normalized = false;
+	}
+
+	return was_normalized;
+}
+
 gamma_normal_form::~gamma_normal_form() noexcept
 {}
 
@@ -155,11 +355,15 @@ gamma_normal_form::gamma_normal_form(
 , enable_predicate_reduction_(false)
 , enable_invariant_reduction_(false)
 , enable_control_constant_reduction_(false)
+, enable_fusion_(false)
+, enable_hoisting_(false)
 {
 	if (auto p = dynamic_cast<gamma_normal_form *>(parent)) {
 		enable_predicate_reduction_ = p->enable_predicate_reduction_;
 		enable_invariant_reduction_ = p->enable_invariant_reduction_;
 		enable_control_constant_reduction_ = p->enable_control_constant_reduction_;
+		enable_fusion_ = p->enable_fusion_;
+		enable_hoisting_ = p->enable_hoisting_;
 	}
 }
 
@@ -187,6 +391,16 @@ gamma_normal_form::normalize_node(jive::node * node_) const
 		was_normalized = false;
 	}
 
+	if (get_hoisting())
+		was_normalized &= perform_hoisting(node);
+
+	if (get_fusion()) {
+		while (auto other = is_fusable(node)) {
+			perform_fusion(node, other);
+			was_normalized = false;
+		}
+	}
+
 	return was_normalized;
 }
 
@@ -233,6 +447,32 @@ gamma_normal_form::set_control_constant_reduction(bool enable)
 		graph()->mark_denormalized();
 }
 
+void
+gamma_normal_form::set_fusion(bool enable)
+{
+	if (enable_fusion_ == enable)
+		return;
+
+	children_set<gamma_normal_form, &gamma_normal_form::set_fusion>(enable);
+
+	enable_fusion_ = enable;
+	if (enable && get_mutable())
+		graph()->mark_denormalized();
+}
+
+void
+gamma_normal_form::set_hoisting(bool enable)
+{
+	if (enable_hoisting_ == enable)
+		return;
+
+	children_set<gamma_normal_form, &gamma_normal_form::set_hoisting>(enable);
+
+	enable_hoisting_ = enable;
+	if (enable && get_mutable())
+		graph()->mark_denormalized();
+}
+
 /* gamma operation */
 
 gamma_op::~gamma_op() noexcept
@@ -13,8 +13,7 @@
 #include <jive/rvsdg/region.h>
 #include <jive/rvsdg/substitution.h>
 #include <jive/rvsdg/tracker.h>
-#include <jive/types/record.h>
-#include <jive/types/union.h>
+#include <jive/types/declarations.h>
 
 namespace jive {
 
@@ -65,18 +64,41 @@ graph::~graph()
 	JIVE_DEBUG_ASSERT(!has_active_trackers(this));
 
 	delete root_;
-	unregister_unndeclarations(this);
 }
 
 graph::graph()
 	: normalized_(false)
 	, root_(new jive::region(nullptr, this))
+	, declarations_(new jive::declaration_store())
 {}
 
+void
+graph::normalize()
+{
+	if (!normalized_) {
+		while (auto region = dirty_regions_.first()) {
+			dirty_regions_.erase(region);
+			region->dirty_ = false;
+			region->clear_dirty();
+		}
+
+		root()->normalize(true);
+		normalized_ = true;
+	}
+
+	while (auto region = dirty_regions_.first()) {
+		dirty_regions_.erase(region);
+		region->dirty_ = false;
+		region->normalize_dirty();
+	}
+}
+
 std::unique_ptr<jive::graph>
 graph::copy() const
 {
 	jive::substitution_map smap;
+	smap.reserve(jive::nnodes(root()) + root()->narguments());
+
 	std::unique_ptr<jive::graph> graph(new jive::graph());
 	root()->copy(graph->root(), smap, true, true);
 	return graph;
@@ -6,6 +6,9 @@
 
 #include <string.h>
 
+#include <functional>
+#include <string>
+
 #include <jive/common.h>
 
 #include <jive/rvsdg/control.h>
@@ -14,8 +17,10 @@
 #include <jive/rvsdg/region.h>
 #include <jive/rvsdg/resource.h>
 #include <jive/rvsdg/simple-node.h>
+#include <jive/rvsdg/structural-node.h>
 #include <jive/rvsdg/substitution.h>
 #include <jive/rvsdg/theta.h>
+#include <jive/util/hash.h>
 
 namespace jive {
 
@@ -23,7 +28,8 @@ namespace jive {
 
 input::~input() noexcept
 {
-	origin()->remove_user(this);
+	if (origin_)
+		origin()->remove_user(this);
 }
 
 input::input(
@@ -69,7 +75,17 @@ input::divert_to(jive::output * new_origin)
 	new_origin->add_user(this);
 
 	if (node()) node()->recompute_depth();
-	region()->graph()->mark_denormalized();
+	auto hnode = node() ? node() : region()->node();
+	if (hnode) {
+		hnode->invalidate_structural_hash();
+		hnode->region()->mark_dirty(hnode);
+	}
+
+	/* reductions of the producer can depend on its users */
+	auto pnode = old_origin->node() ? old_origin->node() : old_origin->region()->node();
+	if (pnode)
+		pnode->region()->mark_dirty(pnode);
+
 	on_input_change(this, old_origin, new_origin);
 }
 
@@ -138,7 +154,12 @@ register_node_normal_form(void)
 namespace jive {
 
 node::node(std::unique_ptr<jive::operation> op, jive::region * region)
-	: depth_(0)
+	: dirty_(false)
+	, swept_(false)
+	, depth_(0)
+	, hash_(0)
+	, hash_valid_(false)
+	, normal_form_(nullptr)
 	, graph_(region->graph())
 	, region_(region)
 	, operation_(std::move(op))
@@ -146,6 +167,7 @@ node::node(std::unique_ptr<jive::operation> op, jive::region * region)
 	region->bottom_nodes.push_back(this);
 	region->top_nodes.push_back(this);
 	region->nodes.push_back(this);
+	region->mark_dirty(this);
 }
 
 node::~node()
@@ -157,6 +179,8 @@ node::~node()
 		region()->top_nodes.erase(this);
 	inputs_.clear();
 
+	if (dirty_)
+		region()->dirty_nodes_.erase(this);
 	region()->nodes.erase(this);
 }
 
@@ -169,6 +193,8 @@ node::add_input(std::unique_ptr<jive::input> input)
 	}
 
 	inputs_.push_back(std::move(input));
+	invalidate_structural_hash();
+	region()->mark_dirty(this);
 
 	auto producer = inputs_.back().get()->origin()->node();
 	auto new_depth = producer ? producer->depth()+1 : 0;
@@ -188,6 +214,7 @@ node::remove_input(size_t index)
 		inputs_[n]->index_ = n;
 	}
 	inputs_.pop_back();
+	invalidate_structural_hash();
 
 	/* recompute depth */
 	if (producer) {
@@ -215,6 +242,7 @@ node::remove_output(size_t index)
 		outputs_[n]->index_ = n;
 	}
 	outputs_.pop_back();
+	invalidate_structural_hash();
 }
 
 void
@@ -246,6 +274,115 @@ node::recompute_depth() noexcept
 	}
 }
 
+jive::node_normal_form *
+node::resolve_normal_form() const
+{
+	normal_form_ = graph()->node_normal_form(typeid(operation()));
+	return normal_form_;
+}
+
+static size_t
+compute_structural_hash(const jive::node * node)
+{
+	using detail::combine_hash;
+
+	size_t hash = node->operation().hash();
+	hash = combine_hash(hash, node->ninputs());
+	hash = combine_hash(hash, node->noutputs());
+
+	for (size_t n = 0; n < node->ninputs(); n++)
+		hash = combine_hash(hash, structural_hash(node->input(n)->origin()));
+
+	for (size_t n = 0; n < node->noutputs(); n++)
+		hash = combine_hash(hash, node->output(n)->type().hash());
+
+	if (auto snode = dynamic_cast<const jive::structural_node*>(node)) {
+		for (size_t n = 0; n < snode->nsubregions(); n++)
+			hash = combine_hash(hash, structural_hash(snode->subregion(n)));
+	}
+
+	return hash;
+}
+
+size_t
+node::structural_hash() const
+{
+	if (hash_valid_)
+		return hash_;
+
+	/*
+		Compute the hashes of all predecessors first. The stack is
+		explicit as dependency chains can be very long.
+	*/
+	std::vector<const jive::node*> stack({this});
+	auto push_producer = [&](const jive::output * origin)
+	{
+		auto producer = origin->node();
+		if (!producer || producer->hash_valid_)
+			return false;
+
+		stack.push_back(producer);
+		return true;
+	};
+
+	while (!stack.empty()) {
+		auto node = stack.back();
+		if (node->hash_valid_) {
+			stack.pop_back();
+			continue;
+		}
+
+		bool pending = false;
+		for (size_t n = 0; n < node->ninputs(); n++)
+			pending |= push_producer(node->input(n)->origin());
+
+		if (auto snode = dynamic_cast<const jive::structural_node*>(node)) {
+			for (size_t r = 0; r < snode->nsubregions(); r++) {
+				auto subregion = snode->subregion(r);
+				for (size_t n = 0; n < subregion->nresults(); n++)
+					pending |= push_producer(subregion->result(n)->origin());
+			}
+		}
+
+		if (pending)
+			continue;
+
+		node->hash_ = compute_structural_hash(node);
+		node->hash_valid_ = true;
+		stack.pop_back();
+	}
+
+	return hash_;
+}
+
+void
+node::invalidate_structural_hash()
+{
+	if (!hash_valid_)
+		return;
+
+	/*
+		A node's hash is only valid if the hashes of all its predecessors
+		are valid. Propagation can therefore stop at invalid nodes.
+	*/
+	std::vector<jive::node*> stack({this});
+	while (!stack.empty()) {
+		auto node = stack.back();
+		stack.pop_back();
+		if (!node->hash_valid_)
+			continue;
+
+		node->hash_valid_ = false;
+		for (size_t n = 0; n < node->noutputs(); n++) {
+			for (const auto & user : *node->output(n)) {
+				auto unode = user->node() ? user->node() : user->region()->node();
+				if (unode && unode->hash_valid_)
+					stack.push_back(unode);
+			}
+		}
+	}
+}
+
 jive::node *
 producer(const jive::output * output) noexcept
 {
@@ -265,11 +402,20 @@ producer(const jive::output * output) noexcept
 	return producer(argument->input()->origin());
 }
 
+size_t
+structural_hash(const jive::output * output)
+{
+	size_t hash = detail::combine_hash(output->type().hash(), output->index());
+	if (auto node = output->node())
+		hash = detail::combine_hash(hash, node->structural_hash());
+
+	return hash;
+}
+
 bool
 normalize(jive::node * node)
 {
-	auto nf = node->graph()->node_normal_form(typeid(node->operation()));
-	return nf->normalize_node(node);
+	return node->normal_form()->normalize_node(node);
 }
 
 }
@@ -49,6 +49,12 @@ port::copy() const
 operation::~operation() noexcept
 {}
 
+size_t
+operation::hash() const noexcept
+{
+	return typeid(*this).hash_code();
+}
+
 jive::node_normal_form *
 operation::normal_form(jive::graph * graph) noexcept
 {
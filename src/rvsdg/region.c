@@ -4,6 +4,9 @@
  * See COPYING for terms of redistribution.
  */
 
+#include <algorithm>
+#include <unordered_set>
+
 #include <jive/common.h>
 
 #include <jive/rvsdg/graph.h>
@@ -13,6 +16,7 @@
 #include <jive/rvsdg/structural-node.h>
 #include <jive/rvsdg/substitution.h>
 #include <jive/rvsdg/traverser.h>
+#include <jive/util/hash.h>
 
 namespace jive {
 
@@ -89,17 +93,22 @@ region::~region()
 
 	while (arguments_.size())
 		remove_argument(arguments_.size()-1);
+
+	if (dirty_)
+		graph()->dirty_regions_.erase(this);
 }
 
 region::region(jive::region * parent, jive::graph * graph)
-	: graph_(graph)
+	: dirty_(false)
+	, graph_(graph)
 	, node_(nullptr)
 {
 	on_region_create(this);
 }
 
 region::region(jive::structural_node * node)
-	: graph_(node->graph())
+	: dirty_(false)
+	, graph_(node->graph())
 	, node_(node)
 {
 	on_region_create(this);
@@ -110,6 +119,7 @@ region::add_argument(jive::structural_input * input, const jive::port & port)
 {
 	jive::argument * argument = new jive::argument(this, narguments(), input, port);
 	arguments_.push_back(argument);
+	if (node()) node()->invalidate_structural_hash();
 
 	on_output_create(argument);
 
@@ -128,6 +138,7 @@ region::remove_argument(size_t index)
 		arguments_[n]->index_ = n;
 	}
 	arguments_.pop_back();
+	if (node()) node()->invalidate_structural_hash();
 }
 
 jive::result *
@@ -135,6 +146,10 @@ region::add_result(jive::output * origin, structural_output * output, const jive
 {
 	jive::result * result = new jive::result(this, nresults(), origin, output, port);
 	results_.push_back(result);
+	if (node()) {
+		node()->invalidate_structural_hash();
+		node()->region()->mark_dirty(node());
+	}
 
 	if (origin->region() != this)
 		throw jive::compiler_error("Invalid region result");
@@ -156,6 +171,7 @@ region::remove_result(size_t index)
 		results_[n]->index_ = n;
 	}
 	results_.pop_back();
+	if (node()) node()->invalidate_structural_hash();
 }
 
 void
@@ -173,15 +189,24 @@ region::copy(
 {
 	smap.insert(this, target);
 
-	/* order nodes top-down */
-	std::vector<std::vector<const jive::node*>> context(nnodes());
-	for (const auto & node : nodes) {
-		JIVE_DEBUG_ASSERT(node.depth() < context.size());
-		context[node.depth()].push_back(&node);
-	}
+	/* order nodes top-down with a counting sort over their depths */
+	size_t maxdepth = 0;
+	for (const auto & node : nodes)
+		maxdepth = std::max(maxdepth, node.depth());
+
+	std::vector<size_t> offsets(maxdepth+2, 0);
+	for (const auto & node : nodes)
+		offsets[node.depth()+1]++;
+	for (size_t n = 1; n < offsets.size(); n++)
+		offsets[n] += offsets[n-1];
+
+	std::vector<const jive::node*> context(nnodes());
+	for (const auto & node : nodes)
+		context[offsets[node.depth()]++] = &node;
 
 	/* copy arguments */
 	if (copy_arguments) {
+		target->arguments_.reserve(target->narguments() + narguments());
 		for (size_t n = 0; n < narguments(); n++) {
 			auto narg = target->add_argument(smap.lookup(argument(n)->input()), argument(n)->type());
 			smap.insert(argument(n), narg);
@@ -189,15 +214,14 @@ region::copy(
 	}
 
 	/* copy nodes */
-	for (size_t n = 0; n < context.size(); n++) {
-		for (const auto node : context[n]) {
-			target = smap.lookup(node->region());
-			node->copy(target, smap);
-		}
+	for (const auto & node : context) {
+		JIVE_DEBUG_ASSERT(node->region() == this);
+		node->copy(target, smap);
 	}
 
 	/* copy results */
 	if (copy_results) {
+		target->results_.reserve(target->nresults() + nresults());
 		for (size_t n = 0; n < nresults(); n++) {
 			auto origin = smap.lookup(result(n)->origin());
 			if (!origin) origin = result(n)->origin();
@@ -211,8 +235,36 @@ region::copy(
 void
 region::prune(bool recursive)
 {
-	while (bottom_nodes.first())
-		remove_node(bottom_nodes.first());
+	/* mark live nodes backwards from the results */
+	std::unordered_set<const jive::node*> live;
+	live.reserve(nnodes());
+	std::vector<jive::node*> worklist;
+	for (const auto & result : results_) {
+		auto node = result->origin()->node();
+		if (node && live.insert(node).second)
+			worklist.push_back(node);
+	}
+
+	while (!worklist.empty()) {
+		auto node = worklist.back();
+		worklist.pop_back();
+		for (size_t n = 0; n < node->ninputs(); n++) {
+			auto producer = node->input(n)->origin()->node();
+			if (producer && live.insert(producer).second)
+				worklist.push_back(producer);
+		}
+	}
+
+	if (live.size() != nnodes()) {
+		std::vector<jive::node*> dead;
+		dead.reserve(nnodes() - live.size());
+		for (auto & node : nodes) {
+			if (live.find(&node) == live.end())
+				dead.push_back(&node);
+		}
+
+		sweep(dead);
+	}
 
 	if (!recursive)
 		return;
@@ -225,6 +277,52 @@ region::prune(bool recursive)
 	}
 }
 
+void
+region::sweep(std::vector<jive::node*> & dead)
+{
+	/*
+		Announce the destruction of all dead nodes up front, users
+		before producers, while the graph is still intact.
+	*/
+	std::sort(dead.begin(), dead.end(), [](const jive::node * a, const jive::node * b) {
+		return a->depth() > b->depth();
+	});
+	for (const auto & node : dead) {
+		on_node_destroy(node);
+		for (size_t n = 0; n < node->noutputs(); n++)
+			on_output_destroy(node->output(n));
+		for (size_t n = 0; n < node->ninputs(); n++)
+			on_input_destroy(node->input(n));
+		node->swept_ = true;
+	}
+
+	/*
+		Detach dead nodes from live producers. Edges between dead nodes
+		are dropped wholesale below instead of one user at a time.
+	*/
+	for (const auto & node : dead) {
+		for (size_t n = 0; n < node->ninputs(); n++) {
+			auto input = node->input(n);
+			auto producer = input->origin()->node();
+			if (!producer || !producer->swept())
+				input->origin()->remove_user(input);
+			input->origin_ = nullptr;
+		}
+	}
+
+	for (const auto & node : dead) {
+		if (!node->has_users())
+			continue;
+
+		for (size_t n = 0; n < node->noutputs(); n++)
+			node->output(n)->users_.clear();
+		bottom_nodes.push_back(node);
+	}
+
+	for (const auto & node : dead)
+		remove_node(node);
+}
+
 void
 region::normalize(bool recursive)
 {
@@ -234,7 +332,42 @@ region::normalize(bool recursive)
 				structnode->subregion(n)->normalize(recursive);
 		}
 
-		graph()->node_normal_form(typeid(node->operation()))->normalize_node(node);
+		node->normal_form()->normalize_node(node);
+	}
+}
+
+void
+region::mark_dirty(jive::node * node)
+{
+	JIVE_DEBUG_ASSERT(node->region() == this);
+	if (node->dirty_)
+		return;
+
+	if (!dirty_) {
+		dirty_ = true;
+		graph()->dirty_regions_.push_back(this);
+	}
+
+	node->dirty_ = true;
+	dirty_nodes_.push_back(node);
+}
+
+void
+region::clear_dirty() noexcept
+{
+	while (auto node = dirty_nodes_.first()) {
+		dirty_nodes_.erase(node);
+		node->dirty_ = false;
+	}
+}
+
+void
+region::normalize_dirty()
+{
+	while (auto node = dirty_nodes_.first()) {
+		dirty_nodes_.erase(node);
+		node->dirty_ = false;
+		node->normal_form()->normalize_node(node);
 	}
 }
 
@@ -252,6 +385,19 @@ nnodes(const jive::region * region) noexcept
 	return n;
 }
 
+size_t
+structural_hash(const jive::region * region)
+{
+	size_t hash = region->narguments();
+	for (size_t n = 0; n < region->narguments(); n++)
+		hash = detail::combine_hash(hash, region->argument(n)->type().hash());
+
+	for (size_t n = 0; n < region->nresults(); n++)
+		hash = detail::combine_hash(hash, structural_hash(region->result(n)->origin()));
+
+	return hash;
+}
+
 size_t
 nstructnodes(const jive::region * region) noexcept
 {
@@ -18,7 +18,8 @@ namespace jive {
 
 simple_input::~simple_input() noexcept
 {
-	on_input_destroy(this);
+	if (!node()->swept())
+		on_input_destroy(this);
 }
 
 simple_input::simple_input(
@@ -48,7 +49,8 @@ simple_output::simple_output(
 
 simple_output::~simple_output() noexcept
 {
-	on_output_destroy(this);
+	if (!node()->swept())
+		on_output_destroy(this);
 }
 
 jive::simple_node *
@@ -61,7 +63,8 @@ simple_output::node() const noexcept
 
 simple_node::~simple_node()
 {
-	on_node_destroy(this);
+	if (!swept())
+		on_node_destroy(this);
 }
 
 simple_node::simple_node(
@@ -89,15 +92,14 @@ simple_node::simple_node(
 jive::node *
 simple_node::copy(jive::region * region, const std::vector<jive::output*> & operands) const
 {
-	auto node = create(region, *static_cast<const simple_op*>(&operation()), operands);
-	graph()->mark_denormalized();
-	return node;
+	return create(region, *static_cast<const simple_op*>(&operation()), operands);
 }
 
 jive::node *
 simple_node::copy(jive::region * region, jive::substitution_map & smap) const
 {
 	std::vector<jive::output*> operands;
+	operands.reserve(ninputs());
 	for (size_t n = 0; n < ninputs(); n++) {
 		auto operand = smap.lookup(input(n)->origin());
 		operands.push_back(operand ? operand : input(n)->origin());
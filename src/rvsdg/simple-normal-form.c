@@ -13,11 +13,12 @@ static jive::node *
 node_cse(
 	jive::region * region,
 	const jive::operation & op,
-	const std::vector<jive::output*> & arguments)
+	const std::vector<jive::output*> & arguments,
+	const jive::node * exclude = nullptr)
 {
 	auto cse_test = [&](const jive::node * node)
 	{
-		return node->operation() == op && arguments == jive::operands(node);
+		return node != exclude && node->operation() == op && arguments == jive::operands(node);
 	};
 
 	if (!arguments.empty()) {
@@ -59,9 +60,8 @@ simple_normal_form::normalize_node(jive::node * node) const
 		return true;
 
 	if (get_cse()) {
-		auto new_node = node_cse(node->region(), node->operation(), operands(node));
-		JIVE_DEBUG_ASSERT(new_node);
-		if (new_node != node) {
+		auto new_node = node_cse(node->region(), node->operation(), operands(node), node);
+		if (new_node) {
 			divert_users(node, outputs(new_node));
 			remove(node);
 			return false;
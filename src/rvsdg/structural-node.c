@@ -17,7 +17,8 @@ structural_input::~structural_input() noexcept
 {
 	JIVE_DEBUG_ASSERT(arguments.empty());
 
-	on_input_destroy(this);
+	if (!node()->swept())
+		on_input_destroy(this);
 }
 
 structural_input::structural_input(
@@ -43,7 +44,8 @@ structural_output::~structural_output() noexcept
 {
 	JIVE_DEBUG_ASSERT(results.empty());
 
-	on_output_destroy(this);
+	if (!node()->swept())
+		on_output_destroy(this);
 }
 
 structural_output::structural_output(
@@ -66,7 +68,8 @@ structural_output::node() const noexcept
 
 structural_node::~structural_node()
 {
-	on_node_destroy(this);
+	if (!swept())
+		on_node_destroy(this);
 
 	subregions_.clear();
 }
@@ -115,7 +118,6 @@ structural_node::copy(jive::region * region, const std::vector<jive::output*> &
 jive::structural_node *
 structural_node::copy(jive::region * region, jive::substitution_map & smap) const
 {
-	graph()->mark_denormalized();
 	auto node = new structural_node(*static_cast<const structural_op*>(&operation()), region, 0);
 
 	/* copy inputs */
@@ -7,8 +7,188 @@
 #include <jive/rvsdg/substitution.h>
 #include <jive/rvsdg/theta.h>
 
+#include <unordered_set>
+
 namespace jive {
 
+/* theta normal form */
+
+static bool
+is_predicate_reducible(const jive::theta_node * theta)
+{
+	auto constant = theta->predicate()->origin()->node();
+	if (!constant || !is_ctlconstant_op(constant->operation()))
+		return false;
+
+	return to_ctlconstant_op(constant->operation()).value().alternative() == 0;
+}
+
+/* the loop body executes exactly once */
+static void
+perform_predicate_reduction(jive::theta_node * theta)
+{
+	jive::substitution_map smap;
+	for (const auto & lv : *theta)
+		smap.insert(lv->argument(), lv->input()->origin());
+
+	theta->subregion()->copy(theta->region(), smap, false, false);
+
+	for (const auto & lv : *theta)
+		lv->divert_users(smap.lookup(lv->result()->origin()));
+
+	remove(theta);
+}
+
+static bool
+perform_invariant_reduction(jive::theta_node * theta)
+{
+	bool was_normalized = true;
+	for (const auto & lv : *theta) {
+		if (is_invariant(lv) && lv->nusers() != 0) {
+			lv->divert_users(lv->input()->origin());
+			was_normalized = false;
+		}
+	}
+
+	return was_normalized;
+}
+
+/* the value of the argument reaches no result other than the loop variable's own one */
+static bool
+is_dead_loopvar(const jive::theta_output * output)
+{
+	if (output->nusers() != 0)
+		return false;
+
+	std::unordered_set<const jive::output*> visited({output->argument()});
+	std::vector<const jive::output*> worklist({output->argument()});
+	while (!worklist.empty()) {
+		auto origin = worklist.back();
+		worklist.pop_back();
+
+		for (const auto & user : *origin) {
+			if (auto result = dynamic_cast<const jive::result*>(user)) {
+				if (result != output->result())
+					return false;
+				continue;
+			}
+
+			auto node = user->node();
+			for (size_t n = 0; n < node->noutputs(); n++) {
+				if (visited.insert(node->output(n)).second)
+					worklist.push_back(node->output(n));
+			}
+		}
+	}
+
+	return true;
+}
+
+static bool
+perform_dead_loopvar_reduction(jive::theta_node * theta)
+{
+	std::vector<jive::theta_output*> dead;
+	for (const auto & lv : *theta) {
+		if (is_dead_loopvar(lv))
+			dead.push_back(lv);
+	}
+
+	if (dead.empty())
+		return true;
+
+	/* detach the results first, this leaves the computations of the loop variables dead */
+	for (const auto & lv : dead)
+		lv->result()->divert_to(lv->argument());
+	theta->subregion()->prune(false);
+
+	for (auto it = dead.rbegin(); it != dead.rend(); it++)
+		theta->remove_loopvar(*it);
+
+	return false;
+}
+
+theta_normal_form::~theta_normal_form() noexcept
+{}
+
+theta_normal_form::theta_normal_form(
+	const std::type_info & operator_class,
+	jive::node_normal_form * parent,
+	jive::graph * graph) noexcept
+: structural_normal_form(operator_class, parent, graph)
+, enable_predicate_reduction_(false)
+, enable_invariant_reduction_(false)
+, enable_dead_loopvar_reduction_(false)
+{
+	if (auto p = dynamic_cast<theta_normal_form*>(parent)) {
+		enable_predicate_reduction_ = p->enable_predicate_reduction_;
+		enable_invariant_reduction_ = p->enable_invariant_reduction_;
+		enable_dead_loopvar_reduction_ = p->enable_dead_loopvar_reduction_;
+	}
+}
+
+bool
+theta_normal_form::normalize_node(jive::node * node_) const
+{
+	JIVE_DEBUG_ASSERT(dynamic_cast<const jive::theta_node*>(node_));
+	auto node = static_cast<jive::theta_node*>(node_);
+
+	if (!get_mutable())
+		return true;
+
+	if (get_predicate_reduction() && is_predicate_reducible(node)) {
+		perform_predicate_reduction(node);
+		return false;
+	}
+
+	bool was_normalized = true;
+	if (get_invariant_reduction())
+		was_normalized &= perform_invariant_reduction(node);
+
+	if (get_dead_loopvar_reduction())
+		was_normalized &= perform_dead_loopvar_reduction(node);
+
+	return was_normalized;
+}
+
+void
+theta_normal_form::set_predicate_reduction(bool enable)
+{
+	if (enable_predicate_reduction_ == enable)
+		return;
+
+	children_set<theta_normal_form, &theta_normal_form::set_predicate_reduction>(enable);
+
+	enable_predicate_reduction_ = enable;
+	if (enable && get_mutable())
+		graph()->mark_denormalized();
+}
+
+void
+theta_normal_form::set_invariant_reduction(bool enable)
+{
+	if (enable_invariant_reduction_ == enable)
+		return;
+
+	children_set<theta_normal_form, &theta_normal_form::set_invariant_reduction>(enable);
+
+	enable_invariant_reduction_ = enable;
+	if (enable && get_mutable())
+		graph()->mark_denormalized();
+}
+
+void
+theta_normal_form::set_dead_loopvar_reduction(bool enable)
+{
+	if (enable_dead_loopvar_reduction_ == enable)
+		return;
+
+	children_set<theta_normal_form, &theta_normal_form::set_dead_loopvar_reduction>(enable);
+
+	enable_dead_loopvar_reduction_ = enable;
+	if (enable && get_mutable())
+		graph()->mark_denormalized();
+}
+
 /* theta operation */
 
 theta_op::~theta_op() noexcept
@@ -95,6 +275,22 @@ theta_node::add_loopvar(jive::output * origin)
 	return output;
 }
 
+void
+theta_node::remove_loopvar(jive::theta_output * output)
+{
+	JIVE_DEBUG_ASSERT(output->node() == this);
+	JIVE_DEBUG_ASSERT(output->nusers() == 0);
+
+	auto index = output->index();
+	auto argument = output->argument();
+	subregion()->remove_result(output->result()->index());
+	JIVE_DEBUG_ASSERT(argument->nusers() == 0);
+	subregion()->remove_argument(argument->index());
+
+	remove_output(index);
+	remove_input(index);
+}
+
 jive::theta_node *
 theta_node::copy(jive::region * region, jive::substitution_map & smap) const
 {
@@ -125,3 +321,19 @@ theta_node::copy(jive::region * region, jive::substitution_map & smap) const
 }
 
 }
+
+jive::node_normal_form *
+jive_theta_node_get_default_normal_form_(
+	const std::type_info & operator_class,
+	jive::node_normal_form * parent,
+	jive::graph * graph)
+{
+	return new jive::theta_normal_form(operator_class, parent, graph);
+}
+
+static void __attribute__((constructor))
+register_node_normal_form(void)
+{
+	jive::node_normal_form::register_factory(
+		typeid(jive::theta_op), jive_theta_node_get_default_normal_form_);
+}
@@ -6,11 +6,19 @@
 
 #include <jive/rvsdg/type.h>
 
+#include <typeinfo>
+
 namespace jive {
 
 type::~type() noexcept
 {}
 
+size_t
+type::hash() const noexcept
+{
+	return typeid(*this).hash_code();
+}
+
 valuetype::~valuetype() noexcept
 {}
 
@@ -5,11 +5,15 @@
  */
 
 #include <stdexcept>
+#include <typeindex>
+#include <unordered_map>
 
+#include <jive/types/bitstring/arithmetic.h>
 #include <jive/types/bitstring/bitoperation-classes.h>
 #include <jive/types/bitstring/constant.h>
 
 #include <jive/rvsdg/control.h>
+#include <jive/rvsdg/simple-node.h>
 
 namespace jive {
 
@@ -41,6 +45,360 @@ bitunary_op::reduce_operand(
 	return nullptr;
 }
 
+/* bitbinary normal form */
+
+namespace {
+
+const bitvalue_repr *
+constant_value(const jive::output * output)
+{
+	auto node = producer(output);
+	if (!is<bitconstant_op>(node))
+		return nullptr;
+
+	auto & value = static_cast<const bitconstant_op*>(&node->operation())->value();
+	return value.is_known() ? &value : nullptr;
+}
+
+inline size_t
+nbits(const jive::output * output)
+{
+	return static_cast<const bittype*>(&output->type())->nbits();
+}
+
+/* returns k if value is 2^k, and the number of bits of value otherwise */
+size_t
+exact_log2(const bitvalue_repr & value)
+{
+	size_t k = value.nbits();
+	for (size_t n = 0; n < value.nbits(); n++) {
+		if (value[n] != '1')
+			continue;
+
+		if (k != value.nbits())
+			return value.nbits();
+		k = n;
+	}
+
+	return k;
+}
+
+/* x op 0 = x */
+jive::output *
+right_identity_zero(jive::output * arg1, jive::output * arg2)
+{
+	auto c = constant_value(arg2);
+	return c && *c == 0 ? arg1 : nullptr;
+}
+
+/* x op 1 = x */
+jive::output *
+right_identity_one(jive::output * arg1, jive::output * arg2)
+{
+	auto c = constant_value(arg2);
+	return c && *c == 1 ? arg1 : nullptr;
+}
+
+/* x op -1 = x */
+jive::output *
+right_identity_ones(jive::output * arg1, jive::output * arg2)
+{
+	auto c = constant_value(arg2);
+	return c && *c == -1 ? arg1 : nullptr;
+}
+
+/* x op 0 = 0 */
+jive::output *
+right_annihilator_zero(jive::output * arg1, jive::output * arg2)
+{
+	auto c = constant_value(arg2);
+	return c && *c == 0 ? arg2 : nullptr;
+}
+
+/* x op -1 = -1 */
+jive::output *
+right_annihilator_ones(jive::output * arg1, jive::output * arg2)
+{
+	auto c = constant_value(arg2);
+	return c && *c == -1 ? arg2 : nullptr;
+}
+
+/* 0 op x = 0 */
+jive::output *
+left_annihilator_zero(jive::output * arg1, jive::output * arg2)
+{
+	auto c = constant_value(arg1);
+	return c && *c == 0 ? arg1 : nullptr;
+}
+
+/* x op 1 = 0 */
+jive::output *
+remainder_one(jive::output * arg1, jive::output * arg2)
+{
+	auto c = constant_value(arg2);
+	return c && *c == 1 ? create_bitconstant(arg1->region(), nbits(arg1), 0) : nullptr;
+}
+
+/* x op x = 0 */
+jive::output *
+equal_zero(jive::output * arg1, jive::output * arg2)
+{
+	return arg1 == arg2 ? create_bitconstant(arg1->region(), nbits(arg1), 0) : nullptr;
+}
+
+/* x op x = x */
+jive::output *
+equal_idempotent(jive::output * arg1, jive::output * arg2)
+{
+	return arg1 == arg2 ? arg1 : nullptr;
+}
+
+/* x * 2^k = x << k */
+jive::output *
+multiply_power_of_two(jive::output * arg1, jive::output * arg2)
+{
+	auto c = constant_value(arg2);
+	size_t n = nbits(arg1);
+	if (!c || exact_log2(*c) == n)
+		return nullptr;
+
+	auto shift = create_bitconstant(arg1->region(), n, exact_log2(*c));
+	return bitshl_op::create(n, arg1, shift);
+}
+
+/* x / 2^k = x >> k */
+jive::output *
+divide_power_of_two(jive::output * arg1, jive::output * arg2)
+{
+	auto c = constant_value(arg2);
+	size_t n = nbits(arg1);
+	if (!c || exact_log2(*c) == n)
+		return nullptr;
+
+	auto shift = create_bitconstant(arg1->region(), n, exact_log2(*c));
+	return bitshr_op::create(n, arg1, shift);
+}
+
+/* x % 2^k = x & (2^k - 1) */
+jive::output *
+remainder_power_of_two(jive::output * arg1, jive::output * arg2)
+{
+	auto c = constant_value(arg2);
+	size_t n = nbits(arg1);
+	if (!c || exact_log2(*c) == n)
+		return nullptr;
+
+	auto mask = create_bitconstant(arg1->region(), c->sub(bitvalue_repr(n, 1)));
+	return bitand_op::create(n, arg1, mask);
+}
+
+/* divisors that are neither zero nor a power of two */
+const bitvalue_repr *
+magic_divisor(const jive::output * output)
+{
+	auto c = constant_value(output);
+	if (!c || exact_log2(*c) != c->nbits() || *c == 0)
+		return nullptr;
+
+	return c;
+}
+
+/*
+	Unsigned division by an n-bit constant c with l = ceil(log2(c)):
+	t = umulh(x, m), x / c = (t + ((x - t) >> 1)) >> (l - 1)
+	with the magic number m = floor(2^(n+l) / c) - 2^n + 1.
+*/
+jive::output *
+divide_magic(jive::output * arg1, jive::output * arg2)
+{
+	auto c = magic_divisor(arg2);
+	if (!c)
+		return nullptr;
+
+	size_t n = c->nbits();
+	size_t l = n;
+	while ((*c)[l-1] == '0')
+		l--;
+
+	bitvalue_repr one(2*n+2, 1);
+	auto m = one.shl(n+l).udiv(c->zext(n+2)).sub(one.shl(n)).add(one).slice(0, n);
+
+	auto region = arg1->region();
+	auto t = bitumulh_op::create(n, arg1, create_bitconstant(region, m));
+	auto d = bitshr_op::create(n, bitsub_op::create(n, arg1, t), create_bitconstant(region, n, 1));
+	return bitshr_op::create(n, bitadd_op::create(n, t, d), create_bitconstant(region, n, l-1));
+}
+
+/* x % c = x - (x / c) * c */
+jive::output *
+remainder_magic(jive::output * arg1, jive::output * arg2)
+{
+	if (!magic_divisor(arg2))
+		return nullptr;
+
+	size_t n = nbits(arg1);
+	auto quotient = bitudiv_op::create(n, arg1, arg2);
+	return bitsub_op::create(n, arg1, bitmul_op::create(n, quotient, arg2));
+}
+
+struct simplification {
+	bool strength_reduction;
+	jive::output * (*rule)(jive::output * arg1, jive::output * arg2);
+};
+
+const std::unordered_multimap<std::type_index, simplification> simplifications({
+	{typeid(bitadd_op), {false, right_identity_zero}},
+	{typeid(bitsub_op), {false, right_identity_zero}},
+	{typeid(bitsub_op), {false, equal_zero}},
+	{typeid(bitmul_op), {false, right_annihilator_zero}},
+	{typeid(bitmul_op), {false, right_identity_one}},
+	{typeid(bitmul_op), {true, multiply_power_of_two}},
+	{typeid(bitudiv_op), {false, right_identity_one}},
+	{typeid(bitudiv_op), {false, left_annihilator_zero}},
+	{typeid(bitudiv_op), {true, divide_power_of_two}},
+	{typeid(bitudiv_op), {true, divide_magic}},
+	{typeid(bitsdiv_op), {false, right_identity_one}},
+	{typeid(bitsdiv_op), {false, left_annihilator_zero}},
+	{typeid(bitumod_op), {false, remainder_one}},
+	{typeid(bitumod_op), {false, left_annihilator_zero}},
+	{typeid(bitumod_op), {true, remainder_power_of_two}},
+	{typeid(bitumod_op), {true, remainder_magic}},
+	{typeid(bitsmod_op), {false, remainder_one}},
+	{typeid(bitsmod_op), {false, left_annihilator_zero}},
+	{typeid(bitand_op), {false, right_annihilator_zero}},
+	{typeid(bitand_op), {false, right_identity_ones}},
+	{typeid(bitand_op), {false, equal_idempotent}},
+	{typeid(bitor_op), {false, right_identity_zero}},
+	{typeid(bitor_op), {false, right_annihilator_ones}},
+	{typeid(bitor_op), {false, equal_idempotent}},
+	{typeid(bitxor_op), {false, right_identity_zero}},
+	{typeid(bitxor_op), {false, equal_zero}},
+	{typeid(bitshl_op), {false, right_identity_zero}},
+	{typeid(bitshl_op), {false, left_annihilator_zero}},
+	{typeid(bitshr_op), {false, right_identity_zero}},
+	{typeid(bitshr_op), {false, left_annihilator_zero}},
+	{typeid(bitashr_op), {false, right_identity_zero}},
+	{typeid(bitashr_op), {false, left_annihilator_zero}}
+});
+
+}
+
+bitbinary_normal_form::~bitbinary_normal_form() noexcept
+{}
+
+bitbinary_normal_form::bitbinary_normal_form(
+	const std::type_info & operator_class,
+	jive::node_normal_form * parent,
+	jive::graph * graph)
+: binary_normal_form(operator_class, parent, graph)
+, enable_algebraic_(false)
+, enable_strength_reduction_(false)
+{
+	if (auto p = dynamic_cast<bitbinary_normal_form*>(parent)) {
+		enable_algebraic_ = p->enable_algebraic_;
+		enable_strength_reduction_ = p->enable_strength_reduction_;
+	}
+}
+
+jive::output *
+bitbinary_normal_form::simplify(
+	const jive::operation & op,
+	jive::output * arg1,
+	jive::output * arg2) const
+{
+	/* constant operands are reduced by the binary normal form */
+	if (constant_value(arg1) && constant_value(arg2))
+		return nullptr;
+
+	auto commutative = static_cast<const binary_op*>(&op)->is_commutative();
+	auto range = simplifications.equal_range(typeid(op));
+	for (auto it = range.first; it != range.second; it++) {
+		auto & s = it->second;
+		if (s.strength_reduction ? !get_strength_reduction() : !get_algebraic())
+			continue;
+
+		if (auto result = s.rule(arg1, arg2))
+			return result;
+
+		if (commutative) {
+			if (auto result = s.rule(arg2, arg1))
+				return result;
+		}
+	}
+
+	return nullptr;
+}
+
+bool
+bitbinary_normal_form::normalize_node(jive::node * node) const
+{
+	if (get_mutable() && node->ninputs() == 2) {
+		auto result = simplify(node->operation(), node->input(0)->origin(), node->input(1)->origin());
+		if (result) {
+			node->output(0)->divert_users(result);
+			remove(node);
+			return false;
+		}
+	}
+
+	return binary_normal_form::normalize_node(node);
+}
+
+std::vector<jive::output*>
+bitbinary_normal_form::normalized_create(
+	jive::region * region,
+	const jive::simple_op & op,
+	const std::vector<jive::output*> & arguments) const
+{
+	if (get_mutable() && arguments.size() == 2) {
+		if (auto result = simplify(op, arguments[0], arguments[1]))
+			return {result};
+	}
+
+	return binary_normal_form::normalized_create(region, op, arguments);
+}
+
+void
+bitbinary_normal_form::set_algebraic(bool enable)
+{
+	if (get_algebraic() == enable)
+		return;
+
+	children_set<bitbinary_normal_form, &bitbinary_normal_form::set_algebraic>(enable);
+
+	enable_algebraic_ = enable;
+	if (get_mutable() && enable)
+		graph()->mark_denormalized();
+}
+
+void
+bitbinary_normal_form::set_strength_reduction(bool enable)
+{
+	if (get_strength_reduction() == enable)
+		return;
+
+	children_set<bitbinary_normal_form, &bitbinary_normal_form::set_strength_reduction>(enable);
+
+	enable_strength_reduction_ = enable;
+	if (get_mutable() && enable)
+		graph()->mark_denormalized();
+}
+
+static jive::node_normal_form *
+get_default_normal_form(
+	const std::type_info & operator_class,
+	jive::node_normal_form * parent,
+	jive::graph * graph)
+{
+	return new jive::bitbinary_normal_form(operator_class, parent, graph);
+}
+
+static void __attribute__((constructor))
+register_node_normal_form(void)
+{
+	jive::node_normal_form::register_factory(typeid(jive::bitbinary_op), get_default_normal_form);
+}
+
 /* bitbinary operation */
 
 bitbinary_op::~bitbinary_op() noexcept
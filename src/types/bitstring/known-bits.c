@@ -0,0 +1,194 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/graph.h>
+#include <jive/rvsdg/notifiers.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/types/bitstring/arithmetic.h>
+#include <jive/types/bitstring/concat.h>
+#include <jive/types/bitstring/constant.h>
+#include <jive/types/bitstring/known-bits.h>
+#include <jive/types/bitstring/slice.h>
+
+#include <functional>
+#include <stdexcept>
+
+namespace jive {
+
+/* operations whose result bits can be derived from partially known operands */
+static bool
+supports_partial_operands(const jive::operation & op) noexcept
+{
+	return dynamic_cast<const bitunary_op*>(&op)
+	    || dynamic_cast<const bitadd_op*>(&op)
+	    || dynamic_cast<const bitsub_op*>(&op)
+	    || dynamic_cast<const bitmul_op*>(&op)
+	    || dynamic_cast<const bitand_op*>(&op)
+	    || dynamic_cast<const bitor_op*>(&op)
+	    || dynamic_cast<const bitxor_op*>(&op)
+	    || dynamic_cast<const bitshl_op*>(&op)
+	    || dynamic_cast<const bitshr_op*>(&op)
+	    || dynamic_cast<const bitashr_op*>(&op);
+}
+
+static jive::bitvalue_repr
+meet(const jive::bitvalue_repr & v1, const jive::bitvalue_repr & v2)
+{
+	JIVE_DEBUG_ASSERT(v1.nbits() == v2.nbits());
+
+	auto result = v1;
+	for (size_t n = 0; n < result.nbits(); n++) {
+		if (v1[n] != v2[n])
+			result[n] = 'D';
+	}
+
+	return result;
+}
+
+known_bits::~known_bits() noexcept
+{}
+
+known_bits::known_bits(jive::graph * graph)
+: graph_(graph)
+{
+	change_callback_ = on_input_change.connect(
+		std::bind(&known_bits::input_change, this,
+			std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+	destroy_callback_ = on_output_destroy.connect(
+		std::bind(&known_bits::output_destroy, this, std::placeholders::_1));
+}
+
+const jive::bitvalue_repr &
+known_bits::value(const jive::output * output)
+{
+	auto it = values_.find(output);
+	if (it != values_.end())
+		return it->second;
+
+	auto value = compute(output);
+	return values_.insert({output, std::move(value)}).first->second;
+}
+
+jive::bitvalue_repr
+known_bits::compute(const jive::output * output)
+{
+	auto & type = *static_cast<const bittype*>(&output->type());
+	auto unknown = bitvalue_repr::repeat(type.nbits(), 'D');
+
+	if (auto argument = dynamic_cast<const jive::argument*>(output)) {
+		auto input = argument->input();
+		if (!input)
+			return unknown;
+
+		auto theta_input = dynamic_cast<const jive::theta_input*>(input);
+		if (theta_input && !is_invariant(theta_input))
+			return unknown;
+
+		return value(input->origin());
+	}
+
+	auto node = output->node();
+	if (auto gamma = dynamic_cast<const gamma_node*>(node)) {
+		auto result = value(gamma->subregion(0)->result(output->index())->origin());
+		for (size_t n = 1; n < gamma->nsubregions(); n++)
+			result = meet(result, value(gamma->subregion(n)->result(output->index())->origin()));
+		return result;
+	}
+
+	auto & op = node->operation();
+	if (auto cop = dynamic_cast<const bitconstant_op*>(&op))
+		return cop->value();
+
+	if (auto sop = dynamic_cast<const bitslice_op*>(&op))
+		return value(node->input(0)->origin()).slice(sop->low(), sop->high());
+
+	if (is<bitconcat_op>(node)) {
+		auto result = value(node->input(0)->origin());
+		for (size_t n = 1; n < node->ninputs(); n++)
+			result = result.concat(value(node->input(n)->origin()));
+		return result;
+	}
+
+	try {
+		if (auto uop = dynamic_cast<const bitunary_op*>(&op))
+			return uop->reduce_constant(value(node->input(0)->origin()));
+
+		if (auto bop = dynamic_cast<const bitbinary_op*>(&op)) {
+			auto result = value(node->input(0)->origin());
+			for (size_t n = 1; n < node->ninputs(); n++) {
+				auto & operand = value(node->input(n)->origin());
+				if (!supports_partial_operands(op) && !(result.is_known() && operand.is_known()))
+					return unknown;
+
+				result = bop->reduce_constants(result, operand);
+			}
+			return result;
+		}
+
+		if (auto cop = dynamic_cast<const bitcompare_op*>(&op)) {
+			switch (cop->reduce_constants(value(node->input(0)->origin()),
+				value(node->input(1)->origin()))) {
+				case compare_result::static_true: return bitvalue_repr(1, 1);
+				case compare_result::static_false: return bitvalue_repr(1, 0);
+				default: return unknown;
+			}
+		}
+	} catch (std::range_error &) {
+		/* shift amount is not known */
+	}
+
+	return unknown;
+}
+
+void
+known_bits::invalidate(const jive::output * output)
+{
+	if (values_.erase(output) == 0)
+		return;
+
+	for (const auto & user : *output)
+		invalidate(user);
+}
+
+void
+known_bits::invalidate(const jive::input * input)
+{
+	if (auto node = input->node()) {
+		for (size_t n = 0; n < node->noutputs(); n++)
+			invalidate(node->output(n));
+
+		if (auto structural_input = dynamic_cast<const jive::structural_input*>(input)) {
+			for (const auto & argument : structural_input->arguments)
+				invalidate(&argument);
+		}
+		return;
+	}
+
+	auto output = static_cast<const jive::result*>(input)->output();
+	if (!output)
+		return;
+
+	invalidate(output);
+
+	/* the argument of a loop variable is only known while the variable is invariant */
+	if (auto theta_output = dynamic_cast<const jive::theta_output*>(output))
+		invalidate(theta_output->argument());
+}
+
+void
+known_bits::input_change(jive::input * input, jive::output * old_origin, jive::output * new_origin)
+{
+	if (input->region()->graph() == graph_)
+		invalidate(input);
+}
+
+void
+known_bits::output_destroy(jive::output * output)
+{
+	values_.erase(output);
+}
+
+}
@@ -14,6 +14,9 @@
 #include <jive/types/bitstring/concat.h>
 #include <jive/types/bitstring/constant.h>
 #include <jive/types/bitstring/type.h>
+#include <jive/util/hash.h>
+
+#include <typeinfo>
 
 namespace jive {
 
@@ -36,6 +39,13 @@ bitslice_op::debug_string() const
 	return detail::strfmt("SLICE[", low(), ":", high(), ")");
 }
 
+size_t
+bitslice_op::hash() const noexcept
+{
+	auto hash = detail::combine_hash(typeid(bitslice_op).hash_code(), low());
+	return detail::combine_hash(hash, high());
+}
+
 jive_unop_reduction_path_t
 bitslice_op::can_reduce_operand(const jive::output * arg) const noexcept
 {
@@ -8,6 +8,9 @@
 
 #include <jive/rvsdg/graph.h>
 #include <jive/rvsdg/node.h>
+#include <jive/util/hash.h>
+
+#include <typeinfo>
 
 namespace jive {
 
@@ -35,6 +38,12 @@ bittype::copy() const
 	return std::unique_ptr<jive::type>(new bittype(*this));
 }
 
+size_t
+bittype::hash() const noexcept
+{
+	return detail::combine_hash(typeid(bittype).hash_code(), nbits());
+}
+
 const bittype bit1(1);
 const bittype bit8(8);
 const bittype bit16(16);
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jive/types/declarations.h>
+#include <jive/types/record.h>
+#include <jive/types/union.h>
+
+#include <atomic>
+#include <functional>
+
+namespace {
+
+/* hash over the textual representation of the types, the types have no hash of their own */
+static size_t
+hash(const std::vector<const jive::valuetype*> & types)
+{
+	size_t h = types.size();
+	for (const auto & type : types)
+		h = h * 31 + std::hash<std::string>()(type->debug_string());
+
+	return h;
+}
+
+template<class ACCESSOR> static bool
+equal(
+	const std::vector<const jive::valuetype*> & types,
+	size_t nelements,
+	const ACCESSOR & element)
+{
+	if (nelements != types.size())
+		return false;
+
+	for (size_t n = 0; n < types.size(); n++) {
+		if (element(n) != *types[n])
+			return false;
+	}
+
+	return true;
+}
+
+}
+
+namespace jive {
+
+uint64_t
+create_declaration_id() noexcept
+{
+	static std::atomic<uint64_t> next(0);
+	return next++;
+}
+
+declaration_store::~declaration_store()
+{}
+
+declaration_store::declaration_store()
+{}
+
+unndeclaration *
+declaration_store::create_unndeclaration()
+{
+	unndeclarations_.emplace_back(new unndeclaration());
+	return unndeclarations_.back().get();
+}
+
+const unndeclaration *
+declaration_store::unndeclaration_of(const std::vector<const valuetype*> & types)
+{
+	auto h = hash(types);
+	auto range = unique_unndeclarations_.equal_range(h);
+	for (auto it = range.first; it != range.second; it++) {
+		auto dcl = it->second;
+		auto element = [&](size_t n) -> const valuetype & { return dcl->option(n); };
+		if (equal(types, dcl->noptions(), element))
+			return dcl;
+	}
+
+	auto dcl = create_unndeclaration();
+	for (const auto & type : types)
+		dcl->append(*type);
+
+	unique_unndeclarations_.insert({h, dcl});
+	return dcl;
+}
+
+rcddeclaration *
+declaration_store::create_rcddeclaration()
+{
+	rcddeclarations_.emplace_back(new rcddeclaration());
+	return rcddeclarations_.back().get();
+}
+
+const rcddeclaration *
+declaration_store::rcddeclaration_of(const std::vector<const valuetype*> & types)
+{
+	auto h = hash(types);
+	auto range = unique_rcddeclarations_.equal_range(h);
+	for (auto it = range.first; it != range.second; it++) {
+		auto dcl = it->second;
+		auto element = [&](size_t n) -> const valuetype & { return dcl->element(n); };
+		if (equal(types, dcl->nelements(), element))
+			return dcl;
+	}
+
+	auto dcl = create_rcddeclaration();
+	for (const auto & type : types)
+		dcl->append(*type);
+
+	unique_rcddeclarations_.insert({h, dcl});
+	return dcl;
+}
+
+}
@@ -7,12 +7,23 @@
 #include <jive/arch/address-transform.h>
 #include <jive/arch/load.h>
 #include <jive/types/bitstring/type.h>
+#include <jive/types/declarations.h>
 #include <jive/types/record.h>
 
 static constexpr jive_unop_reduction_path_t jive_select_reduction_load = 128;
 
 namespace jive {
 
+/* record declaration */
+
+const rcddeclaration *
+rcddeclaration::create(
+	jive::graph * graph,
+	const std::vector<const valuetype*> & types)
+{
+	return graph->declarations().rcddeclaration_of(types);
+}
+
 /* record type */
 
 rcdtype::~rcdtype() noexcept
@@ -7,52 +7,25 @@
 #include <jive/arch/addresstype.h>
 #include <jive/arch/load.h>
 #include <jive/types/bitstring.h>
+#include <jive/types/declarations.h>
 #include <jive/types/union.h>
 
-namespace {
-
-typedef std::unordered_set<std::unique_ptr<jive::unndeclaration>> declarationset;
-typedef std::unordered_map<const jive::graph*, declarationset> declarationmap;
-
-declarationmap &
-map()
-{
-	static declarationmap map;
-	return map;
-}
-
-void
-register_declaration(
-	const jive::graph * graph,
-	std::unique_ptr<jive::unndeclaration> dcl)
-{
-	auto & m = map();
-	if (m.find(graph) == m.end())
-		m[graph] = declarationset();
-
-	m[graph].insert(std::move(dcl));
-}
-
-}
-
 namespace jive {
 
 /* union declaration */
 
-void
-unregister_unndeclarations(const jive::graph * graph)
+unndeclaration *
+unndeclaration::create(jive::graph * graph)
 {
-	map().erase(graph);
+	return graph->declarations().create_unndeclaration();
 }
 
-unndeclaration *
-unndeclaration::create(const jive::graph * graph)
+const unndeclaration *
+unndeclaration::create(
+	jive::graph * graph,
+	const std::vector<const valuetype*> & types)
 {
-	std::unique_ptr<jive::unndeclaration> dcl(new jive::unndeclaration());
-	auto ptr = dcl.get();
-
-	register_declaration(graph, std::move(dcl));
-	return ptr;
+	return graph->declarations().unndeclaration_of(types);
 }
 
 /* union type */
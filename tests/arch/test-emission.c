@@ -0,0 +1,117 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-registry.h"
+
+#include <assert.h>
+
+#include <jive/arch/emission.h>
+#include <jive/backend/i386/instructionset.h>
+#include <jive/backend/i386/registerset.h>
+
+static jive_codegen_imm
+make_imm(jive_immediate_int value)
+{
+	jive_codegen_imm imm;
+	imm.info = jive_codegen_imm_info_static_known;
+	imm.value = value;
+	imm.symref = jive_symref_none();
+	imm.pc_relative = false;
+	return imm;
+}
+
+/* two byte register moves */
+static void
+add_filler(jive::instruction_sequence & sequence, size_t n)
+{
+	using namespace jive::i386;
+	for (size_t i = 0; i < n; i++)
+		sequence.add_instruction(&instr_int_transfer::instance(), {&eax}, {&ecx}, {});
+}
+
+static int32_t
+read32(const uint8_t * p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | (p[3] << 24);
+}
+
+static void
+test_short_and_long()
+{
+	using namespace jive::i386;
+
+	jive::instruction_sequence sequence;
+	auto top = sequence.create_label();
+	auto next = sequence.create_label();
+	auto far = sequence.create_label();
+	auto self = sequence.create_label();
+
+	sequence.place_label(top);
+	add_filler(sequence, 5);
+	sequence.add_instruction(&instr_int_jump_equal::instance(), {&cc}, {}, {make_imm(0)}, top);
+	sequence.add_instruction(&instr_jump::instance(), {}, {}, {make_imm(0)}, next);
+	sequence.place_label(next);
+	sequence.add_instruction(&instr_jump::instance(), {}, {}, {make_imm(0)}, far);
+	add_filler(sequence, 100);
+	sequence.place_label(far);
+	sequence.place_label(self);
+	sequence.add_instruction(&instr_jump::instance(), {}, {}, {make_imm(0)}, self);
+
+	jive::section section(jive_stdsectionid_code);
+	auto labels = jive::emit_instructions(sequence, &section);
+	auto data = section.data();
+
+	/* backward conditional jump */
+	assert(data[10] == 0x74 && int8_t(data[11]) == -12);
+	/* jump to the next instruction */
+	assert(data[12] == 0xeb && data[13] == 0);
+	assert(labels[next] == 14);
+	/* forward jump across 200 bytes */
+	assert(data[14] == 0xe9 && read32(data + 15) == 200);
+	assert(labels[far] == 219);
+	/* jump to itself */
+	assert(data[219] == 0xeb && int8_t(data[220]) == -2);
+	assert(section.size() == 221);
+}
+
+static void
+test_cascade()
+{
+	using namespace jive::i386;
+
+	/*
+		The first jump fits the short form until the second jump grows.
+	*/
+	jive::instruction_sequence sequence;
+	auto l1 = sequence.create_label();
+	auto l2 = sequence.create_label();
+	sequence.add_instruction(&instr_jump::instance(), {}, {}, {make_imm(0)}, l1);
+	add_filler(sequence, 62);
+	sequence.add_instruction(&instr_jump::instance(), {}, {}, {make_imm(0)}, l2);
+	sequence.place_label(l1);
+	add_filler(sequence, 65);
+	sequence.place_label(l2);
+
+	jive::section section(jive_stdsectionid_code);
+	auto labels = jive::emit_instructions(sequence, &section);
+	auto data = section.data();
+
+	assert(data[0] == 0xe9 && read32(data + 1) == 129);
+	assert(data[129] == 0xe9 && read32(data + 130) == 130);
+	assert(labels[l1] == 134);
+	assert(labels[l2] == 264);
+	assert(section.size() == 264);
+}
+
+static int
+test_main()
+{
+	test_short_and_long();
+	test_cascade();
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("arch/test-emission", test_main)
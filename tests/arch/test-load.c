@@ -8,16 +8,21 @@
 
 #include <assert.h>
 
+#include <jive/arch/address.h>
 #include <jive/arch/addresstype.h>
 #include <jive/arch/load.h>
 #include <jive/arch/store.h>
 #include <jive/rvsdg.h>
-#include <jive/types/bitstring/type.h>
+#include <jive/rvsdg/label.h>
+#include <jive/rvsdg/statemux.h>
+#include <jive/types/bitstring.h>
+#include <jive/types/record.h>
 #include <jive/view.h>
 
 #include "testnodes.h"
 
-static int test_main()
+static void
+test_store_forwarding()
 {
 	using namespace jive;
 
@@ -33,6 +38,12 @@ static int test_main()
 	auto load1 = addrload_op::create(i1, {states[0]});
 	assert(load1 == i3);
 
+	/* all states of the load are produced by the same store */
+	auto i4 = graph.add_import({memtype(), ""});
+	states = addrstore_op::create(i1, i3, {i2, i4});
+	auto load2 = addrload_op::create(i1, states);
+	assert(load2 == i3);
+
 	graph.add_export(load0, {load0->type(), ""});
 	auto ex1 = graph.add_export(load1, {load1->type(), ""});
 
@@ -42,6 +53,176 @@ static int test_main()
 	jive::view(graph.root(), stderr);
 
 	assert(ex1->origin() == i3);
+}
+
+static void
+test_disambiguation()
+{
+	using namespace jive;
+
+	jive::graph graph;
+	auto i0 = graph.add_import({addrtype(bit32), ""});
+	auto i1 = graph.add_import({addrtype(bit32), ""});
+	auto i2 = graph.add_import({memtype(), ""});
+	auto i3 = graph.add_import({bit32, ""});
+	auto i4 = graph.add_import({bit32, ""});
+
+	auto nf = load_op::normal_form(&graph);
+	nf->set_mutable(false);
+
+	/* distinct labels */
+	external_label l0("l0", nullptr), l1("l1", nullptr);
+	auto a0 = lbl2addr_op::create(graph.root(), &l0);
+	auto a1 = lbl2addr_op::create(graph.root(), &l1);
+	auto s0 = addrstore_op::create(a0, i3, {i2});
+	auto s1 = addrstore_op::create(a1, i4, s0);
+	auto load0 = addrload_op::create(a0, s1);
+
+	/* distinct record members */
+	auto dcl = rcddeclaration::create({&bit32, &bit32});
+	auto i5 = graph.add_import({addrtype(rcdtype(dcl.get())), ""});
+	auto m0 = memberof_op::create(i5, dcl.get(), 0);
+	auto m1 = memberof_op::create(i5, dcl.get(), 1);
+	auto s2 = addrstore_op::create(m0, i3, {i2});
+	auto s3 = addrstore_op::create(m1, i4, s2);
+	auto load1 = addrload_op::create(m0, s3);
+
+	/* distinct array elements */
+	auto e0 = arraysubscript_op::create(i0, bit32, create_bitconstant(graph.root(), 32, 0));
+	auto e1 = arraysubscript_op::create(i0, bit32, create_bitconstant(graph.root(), 32, 1));
+	auto s4 = addrstore_op::create(e0, i3, {i2});
+	auto s5 = addrstore_op::create(e1, i4, s4);
+	auto load2 = addrload_op::create(e0, s5);
+
+	/* stack slots */
+	auto fp = lbl2bit_op::create(graph.root(), 32, fpoffset_label::get());
+	auto f0 = bitadd_op::create(32, fp, create_bitconstant(graph.root(), 32, 8));
+	auto f1 = bitadd_op::create(32, fp, create_bitconstant(graph.root(), 32, 12));
+	auto f2 = bitadd_op::create(32, fp, create_bitconstant(graph.root(), 32, 10));
+	auto s6 = bitstore_op::create(f0, i3, 32, bit32, {i2});
+	auto s7 = bitstore_op::create(f1, i4, 32, bit32, s6);
+	auto load3 = bitload_op::create(f0, 32, bit32, s7);
+	auto s8 = bitstore_op::create(f2, i4, 32, bit32, s6);
+	auto load4 = bitload_op::create(f0, 32, bit32, s8);
+
+	/* unknown addresses */
+	auto s9 = addrstore_op::create(i0, i3, {i2});
+	auto s10 = addrstore_op::create(i1, i4, s9);
+	auto load5 = addrload_op::create(i0, s10);
+
+	auto ex0 = graph.add_export(load0, {load0->type(), ""});
+	auto ex1 = graph.add_export(load1, {load1->type(), ""});
+	auto ex2 = graph.add_export(load2, {load2->type(), ""});
+	auto ex3 = graph.add_export(load3, {load3->type(), ""});
+	auto ex4 = graph.add_export(load4, {load4->type(), ""});
+	auto ex5 = graph.add_export(load5, {load5->type(), ""});
+
+	nf->set_mutable(true);
+	graph.normalize();
+	graph.prune();
+
+	jive::view(graph.root(), stderr);
+
+	assert(ex0->origin() == i3);
+	assert(ex1->origin() == i3);
+	assert(ex2->origin() == i3);
+	assert(ex3->origin() == i3);
+	assert(is<load_op>(ex4->origin()->node()));
+	assert(is<load_op>(ex5->origin()->node()));
+}
+
+static void
+test_state_merge()
+{
+	using namespace jive;
+
+	jive::graph graph;
+	auto i0 = graph.add_import({memtype(), ""});
+	auto i1 = graph.add_import({bit32, ""});
+	auto i2 = graph.add_import({bit32, ""});
+
+	external_label l0("l0", nullptr), l1("l1", nullptr);
+	auto a0 = lbl2addr_op::create(graph.root(), &l0);
+	auto a1 = lbl2addr_op::create(graph.root(), &l1);
+
+	auto s0 = addrstore_op::create(a0, i1, {i0});
+	auto s1 = addrstore_op::create(a1, i2, s0);
+	auto merge = create_state_merge(memtype(), {s0[0], s1[0]});
+
+	auto load = addrload_op::create(a0, {merge});
+	assert(load == i1);
+}
+
+static void
+test_nested_state_merges()
+{
+	using namespace jive;
+
+	jive::graph graph;
+	auto i0 = graph.add_import({memtype(), ""});
+	auto i1 = graph.add_import({bit32, ""});
+	auto i2 = graph.add_import({bit32, ""});
+
+	external_label l0("l0", nullptr), l1("l1", nullptr);
+	auto a0 = lbl2addr_op::create(graph.root(), &l0);
+	auto a1 = lbl2addr_op::create(graph.root(), &l1);
+
+	/* every merge reaches the state below it twice, the walk must not be exponential */
+	auto state = addrstore_op::create(a0, i1, {i0})[0];
+	for (size_t n = 0; n < 64; n++) {
+		auto s0 = addrstore_op::create(a1, i1, {state});
+		auto s1 = addrstore_op::create(a1, i2, {state});
+		state = create_state_merge(memtype(), {s0[0], s1[0]});
+	}
+
+	auto load0 = addrload_op::create(a0, {state});
+	assert(load0 == i1);
+
+	auto load1 = addrload_op::create(a1, {state});
+	auto load2 = addrload_op::create(a1, {state});
+	assert(load1 == load2);
+}
+
+static void
+test_redundant_loads()
+{
+	using namespace jive;
+
+	jive::graph graph;
+	auto i0 = graph.add_import({memtype(), ""});
+	auto i1 = graph.add_import({bit32, ""});
+	auto i2 = graph.add_import({addrtype(bit32), ""});
+
+	external_label l0("l0", nullptr), l1("l1", nullptr);
+	auto a0 = lbl2addr_op::create(graph.root(), &l0);
+	auto a1 = lbl2addr_op::create(graph.root(), &l1);
+
+	auto load0 = addrload_op::create(a0, {i0});
+	auto s0 = addrstore_op::create(a1, i1, {i0});
+	auto load1 = addrload_op::create(a0, s0);
+	assert(load1 == load0);
+
+	auto s1 = addrstore_op::create(i2, i1, s0);
+	auto load2 = addrload_op::create(a0, s1);
+	assert(load2 != load0);
+
+	graph.add_export(load0, {load0->type(), ""});
+	graph.add_export(load2, {load2->type(), ""});
+
+	graph.normalize();
+	graph.prune();
+
+	jive::view(graph.root(), stderr);
+}
+
+static int
+test_main()
+{
+	test_store_forwarding();
+	test_disambiguation();
+	test_state_merge();
+	test_nested_state_merges();
+	test_redundant_loads();
 
 	return 0;
 }
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-registry.h"
+
+#include <assert.h>
+
+#include <jive/arch/address.h>
+#include <jive/arch/addresstype.h>
+#include <jive/arch/memlayout-simple.h>
+#include <jive/rvsdg.h>
+#include <jive/types/bitstring.h>
+#include <jive/types/record.h>
+#include <jive/types/union.h>
+
+#include <thread>
+
+static void
+test_bitstring()
+{
+	jive::memlayout_mapper_simple mapper(4);
+
+	/* odd widths are cached and share the layout of their rounded width */
+	auto & l17 = mapper.map_bitstring(17);
+	assert(&mapper.map_bitstring(17) == &l17);
+	assert(&mapper.map_bitstring(32) == &l17);
+	assert(l17.size() == 4 && l17.alignment() == 4);
+
+	auto & l9 = mapper.map_bitstring(9);
+	assert(&l9 != &l17);
+	assert(l9.size() == 2 && l9.alignment() == 2);
+
+	auto & l40 = mapper.map_bitstring(40);
+	assert(l40.size() == 8 && l40.alignment() == 4);
+}
+
+static void
+test_structural()
+{
+	using namespace jive;
+
+	jive::graph graph1, graph2;
+	memlayout_mapper_simple mapper(4);
+
+	/* identical records of different graphs share a single layout */
+	auto rcd1 = rcddeclaration::create(&graph1, {&bit8, &bit32, &bit16});
+	auto rcd2 = rcddeclaration::create(&graph2, {&bit8, &bit32, &bit16});
+	bittype bit9(9), bit17(17);
+	auto rcd3 = rcddeclaration::create({&bit8, &bit17, &bit9});
+	auto & layout = mapper.map_record(rcd1);
+	assert(&mapper.map_record(rcd2) == &layout);
+	assert(&mapper.map_record(rcd3.get()) == &layout);
+	assert(layout.size() == 12 && layout.alignment() == 4);
+	assert(layout.element(1).offset() == 4 && layout.element(2).offset() == 8);
+
+	auto rcd4 = rcddeclaration::create(&graph1, {&bit32, &bit8, &bit16});
+	assert(&mapper.map_record(rcd4) != &layout);
+	assert(mapper.map_record(rcd4).size() == 8);
+
+	/* nested records are compared through their element layouts */
+	rcdtype t1(rcd1), t2(rcd2);
+	auto unn1 = unndeclaration::create(&graph1, {&t1, &bit8});
+	auto unn2 = unndeclaration::create(&graph2, {&t2, &bit8});
+	assert(&mapper.map_union(unn1) == &mapper.map_union(unn2));
+	assert(mapper.map_union(unn1).size() == 12);
+
+	/* extended declarations are mapped again */
+	auto unn3 = unndeclaration::create(&graph1);
+	unn3->append(bit8);
+	assert(mapper.map_union(unn3).size() == 1);
+	unn3->append(bit32);
+	assert(mapper.map_union(unn3).size() == 4);
+	assert(&mapper.map_union(unn3) == &mapper.map_union(unndeclaration::create(&graph2,
+		{&bit8, &bit32})));
+
+	/* declarations of destroyed graphs do not affect the layouts of later ones */
+	for (size_t n = 1; n <= 4; n++) {
+		jive::graph graph;
+		std::vector<const valuetype*> elements(n, &bit32);
+		auto dcl = rcddeclaration::create(&graph, elements);
+		assert(mapper.map_record(dcl).size() == 4*n);
+	}
+}
+
+static void
+test_map_types()
+{
+	using namespace jive;
+
+	jive::graph graph;
+	auto dcl = rcddeclaration::create(&graph, {&bit16, &bit32});
+	auto i0 = graph.add_import({addrtype(rcdtype(dcl)), ""});
+	auto m0 = memberof_op::create(i0, dcl, 1);
+	graph.add_export(m0, {m0->type(), ""});
+
+	memlayout_mapper_simple mapper(4);
+	mapper.map_types(&graph);
+
+	/* the warmed up mapper is queried concurrently */
+	auto & layout = mapper.map_record(dcl);
+	std::vector<std::thread> threads;
+	for (size_t n = 0; n < 4; n++) {
+		threads.push_back(std::thread([&]()
+		{
+			for (size_t i = 0; i < 1000; i++) {
+				assert(&mapper.map_record(dcl) == &layout);
+				assert(mapper.map_value_type(bit32).size() == 4);
+				assert(mapper.map_value_type(addrtype(bit16)).size() == 4);
+			}
+		}));
+	}
+
+	for (auto & thread : threads)
+		thread.join();
+
+	assert(layout.element(1).offset() == 4);
+}
+
+static int
+test_main()
+{
+	test_bitstring();
+	test_structural();
+	test_map_types();
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("arch/test-memlayout", test_main)
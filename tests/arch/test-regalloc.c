@@ -0,0 +1,174 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-registry.h"
+#include "testarch.h"
+
+#include <assert.h>
+
+#include <jive/arch/instruction.h>
+#include <jive/arch/regalloc.h>
+#include <jive/arch/stackslot.h>
+#include <jive/backend/i386/instructionset.h>
+#include <jive/backend/i386/registerset.h>
+#include <jive/rvsdg.h>
+#include <jive/types/bitstring/type.h>
+
+#include <unordered_map>
+#include <unordered_set>
+
+/*
+	Replays the schedule and checks that every operand is still held in
+	its assigned register when it is consumed.
+*/
+static void
+verify_assignment(
+	jive::region * region,
+	const std::vector<jive::node*> & schedule,
+	const jive::register_assignment & assignment)
+{
+	std::unordered_map<const jive::registers*, const jive::output*> state;
+	std::unordered_set<const jive::output*> defined;
+	for (size_t n = 0; n < region->narguments(); n++) {
+		defined.insert(region->argument(n));
+		if (auto reg = assignment.lookup(region->argument(n)))
+			state[reg] = region->argument(n);
+	}
+
+	for (const auto & node : schedule) {
+		for (size_t n = 0; n < node->ninputs(); n++) {
+			auto input = node->input(n);
+			assert(defined.find(input->origin()) != defined.end());
+			if (auto reg = assignment.lookup(input->origin())) {
+				assert(state[reg] == input->origin());
+				assert(input->port().rescls()->resources().count(reg));
+			}
+		}
+
+		for (size_t n = 0; n < node->noutputs(); n++) {
+			auto output = node->output(n);
+			defined.insert(output);
+			if (auto reg = assignment.lookup(output)) {
+				assert(output->port().rescls()->resources().count(reg));
+				state[reg] = output;
+			}
+		}
+
+		auto icls = static_cast<const jive::instruction_op*>(&node->operation())->icls();
+		if ((icls->flags() & jive::instruction::flags::write_input) != jive::instruction::flags::none)
+			assert(assignment.lookup(node->output(0)) == assignment.lookup(node->input(0)->origin()));
+	}
+
+	for (size_t n = 0; n < region->nresults(); n++) {
+		auto origin = region->result(n)->origin();
+		if (auto reg = assignment.lookup(origin))
+			assert(state[reg] == origin);
+	}
+}
+
+static void
+test_spill()
+{
+	using namespace jive::testarch;
+
+	jive::bittype bt(32);
+	jive::graph graph;
+	auto x = graph.add_import({bt, "x"});
+
+	/* six values live at once exceed the four testarch registers */
+	std::vector<jive::node*> schedule;
+	std::vector<jive::output*> values;
+	for (size_t n = 0; n < 6; n++) {
+		schedule.push_back(jive::create_instruction(graph.root(), &instr_move_gpr::instance(), {x}));
+		values.push_back(schedule.back()->output(0));
+	}
+
+	auto sum = values[0];
+	for (size_t n = 1; n < values.size(); n++) {
+		schedule.push_back(jive::create_instruction(graph.root(), &instr_add_gpr::instance(),
+			{sum, values[n]}));
+		sum = schedule.back()->output(0);
+	}
+
+	/* a fixed register occupied by a live value */
+	schedule.push_back(jive::create_instruction(graph.root(), &instr_setr0::instance(), {x}));
+	auto r0 = schedule.back()->output(0);
+	schedule.push_back(jive::create_instruction(graph.root(), &instr_setr0::instance(), {sum}));
+	auto r0b = schedule.back()->output(0);
+	schedule.push_back(jive::create_instruction(graph.root(), &instr_add_gpr::instance(), {r0, r0b}));
+
+	graph.add_export(schedule.back()->output(0), {bt, "y"});
+
+	size_t nnodes = schedule.size();
+	/* the frame holds 12 bytes of other slots below the frame pointer */
+	auto assignment = jive::allocate_registers(graph.root(), schedule,
+		jive_testarch_instructionset_get(), -12);
+
+	assert(assignment.nspills() > 0);
+	assert(schedule.size() > nnodes);
+	verify_assignment(graph.root(), schedule, assignment);
+
+	size_t nspills = 0, nrestores = 0;
+	for (const auto & node : schedule) {
+		auto icls = static_cast<const jive::instruction_op*>(&node->operation())->icls();
+		nspills += icls == &instr_spill_gpr::instance();
+		nrestores += icls == &instr_restore_gpr::instance();
+	}
+	assert(nspills == assignment.nspills());
+	assert(nrestores >= nspills);
+
+	/* spill slots are placed in the reserved area below the other slots */
+	assert(assignment.spill_area_size() >= 4);
+	for (const auto & node : schedule) {
+		auto icls = static_cast<const jive::instruction_op*>(&node->operation())->icls();
+		if (icls != &instr_spill_gpr::instance())
+			continue;
+
+		auto rescls = node->output(0)->port().rescls();
+		auto slot = static_cast<const jive_stackslot*>(
+			static_cast<const jive_fixed_stackslot_class*>(rescls)->slot);
+		assert(slot->offset % 4 == 0);
+		assert(slot->offset <= -16 && slot->offset >= -12 - ssize_t(assignment.spill_area_size()));
+	}
+}
+
+static void
+test_i386_constraints()
+{
+	using namespace jive::i386;
+
+	jive::bittype bt(32);
+	jive::graph graph;
+	auto a = graph.add_import({bt, "a"});
+	auto b = graph.add_import({bt, "b"});
+
+	/* a remains live: it is copied before being overwritten and moved to ecx */
+	auto add = jive::create_instruction(graph.root(), &instr_int_add::instance(), {a, b});
+	auto shr = jive::create_instruction(graph.root(), &instr_int_shr::instance(),
+		{add->output(0), a});
+	graph.add_export(shr->output(0), {bt, "x"});
+	graph.add_export(a, {bt, "a"});
+
+	std::vector<jive::node*> schedule({add, shr});
+	auto assignment = jive::allocate_registers(graph.root(), schedule, instructionset::get(), 0);
+
+	assert(assignment.nspills() == 0 && assignment.spill_area_size() == 0);
+	assert(schedule.size() == 4 && schedule[3] == shr);
+	assert(add->input(0)->origin() != a);
+	assert(assignment.lookup(shr->input(1)->origin()) == &ecx);
+	assert(assignment.lookup(add->output(0)) != assignment.lookup(a));
+	verify_assignment(graph.root(), schedule, assignment);
+}
+
+static int
+test_main()
+{
+	test_spill();
+	test_i386_constraints();
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("arch/test-regalloc", test_main)
@@ -9,11 +9,13 @@
 #include <assert.h>
 
 #include <jive/arch/compilate.h>
+#include <jive/arch/label-mapper.h>
 
 static const jive_relocation_type ABS64 = {0};
 static const jive_relocation_type REL64 = {1};
 
 #include <stdio.h>
+#include <string.h>
 
 static bool
 process_relocation(
@@ -58,3 +60,53 @@ static int test_main()
 }
 
 JIVE_UNIT_TEST_REGISTER("arch/test-relocation", test_main)
+
+static int
+test_relocation_table()
+{
+	jive::compilate compilate;
+
+	auto data = compilate.section(jive_stdsectionid_data);
+	auto rodata = compilate.section(jive_stdsectionid_rodata);
+
+	int64_t value = 0;
+	rodata->put(&value, sizeof(value));
+	for (size_t n = 0; n < 64; n++) {
+		data->add_relocation(&value, sizeof(value), ABS64,
+			jive_symref_section(jive_stdsectionid_rodata), 0);
+	}
+
+	assert(data->relocations().size() == 64);
+	for (size_t n = 0; n < data->relocations().size(); n++)
+		assert(data->relocations()[n].offset() == n * sizeof(value));
+
+	auto map = compilate.load(nullptr, process_relocation);
+	assert(map->section(jive_stdsectionid_code) == nullptr);
+	assert(map->section(jive_stdsectionid_bss) == nullptr);
+
+	const uint64_t * data64 = (const uint64_t *) map->section(jive_stdsectionid_data);
+	for (size_t n = 0; n < 64; n++)
+		assert(data64[n] == (uintptr_t) map->section(jive_stdsectionid_rodata));
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("arch/test-relocation-table", test_relocation_table)
+
+static int
+test_label_mapper()
+{
+	static const jive_linker_symbol s1 = {0}, s2 = {0}, s3 = {0};
+	static const jive_symbol_name_pair pairs[] = {
+		{&s1, "s1"}, {&s2, "s2"}, {&s1, "shadowed"}
+	};
+
+	jive::label_name_mapper_simple mapper(pairs, 3);
+	assert(strcmp(mapper.map_named_symbol(&s1), "s1") == 0);
+	assert(strcmp(mapper.map_named_symbol(&s2), "s2") == 0);
+	assert(mapper.map_named_symbol(&s3) == nullptr);
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("arch/test-label-mapper", test_label_mapper)
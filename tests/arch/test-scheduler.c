@@ -0,0 +1,115 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-registry.h"
+#include "testarch.h"
+
+#include <assert.h>
+
+#include <jive/arch/immediate.h>
+#include <jive/arch/instruction.h>
+#include <jive/arch/regalloc.h>
+#include <jive/arch/scheduler.h>
+#include <jive/backend/i386/instructionset.h>
+#include <jive/rvsdg.h>
+#include <jive/types/bitstring/type.h>
+
+#include <algorithm>
+#include <unordered_set>
+
+static void
+verify_order(const jive::region * region, const std::vector<jive::node*> & schedule)
+{
+	assert(schedule.size() == region->nnodes());
+
+	std::unordered_set<const jive::node*> scheduled;
+	for (const auto & node : schedule) {
+		for (size_t n = 0; n < node->ninputs(); n++) {
+			auto producer = node->input(n)->origin()->node();
+			assert(!producer || scheduled.find(producer) != scheduled.end());
+		}
+		scheduled.insert(node);
+	}
+}
+
+static size_t
+index_of(const std::vector<jive::node*> & schedule, const jive::node * node)
+{
+	return std::find(schedule.begin(), schedule.end(), node) - schedule.begin();
+}
+
+static void
+test_latency()
+{
+	using namespace jive::i386;
+
+	auto isa = instructionset::get();
+	assert(isa->timing(&instr_int_load32_disp::instance()).latency == 3);
+	assert(isa->timing(&instr_int_sdiv::instance()).throughput > 1);
+	assert(isa->timing(&instr_int_add::instance()).latency == 1);
+
+	jive::bittype bt(32);
+	jive::graph graph;
+	auto a = graph.add_import({bt, "a"});
+	auto b = graph.add_import({bt, "b"});
+	auto p = graph.add_import({bt, "p"});
+
+	/* the independent add is created first, but the load is on the critical path */
+	auto add = jive::create_instruction(graph.root(), &instr_int_add::instance(), {a, b});
+	auto imm = jive::immediate_op::create(graph.root(), jive::immediate(4));
+	auto load = jive::create_instruction(graph.root(), &instr_int_load32_disp::instance(), {p, imm});
+	auto sum = jive::create_instruction(graph.root(), &instr_int_add::instance(),
+		{load->output(0), add->output(0)});
+	graph.add_export(sum->output(0), {bt, "x"});
+
+	auto schedule = jive::schedule_instructions(graph.root(), isa);
+	verify_order(graph.root(), schedule);
+	assert(index_of(schedule, load) < index_of(schedule, add));
+	assert(schedule.back() == sum);
+}
+
+static void
+test_pressure()
+{
+	using namespace jive::testarch;
+
+	jive::bittype bt(32);
+	jive::graph graph;
+	auto x = graph.add_import({bt, "x"});
+
+	/* created in an order that keeps six values alive at once */
+	std::vector<jive::output*> values;
+	for (size_t n = 0; n < 6; n++) {
+		auto node = jive::create_instruction(graph.root(), &instr_move_gpr::instance(), {x});
+		values.push_back(node->output(0));
+	}
+
+	auto sum = values[0];
+	for (size_t n = 1; n < values.size(); n++) {
+		auto node = jive::create_instruction(graph.root(), &instr_add_gpr::instance(),
+			{sum, values[n]});
+		sum = node->output(0);
+	}
+	graph.add_export(sum, {bt, "y"});
+
+	auto isa = jive_testarch_instructionset_get();
+	auto schedule = jive::schedule_instructions(graph.root(), isa);
+	verify_order(graph.root(), schedule);
+
+	/* interleaving definitions and additions fits the four registers */
+	auto assignment = jive::allocate_registers(graph.root(), schedule, isa, 0);
+	assert(assignment.nspills() == 0);
+}
+
+static int
+test_main()
+{
+	test_latency();
+	test_pressure();
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("arch/test-scheduler", test_main)
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-registry.h"
+
+#include <assert.h>
+
+#include <jive/arch/address.h>
+#include <jive/arch/call.h>
+#include <jive/arch/stackslot.h>
+#include <jive/backend/amd64/call.h>
+#include <jive/backend/amd64/registerset.h>
+#include <jive/rvsdg.h>
+#include <jive/rvsdg/label.h>
+#include <jive/types/bitstring.h>
+#include <jive/types/record.h>
+#include <jive/types/union.h>
+
+static jive::node *
+create_call(jive::graph & graph, const jive::label * label, size_t nargs)
+{
+	using namespace jive;
+
+	std::vector<jive::output*> arguments;
+	for (size_t n = 0; n < nargs; n++)
+		arguments.push_back(graph.add_import({bit64, ""}));
+
+	auto address = lbl2bit_op::create(graph.root(), 64, label);
+	auto results = bitcall_op::create(address, 64, arguments, {&bit64}, nullptr);
+	graph.add_export(results[0], {results[0]->type(), ""});
+
+	return amd64::substitute_call(results[0]->node());
+}
+
+static int
+test_main()
+{
+	using namespace jive;
+
+	external_label label("f", nullptr);
+
+	/* the call target is the first operand, all arguments are passed in registers */
+	{
+		jive::graph graph;
+		auto call = create_call(graph, &label, 6);
+		assert(call->input(2)->port().rescls() == &amd64::rsi_regcls);
+		assert(amd64::call_area_size(call) == 0);
+	}
+
+	/* the stack arguments start at the 16 byte aligned stack pointer */
+	{
+		jive::graph graph;
+		auto call = create_call(graph, &label, 7);
+		auto cls = dynamic_cast<const jive_callslot_class*>(call->input(7)->port().rescls());
+		assert(cls && cls->offset == 0 && cls->alignment == 16);
+		assert(amd64::call_area_size(call) == 16);
+	}
+
+	{
+		jive::graph graph;
+		auto call = create_call(graph, &label, 9);
+		auto cls = dynamic_cast<const jive_callslot_class*>(call->input(9)->port().rescls());
+		assert(cls && cls->offset == 16 && cls->alignment == 8);
+		assert(amd64::call_area_size(call) == 32);
+	}
+
+	/* aggregates can not be passed or returned by value */
+	{
+		jive::graph graph;
+		auto rcddcl = rcddeclaration::create({&bit64, &bit64});
+		auto unndcl = unndeclaration::create(&graph, {&bit64});
+		auto record = graph.add_import({rcdtype(rcddcl.get()), ""});
+		auto value = graph.add_import({bit64, ""});
+		auto address = lbl2bit_op::create(graph.root(), 64, &label);
+
+		auto results = bitcall_op::create(address, 64, {record}, {&bit64}, nullptr);
+		bool error = false;
+		try {
+			amd64::substitute_call(results[0]->node());
+		} catch (const compiler_error &) {
+			error = true;
+		}
+		assert(error);
+
+		unntype unn(unndcl);
+		results = bitcall_op::create(address, 64, {value}, {&unn}, nullptr);
+		error = false;
+		try {
+			amd64::substitute_call(results[0]->node());
+		} catch (const compiler_error &) {
+			error = true;
+		}
+		assert(error);
+	}
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("backend/amd64/test-call", test_main)
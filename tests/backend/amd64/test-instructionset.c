@@ -0,0 +1,179 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-registry.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include <jive/arch/emission.h>
+#include <jive/backend/amd64/instructionset.h>
+#include <jive/backend/amd64/registerset.h>
+#include <jive/backend/amd64/relocation.h>
+
+static jive_codegen_imm
+make_imm(jive_immediate_int value)
+{
+	jive_codegen_imm imm;
+	imm.info = jive_codegen_imm_info_static_known;
+	imm.value = value;
+	imm.symref = jive_symref_none();
+	imm.pc_relative = false;
+	return imm;
+}
+
+static void
+assert_encoding(
+	const jive::instruction * icls,
+	const std::vector<const jive::registers*> & inputs,
+	const std::vector<const jive::registers*> & outputs,
+	const std::vector<jive_codegen_imm> & immediates,
+	const std::vector<uint8_t> & expected)
+{
+	jive::instruction_sequence sequence;
+	sequence.add_instruction(icls, inputs, outputs, immediates);
+
+	jive::section section(jive_stdsectionid_code);
+	jive::emit_instructions(sequence, &section);
+	assert(section.size() == expected.size());
+	assert(memcmp(section.data(), expected.data(), expected.size()) == 0);
+}
+
+static void
+test_encoding()
+{
+	using namespace jive::amd64;
+
+	/* REX.W only for the low registers, REX.R and REX.B for the high ones */
+	assert_encoding(&instr_int_add::instance(), {&rax, &rcx}, {&rax, &cc}, {},
+		{0x48, 0x01, 0xc8});
+	assert_encoding(&instr_int_add::instance(), {&rax, &r9}, {&rax, &cc}, {},
+		{0x4c, 0x01, 0xc8});
+	assert_encoding(&instr_int_sub::instance(), {&r12, &rdx}, {&r12, &cc}, {},
+		{0x49, 0x29, 0xd4});
+	assert_encoding(&instr_int_mul::instance(), {&r8, &r15}, {&r8, &cc}, {},
+		{0x4d, 0x0f, 0xaf, 0xc7});
+	assert_encoding(&instr_int_transfer::instance(), {&rdi}, {&rax}, {},
+		{0x48, 0x89, 0xf8});
+	assert_encoding(&instr_int_mul_expand_unsigned::instance(), {&rax, &r9}, {&rdx, &rax, &cc}, {},
+		{0x49, 0xf7, 0xe1});
+	assert_encoding(&instr_int_mul_expand_signed::instance(), {&rax, &rcx}, {&rdx, &rax, &cc}, {},
+		{0x48, 0xf7, 0xe9});
+
+	/* short and long immediate forms */
+	assert_encoding(&instr_int_add_immediate::instance(), {&r11}, {&r11, &cc}, {make_imm(1)},
+		{0x49, 0x83, 0xc3, 0x01});
+	assert_encoding(&instr_int_cmp_immediate::instance(), {&rbx}, {&cc}, {make_imm(0x1000)},
+		{0x48, 0x81, 0xfb, 0x00, 0x10, 0x00, 0x00});
+	assert_encoding(&instr_int_load_imm::instance(), {}, {&r10}, {make_imm(-1)},
+		{0x49, 0xc7, 0xc2, 0xff, 0xff, 0xff, 0xff});
+	assert_encoding(&instr_int_load_imm::instance(), {}, {&rax}, {make_imm(0x123456789)},
+		{0x48, 0xb8, 0x89, 0x67, 0x45, 0x23, 0x01, 0x00, 0x00, 0x00});
+
+	/* memory operands through rsp and r13 need SIB and displacement bytes */
+	assert_encoding(&instr_int_load64_disp::instance(), {&rsp}, {&rax}, {make_imm(0)},
+		{0x48, 0x8b, 0x04, 0x24});
+	assert_encoding(&instr_int_store64_disp::instance(), {&r13, &r9}, {}, {make_imm(8)},
+		{0x4d, 0x89, 0x4d, 0x08});
+
+	/* no REX prefix without high registers, after the mandatory prefix otherwise */
+	assert_encoding(&instr_float_add::instance(), {&xmm1, &xmm2}, {&xmm1}, {},
+		{0xf3, 0x0f, 0x58, 0xca});
+	assert_encoding(&instr_float_add::instance(), {&xmm9, &xmm2}, {&xmm9}, {},
+		{0xf3, 0x44, 0x0f, 0x58, 0xca});
+	assert_encoding(&instr_call_reg::instance(), {&r11}, {}, {},
+		{0x41, 0xff, 0xd3});
+}
+
+static void
+test_relocation()
+{
+	uint8_t data[4] = {0xfc, 0xff, 0xff, 0xff};
+
+	/* the addend is sign-extended, the result must fit 32 bits */
+	assert(jive_amd64_process_relocation(data, 4, 0x1000, JIVE_R_X86_64_PC32, 0x2000, 0));
+	int32_t value;
+	memcpy(&value, data, 4);
+	assert(value == 0x1000 - 4);
+
+	assert(!jive_amd64_process_relocation(data, 4, 0, JIVE_R_X86_64_PC32, 0x100000000, 0));
+	assert(!jive_amd64_process_relocation(data, 2, 0, JIVE_R_X86_64_64, 0, 0));
+}
+
+static void
+test_native()
+{
+	using namespace jive::amd64;
+
+	/*
+		f(a, b) = |a + 8 * b - 3|
+		g(a, b) = f(a, b) + 0x123456789
+	*/
+	jive::instruction_sequence sequence;
+	auto done = sequence.create_label();
+	auto g = sequence.create_label();
+
+	sequence.add_instruction(&instr_int_transfer::instance(), {&rdi}, {&rax}, {});
+	sequence.add_instruction(&instr_int_mul_immediate::instance(), {&rsi}, {&r10, &cc},
+		{make_imm(8)});
+	sequence.add_instruction(&instr_int_add::instance(), {&rax, &r10}, {&rax, &cc}, {});
+	sequence.add_instruction(&instr_int_sub_immediate::instance(), {&rax}, {&rax, &cc},
+		{make_imm(3)});
+	sequence.add_instruction(&instr_int_cmp_immediate::instance(), {&rax}, {&cc},
+		{make_imm(0)});
+	sequence.add_instruction(&instr_int_jump_sgreatereq::instance(), {&cc}, {}, {make_imm(0)},
+		done);
+	sequence.add_instruction(&instr_int_neg::instance(), {&rax}, {&rax, &cc}, {});
+	sequence.place_label(done);
+	sequence.add_instruction(&instr_ret::instance(), {}, {}, {});
+
+	/* f starts at the beginning of the code section */
+	jive_codegen_imm target;
+	target.info = jive_codegen_imm_info_static_unknown;
+	target.value = 0;
+	target.symref = jive_symref_section(jive_stdsectionid_code);
+	target.pc_relative = true;
+
+	sequence.place_label(g);
+	/* keep the stack aligned to 16 bytes across the call */
+	sequence.add_instruction(&instr_int_sub_immediate::instance(), {&rsp}, {&rsp, &cc},
+		{make_imm(8)});
+	sequence.add_instruction(&instr_call::instance(), {}, {}, {target});
+	sequence.add_instruction(&instr_int_add_immediate::instance(), {&rsp}, {&rsp, &cc},
+		{make_imm(8)});
+	sequence.add_instruction(&instr_int_load_imm::instance(), {}, {&r11}, {make_imm(0x123456789)});
+	sequence.add_instruction(&instr_int_add::instance(), {&rax, &r11}, {&rax, &cc}, {});
+	sequence.add_instruction(&instr_ret::instance(), {}, {}, {});
+
+	jive::compilate compilate;
+	auto labels = jive::emit_instructions(sequence, compilate.section(jive_stdsectionid_code));
+	assert(compilate.section(jive_stdsectionid_code)->relocations().size() == 1);
+
+#if defined(__x86_64__)
+	auto map = compilate.load(nullptr, jive_amd64_process_relocation);
+	assert(map);
+
+	auto code = static_cast<char*>(map->section(jive_stdsectionid_code));
+	auto f_ = reinterpret_cast<int64_t(*)(int64_t, int64_t)>(code);
+	auto g_ = reinterpret_cast<int64_t(*)(int64_t, int64_t)>(code + labels[g]);
+
+	assert(f_(10, 2) == 23);
+	assert(f_(-20, 1) == 15);
+	assert(f_(int64_t(1) << 40, 0) == (int64_t(1) << 40) - 3);
+	assert(g_(10, 2) == 23 + 0x123456789);
+#endif
+}
+
+static int
+test_main()
+{
+	test_encoding();
+	test_relocation();
+	test_native();
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("backend/amd64/test-instructionset", test_main)
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-registry.h"
+
+#include <assert.h>
+#include <elf.h>
+#include <string.h>
+
+#include <jive/backend/i386/elf.h>
+#include <jive/backend/i386/relocation.h>
+
+static const Elf32_Shdr *
+find_section(const uint8_t * object, const char * name)
+{
+	auto ehdr = (const Elf32_Ehdr *) object;
+	auto shdrs = (const Elf32_Shdr *) (object + ehdr->e_shoff);
+	auto names = (const char *) (object + shdrs[ehdr->e_shstrndx].sh_offset);
+	for (size_t n = 0; n < ehdr->e_shnum; n++) {
+		if (strcmp(names + shdrs[n].sh_name, name) == 0)
+			return &shdrs[n];
+	}
+
+	return nullptr;
+}
+
+static uint32_t
+read32(const uint8_t * p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | (uint32_t(p[3]) << 24);
+}
+
+static int
+test_main()
+{
+	static const jive_linker_symbol external = {0};
+	static const jive_symbol_name_pair pairs[] = {{&external, "external_function"}};
+	jive::label_name_mapper_simple mapper(pairs, 1);
+
+	jive::compilate compilate;
+	auto code = compilate.section(jive_stdsectionid_code);
+	auto data = compilate.section(jive_stdsectionid_data);
+
+	/* call external_function; mov eax, [data+4]; ret */
+	const uint8_t call[] = {0xe8};
+	const uint8_t mov[] = {0xa1};
+	const uint8_t ret[] = {0xc3};
+	const uint32_t zero = 0;
+	code->put(call, sizeof(call));
+	code->add_relocation(&zero, sizeof(zero), JIVE_R_386_PC32,
+		jive_symref_linker_symbol(&external), (jive_offset) -4);
+	code->put(mov, sizeof(mov));
+	code->add_relocation(&zero, sizeof(zero), JIVE_R_386_32,
+		jive_symref_section(jive_stdsectionid_data), 4);
+	code->put(ret, sizeof(ret));
+	data->put(&zero, sizeof(zero));
+	data->put(&zero, sizeof(zero));
+
+	jive::buffer buffer;
+	jive::i386::write_elf(compilate, mapper,
+		{jive::i386::elf_symbol("entry", jive_stdsectionid_code, 0, code->size())}, buffer);
+	auto object = buffer.data();
+
+	auto ehdr = (const Elf32_Ehdr *) object;
+	assert(memcmp(ehdr->e_ident, ELFMAG, SELFMAG) == 0);
+	assert(ehdr->e_ident[EI_CLASS] == ELFCLASS32);
+	assert(ehdr->e_type == ET_REL);
+	assert(ehdr->e_machine == EM_386);
+
+	auto text = find_section(object, ".text");
+	auto dat = find_section(object, ".data");
+	auto rel = find_section(object, ".rel.text");
+	auto symtab = find_section(object, ".symtab");
+	auto strtab = find_section(object, ".strtab");
+	assert(text && dat && rel && symtab && strtab);
+	assert(!find_section(object, ".rel.data"));
+	assert(text->sh_size == 11 && (text->sh_flags & SHF_EXECINSTR));
+	assert(dat->sh_size == 8 && (dat->sh_flags & SHF_WRITE));
+
+	auto shdrs = (const Elf32_Shdr *) (object + ehdr->e_shoff);
+	assert(&shdrs[rel->sh_info] == text);
+	assert(&shdrs[rel->sh_link] == symtab);
+	assert(&shdrs[symtab->sh_link] == strtab);
+
+	/* addends are folded into the section contents */
+	auto contents = object + text->sh_offset;
+	assert(read32(contents + 1) == 0xfffffffc);
+	assert(read32(contents + 6) == 4);
+
+	auto syms = (const Elf32_Sym *) (object + symtab->sh_offset);
+	auto names = (const char *) (object + strtab->sh_offset);
+	auto rels = (const Elf32_Rel *) (object + rel->sh_offset);
+	assert(rel->sh_size == 2 * sizeof(Elf32_Rel));
+
+	assert(rels[0].r_offset == 1);
+	assert(ELF32_R_TYPE(rels[0].r_info) == R_386_PC32);
+	auto sym = &syms[ELF32_R_SYM(rels[0].r_info)];
+	assert(strcmp(names + sym->st_name, "external_function") == 0);
+	assert(sym->st_shndx == SHN_UNDEF && ELF32_ST_BIND(sym->st_info) == STB_GLOBAL);
+
+	assert(rels[1].r_offset == 6);
+	assert(ELF32_R_TYPE(rels[1].r_info) == R_386_32);
+	sym = &syms[ELF32_R_SYM(rels[1].r_info)];
+	assert(ELF32_ST_TYPE(sym->st_info) == STT_SECTION);
+	assert(&shdrs[sym->st_shndx] == dat);
+
+	/* locals precede globals */
+	size_t nsyms = symtab->sh_size / sizeof(Elf32_Sym);
+	bool found = false;
+	for (size_t n = 0; n < nsyms; n++) {
+		assert((n < symtab->sh_info) == (ELF32_ST_BIND(syms[n].st_info) == STB_LOCAL));
+		if (strcmp(names + syms[n].st_name, "entry") == 0) {
+			assert(ELF32_ST_TYPE(syms[n].st_info) == STT_FUNC);
+			assert(&shdrs[syms[n].st_shndx] == text);
+			found = true;
+		}
+	}
+	assert(found);
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("backend/i386/test-elf", test_main)
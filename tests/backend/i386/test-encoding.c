@@ -0,0 +1,151 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-registry.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include <jive/arch/compilate.h>
+#include <jive/backend/i386/encoding.h>
+#include <jive/backend/i386/instructionset.h>
+#include <jive/backend/i386/registerset.h>
+
+#include <algorithm>
+
+static jive_codegen_imm
+make_imm(jive_immediate_int value)
+{
+	jive_codegen_imm imm;
+	imm.info = jive_codegen_imm_info_static_known;
+	imm.value = value;
+	imm.symref = jive_symref_none();
+	imm.pc_relative = false;
+	return imm;
+}
+
+static jive::i386::encoding_entry
+make_entry(
+	const jive::i386::instruction & icls,
+	const std::vector<const jive::registers*> & inputs,
+	const std::vector<const jive::registers*> & outputs,
+	jive_immediate_int value)
+{
+	jive::i386::encoding_entry entry;
+	memset(&entry, 0, sizeof(entry));
+	entry.descriptor = &icls.descriptor();
+	std::copy(inputs.begin(), inputs.end(), entry.inputs);
+	std::copy(outputs.begin(), outputs.end(), entry.outputs);
+	entry.immediate = make_imm(value);
+	entry.flags = jive_instruction_encoding_flags_none;
+	return entry;
+}
+
+static void
+test_batch()
+{
+	using namespace jive::i386;
+
+	std::vector<encoding_entry> entries({
+		make_entry(instr_int_load_imm::instance(), {}, {&ebx}, 42)
+	, make_entry(instr_int_add::instance(), {&eax, &ecx}, {&eax, &cc}, 0)
+	, make_entry(instr_int_add_immediate::instance(), {&eax}, {&eax, &cc}, 1)
+	, make_entry(instr_int_add_immediate::instance(), {&edx}, {&edx, &cc}, 0x1000)
+	, make_entry(instr_int_shl_immediate::instance(), {&esi}, {&esi, &cc}, 3)
+	, make_entry(instr_int_load32_disp::instance(), {&esp}, {&edi}, 8)
+	, make_entry(instr_int_lea_disp::instance(), {&eax}, {&ebx}, 4)
+	, make_entry(instr_int_mul_expand_signed::instance(), {&eax, &ebx}, {&edx, &eax, &cc}, 0)
+	, make_entry(instr_float_add::instance(), {&xmm1, &xmm2}, {&xmm1}, 0)
+	, make_entry(instr_ret::instance(), {}, {}, 0)
+	});
+
+	jive::section batch(jive_stdsectionid_code);
+	encode_batch(entries.data(), entries.size(), &batch);
+
+	/* the batch encodes exactly as the instructions one by one */
+	jive::section single(jive_stdsectionid_code);
+	std::vector<size_t> offsets;
+	for (auto entry : entries) {
+		offsets.push_back(single.size());
+		entry.flags = jive_instruction_encoding_flags_none;
+		encode_batch(&entry, 1, &single);
+	}
+
+	assert(batch.size() == single.size());
+	assert(memcmp(batch.data(), single.data(), batch.size()) == 0);
+
+	/* short immediate form for small values, long form otherwise */
+	assert((entries[2].flags & jive_instruction_encoding_flags_option0) == 0);
+	assert((entries[3].flags & jive_instruction_encoding_flags_option0) != 0);
+
+	jive::section expected(jive_stdsectionid_code);
+	auto flags = jive_instruction_encoding_flags_none;
+	instr_int_add_immediate::instance().encode(&expected,
+		entries[3].inputs, entries[3].outputs, &entries[3].immediate, &flags);
+	assert(expected.size() == offsets[4] - offsets[3]);
+	assert(memcmp(batch.data() + offsets[3], expected.data(), expected.size()) == 0);
+
+	/* leal 4(%eax), %ebx */
+	const uint8_t lea[] = {0x8d, 0x58, 0x04};
+	assert(offsets[7] - offsets[6] == sizeof(lea));
+	assert(memcmp(batch.data() + offsets[6], lea, sizeof(lea)) == 0);
+}
+
+static void
+test_descriptors()
+{
+	using namespace jive::i386;
+
+	/* the operand masks admit every register of the instruction's register classes */
+	std::vector<const jive::i386::instruction*> instructions({
+		&instr_int_load32_disp::instance(), &instr_int_store32_disp::instance()
+	, &instr_int_lea_disp::instance()
+	, &instr_int_add::instance(), &instr_int_mul::instance()
+	, &instr_int_mul_expand_unsigned::instance(), &instr_int_sdiv::instance()
+	, &instr_int_shr::instance(), &instr_int_cmp_immediate::instance()
+	, &instr_int_jump_equal::instance(), &instr_fp_load_disp::instance()
+	, &instr_sse_store32_disp::instance(), &instr_float_cmp::instance()
+	});
+
+	for (const auto & icls : instructions) {
+		const auto & desc = icls->descriptor();
+		assert(desc.code == uint32_t(icls->code()));
+		assert((desc.immediate_width != 0) == (icls->nimmediates() != 0));
+
+		for (size_t n = 0; n < 3; n++) {
+			assert((desc.inputs[n] != 0) == (n < icls->ninputs()));
+			assert((desc.outputs[n] != 0) == (n < icls->noutputs()));
+		}
+
+		for (size_t n = 0; n < icls->ninputs(); n++) {
+			for (const auto & reg : icls->input(n)->resources()) {
+				auto r = static_cast<const jive::registers*>(reg);
+				assert((operand_mask(r) & desc.inputs[n]) == operand_mask(r));
+			}
+		}
+
+		for (size_t n = 0; n < icls->noutputs(); n++) {
+			for (const auto & reg : icls->output(n)->resources()) {
+				auto r = static_cast<const jive::registers*>(reg);
+				assert((operand_mask(r) & desc.outputs[n]) == operand_mask(r));
+			}
+		}
+	}
+
+	assert(operand_mask(&edx) == operand_edx);
+	assert(operand_mask(&xmm3) == (operand_xmm & (1 << 11)));
+	assert(operand_mask(&st0) == operand_fp);
+}
+
+static int
+test_main()
+{
+	test_batch();
+	test_descriptors();
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("backend/i386/test-encoding", test_main)
@@ -0,0 +1,197 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-registry.h"
+
+#include <assert.h>
+
+#include <jive/arch/immediate.h>
+#include <jive/arch/instruction.h>
+#include <jive/backend/i386/instructionset.h>
+#include <jive/backend/i386/peephole.h>
+#include <jive/rvsdg.h>
+#include <jive/types/bitstring/type.h>
+
+static const jive::instruction *
+icls(const jive::output * output)
+{
+	auto node = output->node();
+	assert(node && is_instruction_node(node));
+	return static_cast<const jive::instruction_op*>(&node->operation())->icls();
+}
+
+static jive_immediate_int
+immediate_value(const jive::output * output)
+{
+	auto node = output->node()->input(1)->origin()->node();
+	return static_cast<const jive::immediate_op*>(&node->operation())->value().offset();
+}
+
+static jive::node *
+create_regimm(
+	jive::region * region,
+	const jive::instruction * icls,
+	jive::output * operand,
+	jive_immediate_int value)
+{
+	auto imm = jive::immediate_op::create(region, jive::immediate(value));
+	return jive::create_instruction(region, icls, {operand, imm});
+}
+
+static void
+test_fold_immediate()
+{
+	using namespace jive::i386;
+
+	jive::bittype bt(32);
+	jive::graph graph;
+	auto x = graph.add_import({bt, "x"});
+	auto y = graph.add_import({bt, "y"});
+	auto z = graph.add_import({bt, "z"});
+
+	auto imm = jive::immediate_op::create(graph.root(), jive::immediate(42));
+	auto load1 = jive::create_instruction(graph.root(), &instr_int_load_imm::instance(), {imm});
+	auto load2 = jive::create_instruction(graph.root(), &instr_int_load_imm::instance(), {imm});
+	auto add = jive::create_instruction(graph.root(), &instr_int_add::instance(),
+		{load1->output(0), x});
+	auto sub = jive::create_instruction(graph.root(), &instr_int_sub::instance(),
+		{y, load2->output(0)});
+	/* subtraction is not commutative */
+	auto sub2 = jive::create_instruction(graph.root(), &instr_int_sub::instance(),
+		{load2->output(0), z});
+
+	auto ex1 = graph.add_export(add->output(0), {bt, "a"});
+	auto ex2 = graph.add_export(sub->output(0), {bt, "b"});
+	auto ex3 = graph.add_export(sub2->output(0), {bt, "c"});
+
+	jive::i386::optimize_peephole(&graph);
+
+	assert(icls(ex1->origin()) == &instr_int_add_immediate::instance());
+	assert(ex1->origin()->node()->input(0)->origin() == x);
+	assert(immediate_value(ex1->origin()) == 42);
+	assert(icls(ex2->origin()) == &instr_int_sub_immediate::instance());
+	assert(immediate_value(ex2->origin()) == 42);
+
+	/* both loads are identical and share a single node */
+	assert(icls(ex3->origin()) == &instr_int_sub::instance());
+	auto load = ex3->origin()->node()->input(0)->origin();
+	assert(icls(load) == &instr_int_load_imm::instance());
+	assert(graph.root()->nnodes() == 5);
+}
+
+static void
+test_arithmetic()
+{
+	using namespace jive::i386;
+
+	jive::bittype bt(32);
+	jive::graph graph;
+	auto x = graph.add_import({bt, "x"});
+	auto y = graph.add_import({bt, "y"});
+
+	auto add1 = create_regimm(graph.root(), &instr_int_add_immediate::instance(), y, 3);
+	auto add2 = create_regimm(graph.root(), &instr_int_add_immediate::instance(),
+		add1->output(0), 4);
+	auto add3 = create_regimm(graph.root(), &instr_int_add_immediate::instance(),
+		add2->output(0), 5);
+	auto zero = create_regimm(graph.root(), &instr_int_or_immediate::instance(), x, 0);
+	auto mask = create_regimm(graph.root(), &instr_int_and_immediate::instance(), x, -1);
+	auto mul = create_regimm(graph.root(), &instr_int_mul_immediate::instance(), x, 8);
+	auto mul3 = create_regimm(graph.root(), &instr_int_mul_immediate::instance(), x, 3);
+
+	/* the condition codes of this addition are used */
+	auto add4 = create_regimm(graph.root(), &instr_int_add_immediate::instance(), x, 0);
+
+	auto ex1 = graph.add_export(add3->output(0), {bt, "a"});
+	auto ex2 = graph.add_export(zero->output(0), {bt, "b"});
+	auto ex3 = graph.add_export(mask->output(0), {bt, "c"});
+	auto ex4 = graph.add_export(mul->output(0), {bt, "d"});
+	auto ex5 = graph.add_export(mul3->output(0), {bt, "e"});
+	auto ex6 = graph.add_export(add4->output(0), {bt, "f"});
+	graph.add_export(add4->output(1), {add4->output(1)->type(), "g"});
+
+	jive::i386::optimize_peephole(&graph);
+
+	assert(icls(ex1->origin()) == &instr_int_add_immediate::instance());
+	assert(ex1->origin()->node()->input(0)->origin() == y);
+	assert(immediate_value(ex1->origin()) == 12);
+	assert(ex2->origin() == x);
+	assert(ex3->origin() == x);
+	assert(icls(ex4->origin()) == &instr_int_shl_immediate::instance());
+	assert(immediate_value(ex4->origin()) == 3);
+	assert(icls(ex5->origin()) == &instr_int_mul_immediate::instance());
+	assert(icls(ex6->origin()) == &instr_int_add_immediate::instance());
+}
+
+static void
+test_chain_flags()
+{
+	using namespace jive::i386;
+
+	jive::bittype bt(32);
+	jive::graph graph;
+	auto x = graph.add_import({bt, "x"});
+
+	/* the carry of the combined addition differs from the one of the outer addition */
+	auto add1 = create_regimm(graph.root(), &instr_int_add_immediate::instance(), x, 1);
+	auto add2 = create_regimm(graph.root(), &instr_int_add_immediate::instance(),
+		add1->output(0), -1);
+
+	auto ex1 = graph.add_export(add2->output(0), {bt, "a"});
+	auto ex2 = graph.add_export(add2->output(1), {add2->output(1)->type(), "b"});
+
+	jive::i386::optimize_peephole(&graph);
+
+	assert(ex1->origin() == add2->output(0));
+	assert(ex2->origin() == add2->output(1));
+	assert(add2->input(0)->origin() == add1->output(0));
+}
+
+static void
+test_lea()
+{
+	using namespace jive::i386;
+
+	jive::bittype bt(32);
+	jive::graph graph;
+	auto x = graph.add_import({bt, "x"});
+	auto y = graph.add_import({bt, "y"});
+
+	/* x and y remain live after the additions */
+	auto add = create_regimm(graph.root(), &instr_int_add_immediate::instance(), x, 4);
+	auto sub = create_regimm(graph.root(), &instr_int_sub_immediate::instance(), y, 8);
+	auto add2 = create_regimm(graph.root(), &instr_int_add_immediate::instance(), y, 16);
+
+	auto ex1 = graph.add_export(add->output(0), {bt, "a"});
+	auto ex2 = graph.add_export(sub->output(0), {bt, "b"});
+	auto ex3 = graph.add_export(add2->output(0), {bt, "c"});
+	graph.add_export(add2->output(1), {add2->output(1)->type(), "d"});
+	graph.add_export(x, {bt, "e"});
+
+	jive::i386::optimize_peephole(&graph);
+
+	assert(icls(ex1->origin()) == &instr_int_lea_disp::instance());
+	assert(ex1->origin()->node()->input(0)->origin() == x);
+	assert(immediate_value(ex1->origin()) == 4);
+	assert(icls(ex2->origin()) == &instr_int_lea_disp::instance());
+	assert(ex2->origin()->node()->input(0)->origin() == y);
+	assert(immediate_value(ex2->origin()) == -8);
+
+	/* lea does not produce condition codes */
+	assert(icls(ex3->origin()) == &instr_int_add_immediate::instance());
+}
+
+static int
+test_main()
+{
+	test_fold_immediate();
+	test_arithmetic();
+	test_chain_flags();
+	test_lea();
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("backend/i386/test-peephole", test_main)
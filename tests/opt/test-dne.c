@@ -0,0 +1,155 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-registry.h"
+#include "testnodes.h"
+#include "testtypes.h"
+
+#include <jive/opt/dne.h>
+#include <jive/rvsdg/control.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/graph.h>
+#include <jive/rvsdg/phi.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/types/function.h>
+#include <jive/view.h>
+
+static void
+test_gamma()
+{
+	using namespace jive;
+
+	jive::graph graph;
+	test::valuetype vt;
+
+	auto p = graph.add_import({ctl2, "p"});
+	auto x = graph.add_import({vt, "x"});
+	auto y = graph.add_import({vt, "y"});
+
+	auto gamma = gamma_node::create(p, 2);
+	auto evx = gamma->add_entryvar(x);
+	auto evy = gamma->add_entryvar(y);
+
+	auto u0 = test::unary_op::create(gamma->subregion(0), vt, evx->argument(0), vt)->output(0);
+	auto u1 = test::unary_op::create(gamma->subregion(1), vt, evx->argument(1), vt)->output(0);
+	auto b0 = test::binary_op::create(vt, vt, evx->argument(0), evy->argument(0))->output(0);
+	auto b1 = test::binary_op::create(vt, vt, evx->argument(1), evy->argument(1))->output(0);
+	gamma->add_exitvar({u0, u1});
+	gamma->add_exitvar({b0, b1});
+
+	auto ex = graph.add_export(gamma->output(0), {vt, "g"});
+
+	dne(&graph);
+//	jive::view(graph.root(), stdout);
+
+	assert(ex->origin() == gamma->output(0));
+	assert(gamma->noutputs() == 1 && gamma->ninputs() == 2);
+	for (size_t n = 0; n < gamma->nsubregions(); n++) {
+		assert(gamma->subregion(n)->nnodes() == 1);
+		assert(gamma->subregion(n)->narguments() == 1);
+		assert(gamma->subregion(n)->nresults() == 1);
+	}
+}
+
+static void
+test_theta()
+{
+	using namespace jive;
+
+	jive::graph graph;
+	test::valuetype vt;
+
+	auto x = graph.add_import({vt, "x"});
+	auto y = graph.add_import({vt, "y"});
+	auto z = graph.add_import({vt, "z"});
+
+	auto theta = theta_node::create(graph.root());
+	auto lvx = theta->add_loopvar(x);
+	auto lvy = theta->add_loopvar(y);
+	auto lvz = theta->add_loopvar(z);
+
+	/* the argument of w is never read, but its initial value is live */
+	auto u = test::unary_op::create(graph.root(), vt, x, vt)->output(0);
+	auto lvw = theta->add_loopvar(u);
+
+	/* y is only used within the loop, z is not used at all */
+	auto b = test::binary_op::create(vt, vt, lvx->argument(), lvy->argument())->output(0);
+	auto uy = test::unary_op::create(theta->subregion(), vt, lvy->argument(), vt)->output(0);
+	auto uz = test::unary_op::create(theta->subregion(), vt, lvz->argument(), vt)->output(0);
+	lvx->result()->divert_to(b);
+	lvy->result()->divert_to(uy);
+	lvz->result()->divert_to(uz);
+	auto ux = test::unary_op::create(theta->subregion(), vt, lvx->argument(), vt)->output(0);
+	lvw->result()->divert_to(ux);
+	theta->set_predicate(jive_control_false(theta->subregion()));
+
+	graph.add_export(lvx, {vt, "x"});
+	graph.add_export(lvw, {vt, "w"});
+
+	dne(&graph);
+//	jive::view(graph.root(), stdout);
+
+	assert(theta->noutputs() == 3 && theta->ninputs() == 3);
+	assert(theta->input(1)->origin() == y);
+	assert(theta->input(2)->origin() == u);
+	assert(graph.root()->nnodes() == 2);
+	assert(theta->subregion()->nnodes() == 4);
+}
+
+static void
+test_phi()
+{
+	using namespace jive;
+
+	jive::graph graph;
+	test::valuetype vt;
+	fcttype ft({&vt}, {&vt});
+
+	auto z = graph.add_import({vt, "z"});
+
+	phi_builder pb;
+	pb.begin_phi(graph.root());
+	auto dz = pb.add_dependency(z);
+	auto rv1 = pb.add_recvar(ft);
+	auto rv2 = pb.add_recvar(ft);
+
+	/* f1 does not use its dependencies */
+	lambda_builder lb;
+	auto arguments = lb.begin_lambda(pb.region(), ft);
+	lb.add_dependency(dz);
+	lb.add_dependency(rv2->value());
+	auto f1 = lb.end_lambda({arguments[0]});
+
+	/* f2 is only reachable from the dead recursion variable */
+	arguments = lb.begin_lambda(pb.region(), ft);
+	auto d = lb.add_dependency(dz);
+	auto f2 = lb.end_lambda({test::binary_op::create(vt, vt, arguments[0], d)->output(0)});
+
+	rv1->set_value(f1->output(0));
+	rv2->set_value(f2->output(0));
+	auto phi = pb.end_phi();
+
+	graph.add_export(phi->output(0), {ft, "f1"});
+
+	dne(&graph);
+//	jive::view(graph.root(), stdout);
+
+	assert(phi->noutputs() == 1 && phi->ninputs() == 0);
+	assert(phi->subregion(0)->nnodes() == 1);
+	assert(phi->subregion(0)->narguments() == 1);
+	assert(f1->ninputs() == 0 && f1->subregion()->narguments() == 1);
+}
+
+static int
+test_main()
+{
+	test_gamma();
+	test_theta();
+	test_phi();
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("opt/test-dne", test_main)
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-registry.h"
+#include "testnodes.h"
+#include "testtypes.h"
+
+#include <jive/opt/gvn.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/graph.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/view.h>
+
+static void
+test_gamma()
+{
+	using namespace jive;
+
+	jive::graph graph;
+	test::valuetype vt;
+
+	auto p = graph.add_import({ctl2, "p"});
+	auto x = graph.add_import({vt, "x"});
+	auto y = graph.add_import({vt, "y"});
+
+	auto u1 = test::unary_op::create(graph.root(), vt, x, vt)->output(0);
+	auto u2 = test::unary_op::create(graph.root(), vt, x, vt)->output(0);
+	auto b = test::binary_op::create(vt, vt, u2, y)->output(0);
+
+	auto gamma = gamma_node::create(p, 2);
+	auto evx = gamma->add_entryvar(x);
+	auto evy = gamma->add_entryvar(y);
+	auto evu = gamma->add_entryvar(u1);
+
+	/* available in the parent region */
+	auto u3 = test::unary_op::create(gamma->subregion(0), vt, evx->argument(0), vt)->output(0);
+	auto b1 = test::binary_op::create(vt, vt, u3, evy->argument(0))->output(0);
+	/* only computed in the alternatives */
+	auto b2 = test::binary_op::create(vt, vt, evu->argument(1), evx->argument(1))->output(0);
+	auto b3 = test::binary_op::create(vt, vt, b2, evy->argument(1))->output(0);
+	gamma->add_exitvar({b1, b3});
+
+	auto ex1 = graph.add_export(b, {vt, "b"});
+	auto ex2 = graph.add_export(gamma->output(0), {vt, "g"});
+
+	gvn(&graph);
+//	jive::view(graph.root(), stdout);
+
+	assert(graph.root()->nnodes() == 3);
+	assert(ex1->origin() == b);
+	assert(b->node()->input(0)->origin() == u1);
+	assert(ex2->origin() == gamma->output(0));
+
+	auto argument = dynamic_cast<const jive::argument*>(gamma->subregion(0)->result(0)->origin());
+	assert(argument && argument->input()->origin() == b);
+	assert(gamma->subregion(0)->nnodes() == 0);
+	assert(gamma->subregion(1)->nnodes() == 2);
+}
+
+static void
+test_theta()
+{
+	using namespace jive;
+
+	jive::graph graph;
+	test::valuetype vt;
+
+	auto x = graph.add_import({vt, "x"});
+	auto y = graph.add_import({vt, "y"});
+
+	auto ux = test::unary_op::create(graph.root(), vt, x, vt)->output(0);
+	auto uy = test::unary_op::create(graph.root(), vt, y, vt)->output(0);
+
+	auto theta = theta_node::create(graph.root());
+	auto lvx = theta->add_loopvar(x);
+	auto lvy = theta->add_loopvar(y);
+
+	/* x is invariant, y changes in each iteration */
+	auto u1 = test::unary_op::create(theta->subregion(), vt, lvx->argument(), vt)->output(0);
+	auto u2 = test::unary_op::create(theta->subregion(), vt, lvy->argument(), vt)->output(0);
+	auto b = test::binary_op::create(vt, vt, u1, u2)->output(0);
+	lvy->result()->divert_to(b);
+	theta->set_predicate(jive_control_false(theta->subregion()));
+
+	graph.add_export(ux, {vt, "x"});
+	graph.add_export(uy, {vt, "y"});
+	graph.add_export(lvy, {vt, "z"});
+
+	gvn(&graph);
+//	jive::view(graph.root(), stdout);
+
+	assert(theta->subregion()->nnodes() == 3);
+	assert(u2->node()->region() == theta->subregion());
+	auto argument = dynamic_cast<const jive::argument*>(b->node()->input(0)->origin());
+	assert(argument && argument->input()->origin() == ux);
+}
+
+static int
+test_main()
+{
+	test_gamma();
+	test_theta();
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("opt/test-gvn", test_main)
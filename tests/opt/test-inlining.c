@@ -0,0 +1,170 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-registry.h"
+
+#include <jive/evaluator/eval.h>
+#include <jive/evaluator/literal.h>
+#include <jive/opt/inlining.h>
+#include <jive/rvsdg.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/phi.h>
+#include <jive/types/bitstring.h>
+#include <jive/types/function.h>
+#include <jive/view.h>
+
+static size_t
+napplies(const jive::region * region)
+{
+	size_t n = 0;
+	for (const auto & node : region->nodes) {
+		if (jive::is<jive::apply_op>(&node))
+			n++;
+
+		if (auto snode = dynamic_cast<const jive::structural_node*>(&node)) {
+			for (size_t r = 0; r < snode->nsubregions(); r++)
+				n += napplies(snode->subregion(r));
+		}
+	}
+
+	return n;
+}
+
+static jive::bitvalue_repr
+evaluate(const jive::graph * graph, const std::string & name, uint64_t value)
+{
+	using namespace jive::eval;
+
+	bitliteral arg(jive::bitvalue_repr(32, value));
+	auto result = eval(graph, name, {&arg})->copy();
+	auto fctlit = dynamic_cast<const fctliteral*>(result.get());
+	assert(fctlit->nresults() == 1);
+	return dynamic_cast<const bitliteral*>(&fctlit->result(0))->value_repr();
+}
+
+static void
+setup_call(jive::graph * graph)
+{
+	using namespace jive;
+
+	auto c = create_bitconstant(graph->root(), 32, 5);
+
+	/* f(x) = x + c */
+	lambda_builder lb;
+	auto arguments = lb.begin_lambda(graph->root(), {{&bit32}, {&bit32}});
+	auto d = lb.add_dependency(c);
+	auto f = lb.end_lambda({bitadd_op::create(32, arguments[0], d)})->output(0);
+
+	/* g(y) = y < 10 ? y : f(y) */
+	arguments = lb.begin_lambda(graph->root(), {{&bit32}, {&bit32}});
+	auto y = arguments[0];
+	auto fct = lb.add_dependency(f);
+
+	auto ten = create_bitconstant(lb.subregion(), 32, 10);
+	auto predicate = match(1, {{0,0}}, 1, 2, bitult_op::create(32, y, ten));
+	auto gamma = gamma_node::create(predicate, 2);
+	auto ev1 = gamma->add_entryvar(fct);
+	auto ev2 = gamma->add_entryvar(y);
+	auto call = create_apply(ev1->argument(0), {ev2->argument(0)})[0];
+	gamma->add_exitvar({call, ev2->argument(1)});
+
+	auto g = lb.end_lambda({gamma->output(0)})->output(0);
+	graph->add_export(g, {g->type(), "g"});
+}
+
+static void
+test_call()
+{
+	jive::graph graph;
+	setup_call(&graph);
+
+	assert(evaluate(&graph, "g", 3) == 3);
+	assert(evaluate(&graph, "g", 12) == 17);
+
+	/* the callee is too large */
+	jive::inlining(&graph, 0, 0);
+	assert(napplies(graph.root()) == 1);
+
+	jive::inlining(&graph, 8, 0);
+//	jive::view(graph.root(), stdout);
+
+	assert(napplies(graph.root()) == 0);
+	assert(evaluate(&graph, "g", 3) == 3);
+	assert(evaluate(&graph, "g", 12) == 17);
+}
+
+static void
+setup_fib(jive::graph * graph)
+{
+	using namespace jive;
+
+	fcttype ft({&bit32}, {&bit32});
+
+	phi_builder pb;
+	pb.begin_phi(graph->root());
+	auto rv = pb.add_recvar(ft);
+
+	lambda_builder lb;
+	auto arguments = lb.begin_lambda(pb.region(), {{&bit32}, {&bit32}});
+	auto dep = lb.add_dependency(rv->value());
+
+	auto n = arguments[0];
+	auto one = create_bitconstant(lb.subregion(), 32, 1);
+	auto two = create_bitconstant(lb.subregion(), 32, 2);
+
+	auto predicate = match(1, {{0,0}}, 1, 2, bitult_op::create(32, n, two));
+	auto gamma = gamma_node::create(predicate, 2);
+	auto evf = gamma->add_entryvar(dep);
+	auto evn = gamma->add_entryvar(n);
+	auto ev1 = gamma->add_entryvar(one);
+	auto ev2 = gamma->add_entryvar(two);
+
+	auto tmp1 = bitsub_op::create(32, evn->argument(0), ev1->argument(0));
+	tmp1 = create_apply(evf->argument(0), {tmp1})[0];
+	auto tmp2 = bitsub_op::create(32, evn->argument(0), ev2->argument(0));
+	tmp2 = create_apply(evf->argument(0), {tmp2})[0];
+	gamma->add_exitvar({bitadd_op::create(32, tmp1, tmp2), evn->argument(1)});
+
+	auto fib = lb.end_lambda({gamma->output(0)})->output(0);
+	rv->set_value(fib);
+	pb.end_phi();
+
+	graph->add_export(rv->value(), {rv->value()->type(), "fib"});
+}
+
+static void
+test_recursion()
+{
+	jive::graph graph;
+	setup_fib(&graph);
+
+	bool recursive = false;
+	auto phi = static_cast<jive::structural_node*>(graph.root()->result(0)->origin()->node());
+	auto lambda = jive::callee(graph.root()->result(0)->origin(), &recursive);
+	assert(lambda && lambda->region() == phi->subregion(0) && !recursive);
+	assert(napplies(graph.root()) == 2);
+	assert(evaluate(&graph, "fib", 8) == 21);
+
+	/* each round unfolds both recursive calls once more */
+	jive::inlining(&graph, 100, 2);
+//	jive::view(graph.root(), stdout);
+
+	assert(napplies(graph.root()) == 8);
+	assert(evaluate(&graph, "fib", 0) == 0);
+	assert(evaluate(&graph, "fib", 1) == 1);
+	assert(evaluate(&graph, "fib", 2) == 1);
+	assert(evaluate(&graph, "fib", 8) == 21);
+}
+
+static int
+test_main()
+{
+	test_call();
+	test_recursion();
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("opt/test-inlining", test_main)
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-registry.h"
+#include "testnodes.h"
+#include "testtypes.h"
+
+#include <jive/opt/licm.h>
+#include <jive/rvsdg/control.h>
+#include <jive/rvsdg/graph.h>
+#include <jive/rvsdg/theta.h>
+
+static void
+test_hoisting()
+{
+	using namespace jive;
+
+	jive::graph graph;
+	test::valuetype vt;
+	test::statetype st;
+
+	auto x = graph.add_import({vt, "x"});
+	auto y = graph.add_import({vt, "y"});
+	auto s = graph.add_import({st, "s"});
+
+	auto theta = theta_node::create(graph.root());
+	auto lvx = theta->add_loopvar(x);
+	auto lvy = theta->add_loopvar(y);
+	auto lvs = theta->add_loopvar(s);
+
+	/* invariant computation */
+	auto inv = test::binary_op::create(vt, vt, lvx->argument(), lvx->argument())->output(0);
+	auto inv2 = test::unary_op::create(theta->subregion(), vt, inv, vt)->output(0);
+	/* variant computation depending on the invariant one */
+	auto var = test::binary_op::create(vt, vt, inv2, lvy->argument())->output(0);
+	lvy->result()->divert_to(var);
+	/* state operands block hoisting */
+	auto snode = test::simple_node_create(theta->subregion(), {vt, st}, {lvx->argument(),
+		lvs->argument()}, {st});
+	lvs->result()->divert_to(snode->output(0));
+	auto predicate = jive_control_constant(theta->subregion(), 2, 1);
+	theta->set_predicate(predicate);
+
+	auto ex1 = graph.add_export(lvy, {lvy->type(), "y"});
+	auto ex2 = graph.add_export(lvs, {lvs->type(), "s"});
+
+	licm(&graph);
+
+	assert(ex1->origin()->node() == theta);
+	assert(ex2->origin()->node() == theta);
+	assert(theta->subregion()->nnodes() == 3);
+	assert(snode->region() == theta->subregion());
+	assert(graph.root()->nnodes() == 3);
+
+	/* only the value used inside the loop enters it as new loop variable */
+	assert(theta->nloopvars() == 4);
+	auto origin = lvy->result()->origin()->node()->input(0)->origin();
+	auto argument = dynamic_cast<const jive::argument*>(origin);
+	assert(argument && argument->input()->origin()->node()->region() == graph.root());
+	assert(dynamic_cast<const test::unary_op*>(&argument->input()->origin()->node()->operation()));
+}
+
+static void
+test_nested()
+{
+	using namespace jive;
+
+	jive::graph graph;
+	test::valuetype vt;
+
+	auto x = graph.add_import({vt, "x"});
+	auto y = graph.add_import({vt, "y"});
+
+	auto outer = theta_node::create(graph.root());
+	auto olvx = outer->add_loopvar(x);
+	auto olvy = outer->add_loopvar(y);
+
+	auto inner = theta_node::create(outer->subregion());
+	auto ilvx = inner->add_loopvar(olvx->argument());
+	auto ilvy = inner->add_loopvar(olvy->argument());
+
+	auto inv = test::binary_op::create(vt, vt, ilvx->argument(), ilvx->argument())->output(0);
+	auto var = test::binary_op::create(vt, vt, inv, ilvy->argument())->output(0);
+	ilvy->result()->divert_to(var);
+	inner->set_predicate(jive_control_false(inner->subregion()));
+
+	olvy->result()->divert_to(ilvy);
+	outer->set_predicate(jive_control_false(outer->subregion()));
+
+	auto ex = graph.add_export(olvy, {olvy->type(), "y"});
+
+	licm(&graph);
+
+	/* the invariant node is hoisted through both loops */
+	assert(ex->origin()->node() == outer);
+	assert(inner->subregion()->nnodes() == 2);
+	assert(outer->subregion()->nnodes() == 2);
+	assert(graph.root()->nnodes() == 2);
+}
+
+static void
+test_constants()
+{
+	using namespace jive;
+
+	jive::graph graph;
+	test::valuetype vt;
+
+	auto x = graph.add_import({vt, "x"});
+	auto y = graph.add_import({vt, "y"});
+
+	auto theta = theta_node::create(graph.root());
+	auto lvx = theta->add_loopvar(x);
+	auto lvy = theta->add_loopvar(y);
+
+	auto c = test::simple_node_create(theta->subregion(), {}, {}, {vt})->output(0);
+	auto inv = test::binary_op::create(vt, vt, lvy->argument(), c)->output(0);
+	auto sum = test::binary_op::create(vt, vt, lvx->argument(), inv)->output(0);
+	lvx->result()->divert_to(sum);
+	theta->set_predicate(jive_control_false(theta->subregion()));
+
+	auto ex = graph.add_export(lvx, {lvx->type(), "x"});
+
+	licm(&graph);
+
+	/* the constant is copied out of the loop, the predicate stays */
+	assert(ex->origin()->node() == theta);
+	assert(theta->subregion()->nnodes() == 2);
+	assert(graph.root()->nnodes() == 3);
+	assert(theta->nloopvars() == 3);
+	assert(dynamic_cast<const jive::ctlconstant_op*>(&theta->predicate()->origin()->node()->operation()));
+}
+
+static int
+test_main()
+{
+	test_hoisting();
+	test_nested();
+	test_constants();
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("opt/test-licm", test_main)
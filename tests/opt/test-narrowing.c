@@ -0,0 +1,74 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-registry.h"
+
+#include <jive/evaluator/eval.h>
+#include <jive/evaluator/literal.h>
+#include <jive/opt/narrowing.h>
+#include <jive/rvsdg.h>
+#include <jive/types/bitstring.h>
+#include <jive/types/function.h>
+#include <jive/view.h>
+
+static uint64_t
+evaluate(const jive::graph * graph, uint64_t x, uint64_t y)
+{
+	using namespace jive::eval;
+
+	bitliteral arg1(jive::bitvalue_repr(32, x));
+	bitliteral arg2(jive::bitvalue_repr(32, y));
+	auto result = eval(graph, "f", {&arg1, &arg2})->copy();
+	auto fctlit = dynamic_cast<const fctliteral*>(result.get());
+	return dynamic_cast<const bitliteral*>(&fctlit->result(0))->value_repr().to_uint();
+}
+
+/*
+	f(x, y) { return ((x & 0xff) + (y & 0xff)) ^ ((x | 1) & 1); }
+*/
+static int
+test_main()
+{
+	using namespace jive;
+
+	jive::graph graph;
+
+	lambda_builder lb;
+	auto arguments = lb.begin_lambda(graph.root(), {{&bit32, &bit32}, {&bit32}});
+
+	auto mask = create_bitconstant(lb.subregion(), 32, 0xff);
+	auto one = create_bitconstant(lb.subregion(), 32, 1);
+	auto a = bitand_op::create(32, arguments[0], mask);
+	auto b = bitand_op::create(32, arguments[1], mask);
+	auto c = bitand_op::create(32, bitor_op::create(32, arguments[0], one), one);
+	auto sum = bitxor_op::create(32, bitadd_op::create(32, a, b), c);
+
+	auto lambda = lb.end_lambda({sum});
+	auto f = lambda->output(0);
+	graph.add_export(f, {f->type(), "f"});
+
+	assert(evaluate(&graph, 0x1234, 0x56ff) == 0x132);
+
+	narrow(&graph);
+//	jive::view(graph.root(), stdout);
+
+	/* the exclusive or is performed on nine bits */
+	auto result = lambda->subregion()->result(0)->origin();
+	assert(is<bitconcat_op>(result->node()));
+	auto low = result->node()->input(0)->origin();
+	assert(is<bitxor_op>(low->node()));
+	assert(static_cast<const bittype*>(&low->type())->nbits() == 9);
+
+	/* the last operand is folded to a constant */
+	assert(is<bitconstant_op>(low->node()->input(0)->origin()->node())
+		|| is<bitconstant_op>(low->node()->input(1)->origin()->node()));
+
+	assert(evaluate(&graph, 0x1234, 0x56ff) == 0x132);
+	assert(evaluate(&graph, 0xffff, 0xffff) == 0x1ff);
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("opt/test-narrowing", test_main)
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-registry.h"
+
+#include <jive/evaluator/eval.h>
+#include <jive/evaluator/literal.h>
+#include <jive/opt/unroll.h>
+#include <jive/rvsdg.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/types/bitstring.h>
+#include <jive/types/function.h>
+#include <jive/view.h>
+
+static uint64_t
+evaluate(const jive::graph * graph, uint64_t value)
+{
+	using namespace jive::eval;
+
+	bitliteral arg(jive::bitvalue_repr(32, value));
+	auto result = eval(graph, "f", {&arg})->copy();
+	auto fctlit = dynamic_cast<const fctliteral*>(result.get());
+	return dynamic_cast<const bitliteral*>(&fctlit->result(0))->value_repr().to_uint();
+}
+
+/*
+	f(x) { s = x; i = 0; do { s = s + i; i = i + 2; } while (cmp(i)); return s; }
+*/
+static jive::theta_node *
+setup(jive::graph * graph, bool updated)
+{
+	using namespace jive;
+
+	lambda_builder lb;
+	auto arguments = lb.begin_lambda(graph->root(), {{&bit32}, {&bit32}});
+
+	/* the counter starts at the argument until the body is built, otherwise it is folded */
+	auto theta = theta_node::create(lb.subregion());
+	auto lvs = theta->add_loopvar(arguments[0]);
+	auto lvi = theta->add_loopvar(arguments[0]);
+
+	auto two = create_bitconstant(theta->subregion(), 32, 2);
+	auto bound = create_bitconstant(theta->subregion(), 32, 15);
+	auto s = bitadd_op::create(32, lvs->argument(), lvi->argument());
+	auto i = bitadd_op::create(32, lvi->argument(), two);
+	lvs->result()->divert_to(s);
+	lvi->result()->divert_to(i);
+
+	/* i < 15 after the update, or 15 > i before it */
+	auto cmp = updated
+		? bitult_op::create(32, i, bound)
+		: bitugt_op::create(32, bound, lvi->argument());
+	theta->set_predicate(match(1, {{0, 0}}, 1, 2, cmp));
+	lvi->input()->divert_to(create_bitconstant(lb.subregion(), 32, 0));
+
+	auto f = lb.end_lambda({lvs})->output(0);
+	graph->add_export(f, {f->type(), "f"});
+
+	return theta;
+}
+
+static size_t
+nthetas(const jive::region * region)
+{
+	size_t n = 0;
+	for (const auto & node : region->nodes) {
+		if (dynamic_cast<const jive::theta_node*>(&node))
+			n++;
+
+		if (auto snode = dynamic_cast<const jive::structural_node*>(&node)) {
+			for (size_t r = 0; r < snode->nsubregions(); r++)
+				n += nthetas(snode->subregion(r));
+		}
+	}
+
+	return n;
+}
+
+static void
+test_trip_count()
+{
+	jive::graph graph1, graph2;
+	auto theta1 = setup(&graph1, true);
+	auto theta2 = setup(&graph2, false);
+
+	assert(jive::trip_count(theta1, 100) == 8);
+	assert(jive::trip_count(theta2, 100) == 9);
+	assert(jive::trip_count(theta1, 6) == 0);
+}
+
+static void
+test_full()
+{
+	jive::graph graph;
+	setup(&graph, true);
+	assert(evaluate(&graph, 1) == 57);
+
+	/* the loop is too large for the first attempt */
+	jive::unroll(&graph, 20, 0);
+	assert(nthetas(graph.root()) == 1);
+
+	jive::unroll(&graph, 100, 0);
+//	jive::view(graph.root(), stdout);
+
+	assert(nthetas(graph.root()) == 0);
+	assert(evaluate(&graph, 1) == 57);
+}
+
+static void
+test_partial()
+{
+	jive::graph graph;
+	auto theta = setup(&graph, false);
+	assert(evaluate(&graph, 1) == 73);
+
+	/* nine iterations: one is peeled, the loop executes twice */
+	auto nnodes = theta->subregion()->nnodes();
+	assert(jive::unroll(theta, 4));
+	graph.prune();
+//	jive::view(graph.root(), stdout);
+
+	assert(nthetas(graph.root()) == 1);
+	assert(theta->subregion()->nnodes() > nnodes);
+	assert(evaluate(&graph, 1) == 73);
+}
+
+static int
+test_main()
+{
+	test_trip_count();
+	test_full();
+	test_partial();
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("opt/test-unroll", test_main)
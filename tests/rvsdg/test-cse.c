@@ -52,6 +52,7 @@ test_main()
 
 	auto o7 = test::simple_node_normalized_create(graph.root(), {}, {}, {t})[0];
 	assert(o7 != e1->origin());
+	assert(o7->node()->normal_form() == nf);
 
 	graph.normalize();
 	assert(o7 != e1->origin());
@@ -60,3 +61,43 @@ test_main()
 }
 
 JIVE_UNIT_TEST_REGISTER("rvsdg/test-cse", test_main)
+
+static int
+test_incremental()
+{
+	using namespace jive;
+
+	test::valuetype t;
+
+	jive::graph graph;
+	auto i = graph.add_import({t, "i"});
+
+	auto n1 = test::simple_node_create(graph.root(), {t}, {i}, {t});
+	auto e1 = graph.add_export(n1->output(0), {t, "o1"});
+	graph.normalize();
+
+	/* nodes created without normalization are revisited */
+	auto n2 = test::simple_node_create(graph.root(), {t}, {i}, {t});
+	auto e2 = graph.add_export(n2->output(0), {t, "o2"});
+
+	/* removed dirty nodes are dropped from the worklist */
+	auto n3 = test::simple_node_create(graph.root(), {t}, {i}, {t});
+	remove(n3);
+
+	graph.normalize();
+	assert(e1->origin() == e2->origin());
+
+	/* users of diverted outputs are revisited */
+	auto n4 = test::simple_node_create(graph.root(), {t}, {e1->origin()}, {t});
+	auto n5 = test::simple_node_create(graph.root(), {t}, {i}, {t});
+	auto n6 = test::simple_node_create(graph.root(), {t}, {n5->output(0)}, {t});
+	auto e3 = graph.add_export(n4->output(0), {t, "o3"});
+	auto e4 = graph.add_export(n6->output(0), {t, "o4"});
+
+	graph.normalize();
+	assert(e3->origin() == e4->origin());
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("rvsdg/test-cse-incremental", test_incremental)
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2017 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-registry.h"
+#include "testnodes.h"
+#include "testtypes.h"
+
+#include <assert.h>
+
+#include <jive/rvsdg/equivalence.h>
+#include <jive/rvsdg/graph.h>
+#include <jive/types/bitstring.h>
+#include <jive/types/function.h>
+
+static void
+test_structural_hash()
+{
+	using namespace jive;
+
+	test::valuetype vt;
+
+	jive::graph graph;
+	auto x = graph.add_import({vt, "x"});
+	auto y = graph.add_import({vt, "y"});
+
+	auto n1 = test::simple_node_create(graph.root(), {vt}, {x}, {vt});
+	auto n2 = test::simple_node_create(graph.root(), {vt}, {x}, {vt});
+	auto n3 = test::simple_node_create(graph.root(), {vt}, {n1->output(0)}, {vt});
+
+	assert(n1->structural_hash() == n2->structural_hash());
+
+	auto hash = n3->structural_hash();
+	n1->input(0)->divert_to(y);
+	assert(n1->structural_hash() != n2->structural_hash());
+	assert(n3->structural_hash() != hash);
+
+	n1->input(0)->divert_to(x);
+	assert(n3->structural_hash() == hash);
+
+	/* changes inside a subregion invalidate the structural node */
+	auto s = test::structural_node_create(graph.root(), 1);
+	auto a = s->subregion(0)->add_argument(nullptr, vt);
+	auto n4 = test::simple_node_create(s->subregion(0), {vt}, {a}, {vt});
+	s->subregion(0)->add_result(a, nullptr, vt);
+
+	hash = s->structural_hash();
+	s->subregion(0)->result(0)->divert_to(n4->output(0));
+	assert(s->structural_hash() != hash);
+
+	/* attributes of operations and types take part in the hash */
+	auto c1 = create_bitconstant(graph.root(), 8, 3);
+	auto c2 = create_bitconstant(graph.root(), 8, 4);
+	auto c3 = create_bitconstant(graph.root(), 16, 3);
+	assert(structural_hash(c1) != structural_hash(c2));
+	assert(structural_hash(c1) != structural_hash(c3));
+	assert(c1->node()->operation().hash() == bitconstant_op(bitvalue_repr(8, 3)).hash());
+	assert(bit8.hash() == bittype(8).hash() && bit8.hash() != bit16.hash());
+
+	auto z = graph.add_import({bit16, "z"});
+	auto s1 = jive_bitslice(z, 0, 8);
+	auto s2 = jive_bitslice(z, 8, 16);
+	assert(structural_hash(s1) != structural_hash(s2));
+}
+
+static void
+test_graph_equivalence()
+{
+	using namespace jive;
+
+	test::valuetype vt;
+
+	jive::graph graph;
+	auto x = graph.add_import({vt, "x"});
+	auto y = graph.add_import({vt, "y"});
+
+	auto n1 = test::simple_node_create(graph.root(), {vt, vt}, {x, y}, {vt});
+	auto n2 = test::simple_node_create(graph.root(), {vt}, {n1->output(0)}, {vt});
+	graph.add_export(n2->output(0), {vt, "z"});
+
+	auto copy = graph.copy();
+	assert(jive_graphs_equivalent(&graph, copy.get()));
+
+	auto root = copy->root();
+	auto n3 = root->result(0)->origin()->node();
+	assert(n3 && n3->structural_hash() == n2->structural_hash());
+
+	jive::node * check1[] = {n2};
+	jive::node * check2[] = {n3};
+	assert(jive_graphs_equivalent(&graph, copy.get(), 1, check1, check2, 0, nullptr, nullptr));
+
+	/* swap operands of the copied node */
+	auto n4 = n3->input(0)->origin()->node();
+	n4->input(0)->divert_to(root->argument(1));
+	n4->input(1)->divert_to(root->argument(0));
+	assert(!jive_graphs_equivalent(&graph, copy.get()));
+	assert(!jive_graphs_equivalent(&graph, copy.get(), 1, check1, check2, 0, nullptr, nullptr));
+}
+
+static void
+test_subregion_equivalence()
+{
+	using namespace jive;
+
+	auto create_graph = [](uint64_t value)
+	{
+		std::unique_ptr<jive::graph> graph(new jive::graph());
+
+		lambda_builder lb;
+		lb.begin_lambda(graph->root(), {{}, {&bit32}});
+		auto c = create_bitconstant(lb.subregion(), 32, value);
+		auto f = lb.end_lambda({c})->output(0);
+		graph->add_export(f, {f->type(), "f"});
+
+		auto d = create_bitconstant(graph->root(), 32, 0);
+		graph->add_export(d, {d->type(), "d"});
+
+		return graph;
+	};
+
+	auto graph1 = create_graph(5);
+	auto graph2 = create_graph(5);
+	auto graph3 = create_graph(6);
+
+	auto f1 = graph1->root()->result(0)->origin()->node();
+	auto f2 = graph2->root()->result(0)->origin()->node();
+	auto f3 = graph3->root()->result(0)->origin()->node();
+
+	/* bodies that only differ in a constant */
+	assert(jive_graphs_equivalent(graph1.get(), graph2.get()));
+	assert(!jive_graphs_equivalent(graph1.get(), graph3.get()));
+	assert(f1->structural_hash() == f2->structural_hash());
+	assert(f1->structural_hash() != f3->structural_hash());
+
+	/* the detailed matcher agrees with the hash */
+	jive::node * check1[] = {f1};
+	jive::node * check2[] = {f3};
+	jive::node * assumed1[] = {graph1->root()->result(1)->origin()->node()};
+	jive::node * assumed2[] = {graph3->root()->result(1)->origin()->node()};
+	assert(!jive_graphs_equivalent(graph1.get(), graph3.get(), 1, check1, check2,
+		1, assumed1, assumed2));
+}
+
+static int
+test_main()
+{
+	test_structural_hash();
+	test_graph_equivalence();
+	test_subregion_equivalence();
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("rvsdg/test-equivalence", test_main)
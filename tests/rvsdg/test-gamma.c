@@ -150,6 +150,106 @@ test_control_constant_reduction()
 	assert(ex2->origin()->node() == gamma);
 }
 
+static void
+test_fusion()
+{
+	using namespace jive;
+
+	test::valuetype vt;
+
+	jive::graph graph;
+	gamma_op::normal_form(&graph)->set_fusion(true);
+
+	auto pred = graph.add_import({ctl2, "p"});
+	auto x = graph.add_import({vt, "x"});
+	auto y = graph.add_import({vt, "y"});
+
+	auto gamma1 = gamma_node::create(pred, 2);
+	auto ev1 = gamma1->add_entryvar(x);
+	auto u = test::unary_op::create(gamma1->subregion(0), vt, ev1->argument(0), vt)->output(0);
+	gamma1->add_exitvar({u, ev1->argument(1)});
+
+	auto gamma2 = gamma_node::create(pred, 2);
+	auto ev2 = gamma2->add_entryvar(x);
+	auto ev3 = gamma2->add_entryvar(y);
+	auto b = test::binary_op::create(vt, vt, ev2->argument(1), ev3->argument(1))->output(0);
+	gamma2->add_exitvar({ev3->argument(0), b});
+
+	/* depends on the first gamma */
+	auto gamma3 = gamma_node::create(pred, 2);
+	auto ev4 = gamma3->add_entryvar(gamma1->output(0));
+	gamma3->add_exitvar({ev4->argument(0), ev4->argument(1)});
+
+	auto ex1 = graph.add_export(gamma1->output(0), {vt, "r1"});
+	auto ex2 = graph.add_export(gamma2->output(0), {vt, "r2"});
+	auto ex3 = graph.add_export(gamma3->output(0), {vt, "r3"});
+
+	graph.normalize();
+	graph.prune();
+//	jive::view(graph.root(), stdout);
+
+	assert(graph.root()->nnodes() == 2);
+	auto gamma = static_cast<jive::structural_node*>(ex1->origin()->node());
+	assert(ex2->origin()->node() == gamma);
+	assert(ex3->origin()->node() != gamma);
+
+	/* the shared entry variable is not duplicated */
+	assert(gamma->ninputs() == 3);
+	assert(gamma->noutputs() == 2);
+	assert(gamma->subregion(0)->nnodes() == 1);
+	assert(gamma->subregion(1)->nnodes() == 1);
+}
+
+static void
+test_hoisting()
+{
+	using namespace jive;
+
+	test::valuetype vt;
+	test::statetype st;
+
+	jive::graph graph;
+	gamma_op::normal_form(&graph)->set_hoisting(true);
+
+	auto pred = graph.add_import({ctl2, "p"});
+	auto x = graph.add_import({vt, "x"});
+	auto s = graph.add_import({st, "s"});
+
+	auto gamma = gamma_node::create(pred, 2);
+	auto evx = gamma->add_entryvar(x);
+	auto evs = gamma->add_entryvar(s);
+
+	std::vector<jive::output*> values, states;
+	for (size_t n = 0; n < 2; n++) {
+		auto region = gamma->subregion(n);
+		auto c = test::simple_node_create(region, {}, {}, {vt})->output(0);
+		auto u = test::unary_op::create(region, vt, evx->argument(n), vt)->output(0);
+		auto b = test::binary_op::create(vt, vt, u, c)->output(0);
+		/* differs between the alternatives */
+		if (n == 1)
+			b = test::unary_op::create(region, vt, b, vt)->output(0);
+		values.push_back(b);
+
+		auto state = test::simple_node_create(region, {vt, st}, {evx->argument(n),
+			evs->argument(n)}, {st})->output(0);
+		states.push_back(state);
+	}
+	gamma->add_exitvar(values);
+	gamma->add_exitvar(states);
+
+	graph.add_export(gamma->output(0), {vt, "r"});
+	graph.add_export(gamma->output(1), {st, "s"});
+
+	graph.normalize();
+	graph.prune();
+//	jive::view(graph.root(), stdout);
+
+	/* the unary and binary nodes are hoisted, along with a copy of the constant */
+	assert(graph.root()->nnodes() == 4);
+	assert(gamma->subregion(0)->nnodes() == 1);
+	assert(gamma->subregion(1)->nnodes() == 2);
+}
+
 static int
 test_main(void)
 {
@@ -157,6 +257,8 @@ test_main(void)
 	test_predicate_reduction();
 	test_invariant_reduction();
 	test_control_constant_reduction();
+	test_fusion();
+	test_hoisting();
 
 	return 0;
 }
@@ -11,6 +11,7 @@
 #include <stdio.h>
 
 #include <jive/rvsdg.h>
+#include <jive/rvsdg/equivalence.h>
 #include <jive/rvsdg/structural-node.h>
 #include <jive/view.h>
 
@@ -116,6 +117,49 @@ test_prune_replace(void)
 
 JIVE_UNIT_TEST_REGISTER("rvsdg/test-prune-replace", test_prune_replace)
 
+static int
+test_prune_dead_chain(void)
+{
+	using namespace jive;
+
+	test::valuetype type;
+
+	jive::graph graph;
+	auto n1 = test::simple_node_create(graph.root(), {}, {}, {type});
+	auto n2 = test::simple_node_create(graph.root(), {type}, {n1->output(0)}, {type});
+	auto n3 = test::simple_node_create(graph.root(), {type, type},
+		{n1->output(0), n2->output(0)}, {type});
+	auto n4 = test::simple_node_create(graph.root(), {type, type},
+		{n2->output(0), n3->output(0)}, {type});
+	auto n5 = test::simple_node_create(graph.root(), {type}, {n1->output(0)}, {type});
+
+	graph.add_export(n5->output(0), {type, "n5"});
+
+	std::vector<jive::node*> destroyed;
+	auto callback = on_node_destroy.connect([&](jive::node * node) {
+		/* destruction is announced while the graph is still intact */
+		assert(region_contains_node(graph.root(), node));
+		for (size_t n = 0; n < node->ninputs(); n++)
+			assert(node->input(n)->origin()->node());
+		destroyed.push_back(node);
+	});
+
+	graph.prune();
+
+	assert(destroyed.size() == 3);
+	assert(destroyed[0] == n4 && destroyed[1] == n3 && destroyed[2] == n2);
+
+	assert(graph.root()->nnodes() == 2);
+	assert(region_contains_node(graph.root(), n1));
+	assert(region_contains_node(graph.root(), n5));
+	assert(n1->output(0)->nusers() == 1);
+	assert(graph.root()->bottom_nodes.first() == nullptr);
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("rvsdg/test-prune-dead-chain", test_prune_dead_chain)
+
 static int
 test_graph(void)
 {
@@ -137,3 +181,39 @@ test_graph(void)
 }
 
 JIVE_UNIT_TEST_REGISTER("rvsdg/test-graph", test_graph)
+
+static int
+test_graph_copy(void)
+{
+	using namespace jive;
+
+	test::valuetype type;
+
+	jive::graph graph;
+	auto x = graph.add_import({type, "x"});
+
+	auto n1 = test::simple_node_create(graph.root(), {type}, {x}, {type});
+	auto n2 = test::simple_node_create(graph.root(), {type}, {n1->output(0)}, {type});
+	auto n3 = test::simple_node_create(graph.root(), {type, type}, {x, n2->output(0)}, {type});
+
+	auto s = test::structural_node_create(graph.root(), 1);
+	auto i = s->add_input(type, n3->output(0));
+	auto a = s->subregion(0)->add_argument(i, type);
+	auto n4 = test::simple_node_create(s->subregion(0), {type}, {a}, {type});
+	auto o = s->add_output(type);
+	s->subregion(0)->add_result(n4->output(0), o, type);
+
+	graph.add_export(o, {type, "y"});
+	graph.add_export(n1->output(0), {type, "z"});
+
+	auto copy = graph.copy();
+	jive::view(copy->root(), stdout);
+
+	assert(copy->root()->nnodes() == graph.root()->nnodes());
+	assert(jive::nnodes(copy->root()) == jive::nnodes(graph.root()));
+	assert(jive_graphs_equivalent(&graph, copy.get()));
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("rvsdg/test-graph-copy", test_graph_copy)
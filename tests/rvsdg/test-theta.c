@@ -4,14 +4,15 @@
  */
 
 #include "test-registry.h"
+#include "testnodes.h"
 #include "testtypes.h"
 
 #include <jive/rvsdg/graph.h>
 #include <jive/rvsdg/theta.h>
 #include <jive/view.h>
 
-static int
-test_main()
+static void
+test_create()
 {
 	using namespace jive;
 
@@ -45,6 +46,134 @@ test_main()
 	assert((*theta->begin())->result() == theta->subregion()->result(1));
 
 	assert(dynamic_cast<const jive::theta_node*>(theta2));
+}
+
+static void
+test_predicate_reduction()
+{
+	using namespace jive;
+
+	jive::graph graph;
+	theta_op::normal_form(&graph)->set_predicate_reduction(true);
+
+	test::valuetype t;
+
+	auto x = graph.add_import({t, "x"});
+	auto y = graph.add_import({t, "y"});
+
+	auto theta = theta_node::create(graph.root());
+	auto lv1 = theta->add_loopvar(x);
+	auto lv2 = theta->add_loopvar(y);
+
+	auto sum = test::binary_op::create(t, t, lv1->argument(), lv2->argument())->output(0);
+	lv1->result()->divert_to(sum);
+
+	auto ex1 = graph.add_export(lv1, {lv1->type(), "x"});
+	auto ex2 = graph.add_export(lv2, {lv2->type(), "y"});
+
+	graph.normalize();
+	graph.prune();
+//	jive::view(graph.root(), stdout);
+
+	/* the predicate is false, the body is executed exactly once */
+	auto node = ex1->origin()->node();
+	assert(dynamic_cast<const test::binary_op*>(&node->operation()));
+	assert(node->input(0)->origin() == x && node->input(1)->origin() == y);
+	assert(ex2->origin() == y);
+	assert(graph.root()->nnodes() == 1);
+}
+
+static void
+test_invariant_reduction()
+{
+	using namespace jive;
+
+	jive::graph graph;
+	theta_op::normal_form(&graph)->set_invariant_reduction(true);
+
+	test::valuetype t;
+
+	auto c = graph.add_import({ctl2, "c"});
+	auto x = graph.add_import({t, "x"});
+	auto y = graph.add_import({t, "y"});
+
+	auto theta = theta_node::create(graph.root());
+	auto lvc = theta->add_loopvar(c);
+	auto lvx = theta->add_loopvar(x);
+	auto lvy = theta->add_loopvar(y);
+	theta->set_predicate(lvc->argument());
+
+	auto sum = test::binary_op::create(t, t, lvx->argument(), lvy->argument())->output(0);
+	lvx->result()->divert_to(sum);
+
+	auto ex1 = graph.add_export(lvx, {lvx->type(), "x"});
+	auto ex2 = graph.add_export(lvy, {lvy->type(), "y"});
+
+	graph.normalize();
+//	jive::view(graph.root(), stdout);
+
+	assert(ex1->origin() == lvx);
+	assert(ex2->origin() == y);
+	assert(theta->nloopvars() == 3);
+}
+
+static void
+test_dead_loopvar_reduction()
+{
+	using namespace jive;
+
+	jive::graph graph;
+	theta_op::normal_form(&graph)->set_dead_loopvar_reduction(true);
+
+	test::valuetype t;
+
+	auto c = graph.add_import({ctl2, "c"});
+	auto x = graph.add_import({t, "x"});
+	auto y = graph.add_import({t, "y"});
+	auto z = graph.add_import({t, "z"});
+
+	auto theta = theta_node::create(graph.root());
+	auto lvc = theta->add_loopvar(c);
+	auto lvx = theta->add_loopvar(x);
+	auto lvy = theta->add_loopvar(y);
+	auto lvz = theta->add_loopvar(z);
+	theta->set_predicate(lvc->argument());
+
+	/* y is only updated from itself, x depends on z */
+	auto y1 = test::binary_op::create(t, t, lvy->argument(), lvy->argument())->output(0);
+	lvy->result()->divert_to(y1);
+	auto x1 = test::binary_op::create(t, t, lvx->argument(), lvz->argument())->output(0);
+	lvx->result()->divert_to(x1);
+
+	auto ex = graph.add_export(lvx, {lvx->type(), "x"});
+
+	graph.normalize();
+//	jive::view(graph.root(), stdout);
+
+	/* y is dead, z is used by x although its output is unused */
+	assert(theta->nloopvars() == 3);
+	assert(theta->subregion()->narguments() == 3);
+	assert(theta->subregion()->nresults() == 4);
+	assert(theta->subregion()->nnodes() == 1);
+	assert(ex->origin() == theta->output(1));
+	assert(theta->input(2)->origin() == z);
+	assert(theta->output(2)->result()->origin() == theta->output(2)->argument());
+
+	/* x and z become dead once the output of x loses its last user */
+	ex->divert_to(x);
+	graph.normalize();
+
+	assert(theta->nloopvars() == 1);
+	assert(theta->subregion()->nnodes() == 0);
+}
+
+static int
+test_main()
+{
+	test_create();
+	test_predicate_reduction();
+	test_invariant_reduction();
+	test_dead_loopvar_reduction();
 
 	return 0;
 }
@@ -300,7 +300,7 @@ public:
 		jive::region * region,
 		jive::output * origin,
 		const jive::resource_class * in_class,
-		const jive::resource_class * out_class) override
+		const jive::resource_class * out_class) const override
 	{
 		auto in_relaxed = jive::relax(in_class);
 		auto out_relaxed = jive::relax(out_class);
@@ -313,13 +313,13 @@ public:
 
 		if (in_relaxed == CLS(gpr)) {
 			auto node = create_instruction(region, &jive::testarch::instr_spill_gpr::instance(),
-				{origin}, {}, {out_class->type()});
+				{origin}, {}, {out_class});
 			return jive::xfer_description(node->input(0), node, node->output(0));
 		}
 
 		if (out_relaxed == CLS(gpr)) {
 			auto node = create_instruction(region, &jive::testarch::instr_restore_gpr::instance(),
-				{origin}, {in_class->type()}, {});
+				{origin}, {in_class}, {});
 			return jive::xfer_description(node->input(0), node, node->output(0));
 		}
 
@@ -334,6 +334,12 @@ public:
 	}
 };
 
+const jive::instructionset *
+jive_testarch_instructionset_get()
+{
+	return testarch_isa::get();
+}
+
 /* subroutine support */
 
 namespace {
@@ -83,6 +83,9 @@ DECLARE_TESTARCH_INSTRUCTION(ret);
 
 }}
 
+const jive::instructionset *
+jive_testarch_instructionset_get();
+
 jive_subroutine
 jive_testarch_subroutine_begin(jive::graph * graph,
 	size_t nparameters, const jive_argument_type parameter_types[],
@@ -11,10 +11,14 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <jive/evaluator/eval.h>
+#include <jive/evaluator/literal.h>
 #include <jive/rvsdg.h>
 #include <jive/rvsdg/control.h>
+#include <jive/rvsdg/theta.h>
 #include <jive/types/bitstring.h>
 #include <jive/types/bitstring/constant.h>
+#include <jive/types/bitstring/known-bits.h>
 #include <jive/types/bitstring/value-representation.h>
 #include <jive/types/function.h>
 #include <jive/view.h>
@@ -1217,6 +1221,114 @@ static int types_bitstring_test_slice_concat(void)
 
 JIVE_UNIT_TEST_REGISTER("types/bitstring/test-slice-concat", types_bitstring_test_slice_concat)
 
+static int types_bitstring_test_known_bits(void)
+{
+	using namespace jive;
+
+	jive::graph graph;
+
+	auto x = graph.add_import({bittype(8), "x"});
+	auto y = graph.add_import({bittype(8), "y"});
+
+	auto mask = create_bitconstant(graph.root(), "11110000");
+	auto a = bitand_op::create(8, x, mask);
+	auto s = bitshl_op::create(8, a, create_bitconstant(graph.root(), 8, 2));
+	auto c = jive_bitconcat({jive_bitslice(y, 0, 4), create_bitconstant(graph.root(), "0000")});
+	auto d = bitudiv_op::create(8, c, mask);
+	auto e = bitult_op::create(8, c, create_bitconstant(graph.root(), 8, 16));
+
+	known_bits bits(&graph);
+	assert(bits.value(a) == std::string("DDDD0000"));
+	assert(bits.value(s) == std::string("00DDDD00"));
+	assert(bits.value(c) == std::string("DDDD0000"));
+	assert(bits.value(d) == std::string("DDDDDDDD"));
+	assert(bits.value(e) == std::string("1"));
+
+	/* values are recomputed when operands change */
+	a->node()->input(1)->divert_to(create_bitconstant(graph.root(), "11000000"));
+	assert(bits.value(s) == std::string("00DD0000"));
+
+	/* arguments of loop variables are known until the variables become variant */
+	auto theta = theta_node::create(graph.root());
+	theta->set_predicate(theta->add_loopvar(graph.add_import({ctl2, "p"}))->argument());
+	auto o = bitor_op::create(8, y, create_bitconstant(graph.root(), "00001111"));
+	auto lv = theta->add_loopvar(o);
+	auto b = bitand_op::create(8, lv->argument(),
+		create_bitconstant(theta->subregion(), "11111100"));
+	assert(bits.value(b) == std::string("DDDD1100"));
+
+	lv->result()->divert_to(bitadd_op::create(8, lv->argument(),
+		create_bitconstant(theta->subregion(), 8, 1)));
+	assert(bits.value(lv->argument()) == std::string("DDDDDDDD"));
+	assert(bits.value(b) == std::string("DDDDDD00"));
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("types/bitstring/test-known-bits", types_bitstring_test_known_bits)
+
+static int types_bitstring_test_simplification(void)
+{
+	using namespace jive;
+
+	jive::graph graph;
+
+	auto x = graph.add_import({bittype(32), "x"});
+	auto zero = create_bitconstant(graph.root(), 32, 0);
+	auto one = create_bitconstant(graph.root(), 32, 1);
+	auto ones = create_bitconstant(graph.root(), 32, -1);
+
+	auto nf = bitbinary_op::normal_form(&graph);
+	nf->set_algebraic(true);
+	nf->set_strength_reduction(true);
+
+	assert_constant(bitxor_op::create(32, x, x), 32, std::string(32, '0').c_str());
+	assert_constant(bitsub_op::create(32, x, x), 32, std::string(32, '0').c_str());
+	assert(bitand_op::create(32, zero, x) == zero);
+	assert(bitor_op::create(32, x, ones) == ones);
+	assert(bitadd_op::create(32, x, zero) == x);
+	assert(bitmul_op::create(32, one, x) == x);
+	assert(bitand_op::create(32, x, x) == x);
+
+	auto mul = bitmul_op::create(32, x, create_bitconstant(graph.root(), 32, 8));
+	assert(mul->node()->operation() == bitshl_op(32));
+	assert(mul->node()->input(1)->origin()->node()->operation() == int_constant_op(32, 3));
+
+	auto div = bitudiv_op::create(32, x, create_bitconstant(graph.root(), 32, 16));
+	assert(div->node()->operation() == bitshr_op(32));
+	assert(div->node()->input(1)->origin()->node()->operation() == int_constant_op(32, 4));
+
+	auto mod = bitumod_op::create(32, x, create_bitconstant(graph.root(), 32, 16));
+	assert(mod->node()->operation() == bitand_op(32));
+	assert(mod->node()->input(1)->origin()->node()->operation() == int_constant_op(32, 15));
+
+	/* division by other constants uses a multiplication with a magic number */
+	lambda_builder lb;
+	auto arguments = lb.begin_lambda(graph.root(), {{&bit32}, {&bit32, &bit32}});
+	auto q = bitudiv_op::create(32, arguments[0], create_bitconstant(lb.subregion(), 32, 7));
+	auto r = bitumod_op::create(32, arguments[0], create_bitconstant(lb.subregion(), 32, 10));
+	auto f = lb.end_lambda({q, r})->output(0);
+	graph.add_export(f, {f->type(), "f"});
+
+	assert(!is<bitudiv_op>(q->node()) && !is<bitumod_op>(r->node()));
+	for (uint64_t value : {0u, 1u, 6u, 7u, 99u, 123456789u, 0x80000000u, 0xffffffffu}) {
+		eval::bitliteral arg(bitvalue_repr(32, value));
+		auto result = eval::eval(&graph, "f", {&arg})->copy();
+		auto fctlit = dynamic_cast<const eval::fctliteral*>(result.get());
+		assert(dynamic_cast<const eval::bitliteral*>(&fctlit->result(0))->value_repr() == value / 7);
+		assert(dynamic_cast<const eval::bitliteral*>(&fctlit->result(1))->value_repr() == value % 10);
+	}
+
+	/* strength reduction can be disabled */
+	nf->set_strength_reduction(false);
+	div = bitudiv_op::create(32, x, create_bitconstant(graph.root(), 32, 16));
+	assert(is<bitudiv_op>(div->node()));
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("types/bitstring/test-simplification", types_bitstring_test_simplification)
+
 static const char * bs[] = {
 	"00000000",
 	"11111111",
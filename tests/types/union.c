@@ -13,6 +13,8 @@
 #include <jive/arch/load.h>
 #include <jive/rvsdg.h>
 #include <jive/types/bitstring.h>
+#include <jive/types/declarations.h>
+#include <jive/types/record.h>
 #include <jive/types/union.h>
 #include <jive/view.h>
 
@@ -84,3 +86,46 @@ static int test_unnunify(void)
 }
 
 JIVE_UNIT_TEST_REGISTER("types/union/test-unnunify", test_unnunify)
+
+static int
+test_unndeclaration()
+{
+	using namespace jive;
+
+	jive::graph graph;
+
+	/* identical declarations are shared within a graph */
+	auto dcl1 = unndeclaration::create(&graph, {&bit8, &bit16});
+	auto dcl2 = unndeclaration::create(&graph, {&bit8, &bit16});
+	auto dcl3 = unndeclaration::create(&graph, {&bit16, &bit8});
+	assert(dcl1 == dcl2);
+	assert(dcl1 != dcl3);
+	assert(jive::unntype(dcl1) == jive::unntype(dcl2));
+
+	/* nested declarations are compared through their shared inner declarations */
+	jive::unntype inner1(dcl1), inner3(dcl3);
+	auto dcl4 = unndeclaration::create(&graph, {&inner1, &bit32});
+	auto dcl5 = unndeclaration::create(&graph, {&inner1, &bit32});
+	auto dcl6 = unndeclaration::create(&graph, {&inner3, &bit32});
+	assert(dcl4 == dcl5);
+	assert(dcl4 != dcl6);
+
+	/* empty declarations can be extended and are never shared */
+	auto edcl1 = unndeclaration::create(&graph);
+	auto edcl2 = unndeclaration::create(&graph);
+	assert(edcl1 != edcl2);
+
+	auto rcd1 = rcddeclaration::create(&graph, {&bit8, &bit16});
+	auto rcd2 = rcddeclaration::create(&graph, {&bit8, &bit16});
+	assert(rcd1 == rcd2);
+	assert(graph.declarations().nunndeclarations() == 6);
+	assert(graph.declarations().nrcddeclarations() == 1);
+
+	/* declarations of different graphs are independent */
+	jive::graph graph2;
+	assert(unndeclaration::create(&graph2, {&bit8, &bit16}) != dcl1);
+
+	return 0;
+}
+
+JIVE_UNIT_TEST_REGISTER("types/union/test-unndeclaration", test_unndeclaration)